@@ -0,0 +1,150 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_DIRECT_H
+#define ICE_DIRECT_H
+
+#include <Ice/InstanceF.h>
+#include <Ice/ProxyF.h>
+#include <Ice/Object.h>
+#include <Ice/Current.h>
+#include <Ice/StreamHelpers.h>
+
+namespace IceInternal
+{
+
+//
+// Direct is used by the generated code of operations with the
+// cpp:collocated-direct metadata to call a collocated servant
+// without marshaling the parameters. It looks up the servant of
+// the proxy target if the invocation is eligible for a direct call,
+// otherwise servant() returns null and the generated code falls back
+// to the regular invocation path.
+//
+class ICE_API Direct : private IceUtil::noncopyable
+{
+public:
+
+#ifdef ICE_CPP11_MAPPING
+    Direct(::Ice::ObjectPrx*, const std::string&, ::Ice::OperationMode, const ::Ice::Context&);
+#else
+    Direct(::IceProxy::Ice::Object*, const std::string&, ::Ice::OperationMode, const ::Ice::Context&);
+#endif
+    ~Direct();
+
+    template<typename T> T* servant() const
+    {
+        return dynamic_cast<T*>(_servant.get());
+    }
+
+    const ::Ice::Current& current() const
+    {
+        return _current;
+    }
+
+    //
+    // Throws MemoryLimitException if the given lower bound of the size
+    // of the in parameters exceeds the adapter MessageSizeMax limit.
+    //
+    void checkMessageSize(size_t) const;
+
+    //
+    // Must be called from a catch block, rethrows the current
+    // exception as it would be raised by a regular collocated
+    // invocation.
+    //
+    void handleException() const;
+
+private:
+
+    void warning(const std::string&) const;
+
+    InstancePtr _instance;
+    ::Ice::Current _current;
+    ::Ice::ObjectPtr _servant;
+    bool _dispatchCount;
+};
+
+//
+// Lower bound of the marshaled size of an in parameter of a direct
+// call, it's used to check the MessageSizeMax limit without
+// marshaling the parameters. Strings are sized from their length,
+// sequences and dictionaries from their elements and other types
+// from their minimum wire size.
+//
+template<typename T, ::Ice::StreamHelperCategory = ::Ice::StreamableTraits<T>::helper>
+struct DirectSizeHelper
+{
+    static size_t size(const T&)
+    {
+        return static_cast<size_t>(::Ice::StreamableTraits<T>::minWireSize);
+    }
+};
+
+template<typename T> inline size_t
+directSize(const T& v)
+{
+    return DirectSizeHelper<T>::size(v);
+}
+
+inline size_t
+directSizeOfSize(size_t sz)
+{
+    return sz < 255 ? 1 : 5;
+}
+
+template<>
+struct DirectSizeHelper< ::std::string, ::Ice::StreamHelperCategoryBuiltin>
+{
+    static size_t size(const ::std::string& v)
+    {
+        return directSizeOfSize(v.size()) + v.size();
+    }
+};
+
+template<>
+struct DirectSizeHelper< ::std::wstring, ::Ice::StreamHelperCategoryBuiltin>
+{
+    static size_t size(const ::std::wstring& v)
+    {
+        return directSizeOfSize(v.size()) + v.size();
+    }
+};
+
+template<typename T>
+struct DirectSizeHelper<T, ::Ice::StreamHelperCategorySequence>
+{
+    static size_t size(const T& v)
+    {
+        typedef typename T::value_type E;
+        size_t sz = directSizeOfSize(v.size());
+        if(::Ice::StreamableTraits<E>::fixedLength)
+        {
+            return sz + v.size() * static_cast<size_t>(::Ice::StreamableTraits<E>::minWireSize);
+        }
+        for(typename T::const_iterator p = v.begin(); p != v.end(); ++p)
+        {
+            sz += directSize<E>(*p);
+        }
+        return sz;
+    }
+};
+
+template<typename T>
+struct DirectSizeHelper<T, ::Ice::StreamHelperCategoryDictionary>
+{
+    static size_t size(const T& v)
+    {
+        size_t sz = directSizeOfSize(v.size());
+        for(typename T::const_iterator p = v.begin(); p != v.end(); ++p)
+        {
+            sz += directSize<typename T::key_type>(p->first) + directSize<typename T::mapped_type>(p->second);
+        }
+        return sz;
+    }
+};
+
+}
+
+#endif
@@ -60,6 +60,28 @@ protected:
 namespace IceInternal
 {
 
+//
+// The minimal perfect hash table of the operation names of a Slice
+// interface, generated by slice2cpp. The names are sorted, an
+// operation name is hashed to its bucket, and the displacement of the
+// bucket gives the slot holding the index of the name.
+//
+struct OperationTable
+{
+    const std::string* names;
+    int size;
+    unsigned int seed;
+    const int* displacements;
+    int buckets;
+    const int* slots;
+};
+
+//
+// Returns the index of the operation in the sorted names of the
+// table, or -1 if the operation is not in the table.
+//
+ICE_API int findOperation(const OperationTable&, const std::string&);
+
 class ICE_API IncomingBase : private IceUtil::noncopyable
 {
 public:
@@ -10,6 +10,9 @@
 #include <Ice/Initialize.h>
 
 #include <Ice/Metrics.h>
+#include <Ice/MetricsFunctional.h>
+#include <Ice/UniquePtr.h>
+#include <IceUtil/Atomic.h>
 
 #ifdef _MSC_VER
 #  define ICE_CPP11_COMPILER_REGEXP
@@ -27,6 +30,7 @@
 #endif
 
 #include <list>
+#include <deque>
 
 namespace IceMX
 {
@@ -41,6 +45,42 @@ template<typename T> class MetricsHelperT;
 namespace IceInternal
 {
 
+//
+// A latency histogram with HDR-style buckets: values are counted in
+// buckets with a width proportional to the value, each power of two
+// range is split in 16 buckets. Values are recorded without locking.
+//
+class ICE_API LatencyHistogram : private IceUtil::noncopyable
+{
+public:
+
+    LatencyHistogram();
+
+    void record(Ice::Long);
+    IceMX::Histogram getHistogram() const;
+
+private:
+
+    enum
+    {
+        SubBucketBits = 4,
+        SubBucketCount = 1 << SubBucketBits,
+        MaxBits = 40, // Values larger than 2^40us (~12 days) are counted in the last bucket.
+        BucketCount = (MaxBits - SubBucketBits + 1) * SubBucketCount
+    };
+
+    IceUtilInternal::Atomic _counts[BucketCount];
+};
+
+//
+// Metrics entries are updated through per-thread shards to avoid
+// contention on the metrics map mutex, the shards are merged when
+// the metrics are retrieved. Shards are assigned to threads in a
+// round-robin fashion.
+//
+enum { MetricsShardCount = 8 };
+ICE_API int getMetricsShard();
+
 class ICE_API MetricsMapI;
 ICE_DEFINE_PTR(MetricsMapIPtr, MetricsMapI);
 
@@ -78,9 +118,24 @@ public:
     private:
 
         bool match(const std::string&);
+        bool matchRegExp(const std::string&);
 
         const std::string _attribute;
 
+        //
+        // Cache of the match results, attribute values are often the
+        // same for many observers (connection, proxy, operation, etc).
+        // The cache is sharded like the metrics entries to avoid
+        // contention, each shard evicts its oldest results when full.
+        //
+        enum { CacheShardSize = 128 };
+        struct CacheShard : public IceUtil::Mutex
+        {
+            std::map<std::string, bool> results;
+            std::deque<std::map<std::string, bool>::iterator> order;
+        };
+        CacheShard _cache[MetricsShardCount];
+
 #ifdef __MINGW32__
     //
     // No regexp support with MinGW, when MinGW C++11 mode is not experimental
@@ -121,6 +176,7 @@ protected:
     const int _retain;
     const std::vector<RegExpPtr> _accept;
     const std::vector<RegExpPtr> _reject;
+    const bool _histogram;
 };
 
 class ICE_API MetricsMapFactory
@@ -170,6 +226,10 @@ public:
         EntryT(MetricsMapTPtr map, const TPtr& object, const typename std::list<EntryTPtr>::iterator& p) :
             _map(map), _object(object), _detachedPos(p)
         {
+            if(_map->_histogram)
+            {
+                _histogram.reset(new LatencyHistogram());
+            }
         }
 
         ~EntryT()
@@ -221,6 +281,11 @@ public:
         void
         detach(Ice::Long lifetime)
         {
+            if(_histogram)
+            {
+                _histogram->record(lifetime); // Doesn't require the map mutex.
+            }
+
             IceUtil::Mutex::Lock sync(*_map);
             _object->totalLifetime += lifetime;
             if(--_object->current == 0)
@@ -240,6 +305,28 @@ public:
             func(_object);
         }
 
+        //
+        // Additive updates are applied to the calling thread shard
+        // and don't require the map mutex.
+        //
+        template<class M, typename Y, typename V> void
+        execute(IceMX::ApplyOnMember<M, Y, IceMX::Add<V> > func)
+        {
+            executeOnShard(func);
+        }
+
+        template<class M, typename Y> void
+        execute(IceMX::ApplyOnMember<M, Y, IceMX::Increment<Y> > func)
+        {
+            executeOnShard(func);
+        }
+
+        template<class M, typename Y> void
+        execute(IceMX::ApplyOnMember<M, Y, IceMX::Decrement<Y> > func)
+        {
+            executeOnShard(func);
+        }
+
         MetricsMapT*
         getMap()
         {
@@ -248,6 +335,108 @@ public:
 
     private:
 
+        class ShardMerger
+        {
+        public:
+
+            ShardMerger(const void* k) : key(k)
+            {
+            }
+
+            virtual ~ShardMerger()
+            {
+            }
+
+            virtual void merge(T&, T&) = 0;
+
+            const void* const key;
+        };
+
+        template<class M, typename Y> class MemberShardMerger : public ShardMerger
+        {
+        public:
+
+            MemberShardMerger(Y M::*m) : ShardMerger(type()), member(m)
+            {
+            }
+
+            static const void*
+            type()
+            {
+                static const char t = 0;
+                return &t;
+            }
+
+            virtual void
+            merge(T& from, T& to)
+            {
+                to.*member += from.*member;
+                from.*member = Y();
+            }
+
+            Y M::* const member;
+        };
+
+        struct Shard : public IceUtil::Mutex
+        {
+            ~Shard()
+            {
+                for(typename std::vector<ShardMerger*>::const_iterator p = mergers.begin(); p != mergers.end(); ++p)
+                {
+                    delete *p;
+                }
+            }
+
+            TPtr object;
+            std::vector<ShardMerger*> mergers;
+        };
+
+        template<class M, typename Y, typename F> void
+        executeOnShard(IceMX::ApplyOnMember<M, Y, F>& func)
+        {
+            Shard& shard = _shards[getMetricsShard()];
+            IceUtil::Mutex::Lock sync(shard);
+            if(!shard.object)
+            {
+                shard.object = ICE_MAKE_SHARED(T);
+            }
+
+            //
+            // Register the member with the shard the first time it's
+            // updated, the registered members are merged with the
+            // entry metrics object by merge().
+            //
+            typename std::vector<ShardMerger*>::const_iterator p;
+            for(p = shard.mergers.begin(); p != shard.mergers.end(); ++p)
+            {
+                if((*p)->key == MemberShardMerger<M, Y>::type() &&
+                   static_cast<MemberShardMerger<M, Y>*>(*p)->member == func.member)
+                {
+                    break;
+                }
+            }
+            if(p == shard.mergers.end())
+            {
+                shard.mergers.push_back(new MemberShardMerger<M, Y>(func.member));
+            }
+            func(shard.object);
+        }
+
+        void
+        merge()
+        {
+            // This is called with the map mutex locked.
+            for(int i = 0; i < MetricsShardCount; ++i)
+            {
+                IceUtil::Mutex::Lock sync(_shards[i]);
+                for(typename std::vector<ShardMerger*>::const_iterator p = _shards[i].mergers.begin();
+                    p != _shards[i].mergers.end(); ++p)
+                {
+                    (*p)->merge(*_shards[i].object.get(), *_object.get());
+                }
+            }
+        }
+
         IceMX::MetricsFailures
         getFailures() const
         {
@@ -258,14 +447,19 @@ public:
         }
 
         IceMX::MetricsPtr
-        clone() const
+        clone()
         {
+            merge();
             TPtr metrics = ICE_DYNAMIC_CAST(T, _object->ice_clone());
             for(typename std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> >::const_iterator p =
                     _subMaps.begin(); p != _subMaps.end(); ++p)
             {
                 metrics.get()->*p->second.second = p->second.first->getMetrics();
             }
+            if(_histogram)
+            {
+                metrics->lifetimeHistogram = _histogram->getHistogram();
+            }
             return metrics;
         }
 
@@ -289,6 +483,8 @@ public:
         IceMX::StringIntDict _failures;
         std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> > _subMaps;
         typename std::list<EntryTPtr>::iterator _detachedPos;
+        IceInternal::UniquePtr<LatencyHistogram> _histogram;
+        Shard _shards[MetricsShardCount];
     };
 
     MetricsMapT(const std::string& mapPrefix,
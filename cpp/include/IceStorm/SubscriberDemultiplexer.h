@@ -0,0 +1,49 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICESTORM_SUBSCRIBER_DEMULTIPLEXER_H
+#define ICESTORM_SUBSCRIBER_DEMULTIPLEXER_H
+
+#include <IceStorm/IceStorm.h>
+#include <Ice/ObjectAdapterF.h>
+
+namespace IceStorm
+{
+
+/**
+ * A demultiplexer that delivers the events it receives to the
+ * subscribers hosted by an object adapter. Add the demultiplexer to
+ * the object adapter of the subscribers and set the demultiplexer
+ * QoS of each subscriber to the stringified demultiplexer proxy.
+ *
+ * To receive the events of a topic from a UDP multicast group, add the
+ * demultiplexer with the identity of the topic to an object adapter
+ * listening on the multicast endpoint and set the multicast QoS of each
+ * subscriber of the topic to this endpoint.
+ * \headerfile IceStorm/IceStorm.h
+ */
+class ICESTORM_API SubscriberDemultiplexer : public Demultiplexer
+{
+public:
+
+    /**
+     * Constructs a demultiplexer for the given object adapter.
+     * @param adapter The object adapter of the subscribers.
+     */
+    SubscriberDemultiplexer(const Ice::ObjectAdapterPtr& adapter);
+
+#ifdef ICE_CPP11_MAPPING
+    virtual void deliver(Ice::IdentitySeq, DemultiplexedEventSeq, const Ice::Current&) override;
+#else
+    virtual void deliver(const Ice::IdentitySeq&, const DemultiplexedEventSeq&, const Ice::Current&);
+#endif
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+};
+
+}
+
+#endif
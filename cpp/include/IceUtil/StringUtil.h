@@ -92,6 +92,33 @@ ICE_API bool isDigit(char);
 //
 ICE_API std::string removeWhitespace(const std::string&);
 
+//
+// Hash functions of the operation tables generated by slice2cpp. The
+// generated tables depend on these functions, they must not change.
+//
+inline unsigned int
+operationHash(const std::string& s, unsigned int seed)
+{
+    unsigned int h = 2166136261U ^ seed;
+    for(std::string::const_iterator p = s.begin(); p != s.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+    }
+    return h;
+}
+
+inline unsigned int
+operationHashMix(unsigned int h, unsigned int displacement)
+{
+    h ^= displacement * 0x9e3779b9U;
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
 }
 
 #endif
@@ -9,10 +9,19 @@
 #include <IceUtil/Thread.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Time.h>
+#include <IceUtil/Atomic.h>
 
 #include <set>
 #include <map>
 
+namespace IceUtilInternal
+{
+
+class TimingWheel;
+struct TimingWheelEntry;
+
+}
+
 namespace IceUtil
 {
 
@@ -30,9 +39,26 @@ class ICE_API TimerTask
 {
 public:
 
+    TimerTask();
+    TimerTask(const TimerTask&);
     virtual ~TimerTask();
 
+    TimerTask& operator=(const TimerTask&);
+
     virtual void runTimerTask() = 0;
+
+private:
+
+    friend class IceUtilInternal::TimingWheel;
+
+    //
+    // The timing wheel entries of the task, one for each timing wheel
+    // timer the task is scheduled with. The list is protected by the
+    // _timingWheelLock spin lock, it's only locked while an entry is
+    // added, found or removed.
+    //
+    IceUtilInternal::TimingWheelEntry* _timingWheelEntries;
+    IceUtilInternal::Atomic _timingWheelLock;
 };
 ICE_DEFINE_PTR(TimerTaskPtr, TimerTask);
 
@@ -55,6 +81,23 @@ public:
     //
     Timer(int priority);
 
+    //
+    // Construct a timer using a hierarchical timing wheel with the given
+    // resolution and starts its execution thread. Scheduling and canceling
+    // a task are constant time operations, tasks run at the end of the
+    // resolution interval in which they expire and tasks expiring in the
+    // same interval run in scheduling order.
+    //
+    Timer(const IceUtil::Time&);
+
+    //
+    // Construct a timer using a hierarchical timing wheel with the given
+    // resolution and starts its execution thread with the priority.
+    //
+    Timer(const IceUtil::Time&, int);
+
+    virtual ~Timer();
+
     //
     // Destroy the timer and detach its execution thread if the calling thread
     // is the timer thread, join the timer execution thread otherwise.
@@ -85,6 +128,9 @@ protected:
     virtual void run();
     virtual void runTimerTask(const TimerTaskPtr&);
 
+    void runWheel();
+    void runTask(const TimerTaskPtr&);
+
     struct Token
     {
         IceUtil::Time scheduledTime;
@@ -114,6 +160,8 @@ protected:
     };
     std::map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare> _tasks;
     IceUtil::Time _wakeUpTime;
+
+    IceUtilInternal::TimingWheel* _wheel; // Set if the timer uses a timing wheel.
 };
 typedef IceUtil::Handle<Timer> TimerPtr;
 
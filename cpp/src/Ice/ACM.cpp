@@ -8,6 +8,8 @@
 #include <Ice/Properties.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Instance.h>
+#include <Ice/TraceLevels.h>
+#include <Ice/InstrumentationI.h>
 
 using namespace std;
 using namespace Ice;
@@ -76,8 +78,32 @@ IceInternal::ACMConfig::ACMConfig(const Ice::PropertiesPtr& p,
     }
 }
 
-IceInternal::FactoryACMMonitor::FactoryACMMonitor(const InstancePtr& instance, const ACMConfig& config) :
-    _instance(instance), _config(config)
+namespace
+{
+
+//
+// Special bucket values for the connections of the FactoryACMMonitor
+// connection map.
+//
+const IceUtil::Int64 Parked = -1; // Not scheduled, waiting for activity.
+const IceUtil::Int64 Monitoring = -2; // Being monitored by the timer thread.
+const IceUtil::Int64 MonitoringUnparked = -3; // Being monitored, activity occurred.
+
+}
+
+IceInternal::FactoryACMMonitor::FactoryACMMonitor(const InstancePtr& instance,
+                                                  const ACMConfig& config,
+                                                  const string& id) :
+    _instance(instance),
+    _config(config),
+    _id(id),
+    //
+    // The bucket period must remain small compared to the heartbeat
+    // interval (timeout / 4) since deadlines are rounded up to the
+    // next bucket.
+    //
+    _period(config.timeout / 8),
+    _scheduled(false)
 {
 }
 
@@ -85,7 +111,7 @@ IceInternal::FactoryACMMonitor::~FactoryACMMonitor()
 {
     assert(!_instance);
     assert(_connections.empty());
-    assert(_changes.empty());
+    assert(_buckets.empty());
     assert(_reapedConnections.empty());
 }
 
@@ -107,20 +133,27 @@ IceInternal::FactoryACMMonitor::destroy()
     }
 
     //
-    // Cancel the scheduled timer task and schedule it again now to clear the
-    // connection set from the timer thread.
+    // Cancel the scheduled timer task, the buckets might still hold entries
+    // for connections which were removed. If there are connections left,
+    // schedule the task again now to clear the connection map from the timer
+    // thread.
     //
-    if(!_connections.empty())
+    if(_scheduled)
     {
         _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
+        _scheduled = false;
+    }
+    _buckets.clear();
+
+    if(!_connections.empty())
+    {
         _instance->timer()->schedule(ICE_SHARED_FROM_THIS, IceUtil::Time());
     }
 
     _instance = 0;
-    _changes.clear();
 
     //
-    // Wait for the connection set to be cleared by the timer thread.
+    // Wait for the connection map to be cleared by the timer thread.
     //
     while(!_connections.empty())
     {
@@ -137,14 +170,18 @@ IceInternal::FactoryACMMonitor::add(const ConnectionIPtr& connection)
     }
 
     Lock sync(*this);
-    if(_connections.empty())
+    map<ConnectionIPtr, IceUtil::Int64>::iterator p = _connections.find(connection);
+    if(p == _connections.end() || p->second == Parked)
     {
-        _connections.insert(connection);
-        _instance->timer()->scheduleRepeated(ICE_SHARED_FROM_THIS, _config.timeout / 2);
+        schedule(connection, IceUtil::Time::now(IceUtil::Time::Monotonic) + _config.timeout / 2);
     }
-    else
+    else if(p->second == Monitoring)
     {
-        _changes.push_back(make_pair(connection, true));
+        //
+        // The connection is being monitored by the timer thread, make
+        // sure it doesn't get parked once monitoring completes.
+        //
+        p->second = MonitoringUnparked;
     }
 }
 
@@ -158,7 +195,12 @@ IceInternal::FactoryACMMonitor::remove(const ConnectionIPtr& connection)
 
     Lock sync(*this);
     assert(_instance);
-    _changes.push_back(make_pair(connection, false));
+
+    //
+    // The connection is lazily removed from its bucket by the timer
+    // thread.
+    //
+    _connections.erase(connection);
 }
 
 void
@@ -212,32 +254,65 @@ IceInternal::FactoryACMMonitor::swapReapedConnections(vector<ConnectionIPtr>& co
 void
 IceInternal::FactoryACMMonitor::runTimerTask()
 {
+    vector<ConnectionIPtr> connections;
+    IceUtil::Time now;
+    InstancePtr instance;
     {
         Lock sync(*this);
         if(!_instance)
         {
             _connections.clear();
+            _buckets.clear();
             notifyAll();
             return;
         }
 
-        for(vector<pair<ConnectionIPtr, bool> >::const_iterator p = _changes.begin(); p != _changes.end(); ++p)
+        //
+        // Collect the connections from the expired buckets. Entries
+        // for connections which were removed or rescheduled since
+        // they were added to the bucket are ignored.
+        //
+        now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        const IceUtil::Int64 current = now.toMicroSeconds() / _period.toMicroSeconds();
+        while(!_buckets.empty() && _buckets.begin()->first <= current)
         {
-            if(p->second)
+            const vector<ConnectionIPtr>& bucket = _buckets.begin()->second;
+            for(vector<ConnectionIPtr>::const_iterator p = bucket.begin(); p != bucket.end(); ++p)
             {
-                _connections.insert(p->first);
+                map<ConnectionIPtr, IceUtil::Int64>::iterator q = _connections.find(*p);
+                if(q != _connections.end() && q->second == _buckets.begin()->first)
+                {
+                    q->second = Monitoring;
+                    connections.push_back(*p);
+                }
             }
-            else
+            _buckets.erase(_buckets.begin());
+        }
+
+        if(connections.empty())
+        {
+            if(_buckets.empty())
             {
-                _connections.erase(p->first);
+                _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
+                _scheduled = false;
             }
+            return;
         }
-        _changes.clear();
+        instance = _instance;
+    }
 
-        if(_connections.empty())
+    //
+    // The sweeps are observed by the metrics of the communicator.
+    //
+    ACMObserverIPtr observer;
+    CommunicatorObserverI* communicatorObserver =
+        dynamic_cast<CommunicatorObserverI*>(instance->initializationData().observer.get());
+    if(communicatorObserver)
+    {
+        observer = communicatorObserver->getACMObserver(_id);
+        if(observer)
         {
-            _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
-            return;
+            observer->attach();
         }
     }
 
@@ -245,12 +320,14 @@ IceInternal::FactoryACMMonitor::runTimerTask()
     // Monitor connections outside the thread synchronization, so
     // that connections can be added or removed during monitoring.
     //
-    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-    for(set<ConnectionIPtr>::const_iterator p = _connections.begin(); p != _connections.end(); ++p)
+    vector<IceUtil::Time> deadlines;
+    deadlines.reserve(connections.size());
+    for(vector<ConnectionIPtr>::const_iterator p = connections.begin(); p != connections.end(); ++p)
     {
+        IceUtil::Time deadline = now + _config.timeout / 2;
         try
         {
-            (*p)->monitor(now, _config);
+            deadline = (*p)->monitor(now, _config, true);
         }
         catch(const exception& ex)
         {
@@ -260,9 +337,97 @@ IceInternal::FactoryACMMonitor::runTimerTask()
         {
             handleException();
         }
+        deadlines.push_back(deadline);
+    }
+
+    size_t parked = 0;
+    size_t connectionCount = 0;
+    size_t bucketCount = 0;
+    {
+        Lock sync(*this);
+        if(!_instance)
+        {
+            if(observer)
+            {
+                observer->detach();
+            }
+            return; // The connections are cleared by the timer task scheduled by destroy().
+        }
+
+        for(size_t i = 0; i < connections.size(); ++i)
+        {
+            map<ConnectionIPtr, IceUtil::Int64>::iterator p = _connections.find(connections[i]);
+            if(p == _connections.end() || p->second >= 0)
+            {
+                continue; // Removed or added again during monitoring.
+            }
+
+            if(deadlines[i] != IceUtil::Time())
+            {
+                schedule(connections[i], deadlines[i]);
+            }
+            else if(p->second == MonitoringUnparked)
+            {
+                schedule(connections[i], now + _config.timeout / 2);
+            }
+            else
+            {
+                p->second = Parked;
+                ++parked;
+            }
+        }
+
+        if(_buckets.empty())
+        {
+            _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
+            _scheduled = false;
+        }
+
+        if(_instance->traceLevels()->acm >= 1)
+        {
+            trace(connections.size(), parked, IceUtil::Time::now(IceUtil::Time::Monotonic) - now);
+        }
+        connectionCount = _connections.size();
+        bucketCount = _buckets.size();
+    }
+
+    if(observer)
+    {
+        observer->swept(static_cast<Int>(connections.size()), static_cast<Int>(parked),
+                        static_cast<Int>(connectionCount), static_cast<Int>(bucketCount));
+        observer->detach();
     }
 }
 
+void
+IceInternal::FactoryACMMonitor::schedule(const ConnectionIPtr& connection, const IceUtil::Time& deadline)
+{
+    //
+    // Round up the deadline to the next bucket, the connection is
+    // never monitored before its deadline.
+    //
+    const IceUtil::Int64 period = _period.toMicroSeconds();
+    const IceUtil::Int64 bucket = (deadline.toMicroSeconds() + period - 1) / period;
+    _connections[connection] = bucket;
+    _buckets[bucket].push_back(connection);
+
+    if(!_scheduled)
+    {
+        _instance->timer()->scheduleRepeated(ICE_SHARED_FROM_THIS, _period);
+        _scheduled = true;
+    }
+}
+
+void
+IceInternal::FactoryACMMonitor::trace(size_t monitored, size_t parked, const IceUtil::Time& duration)
+{
+    Trace out(_instance->initializationData().logger, _instance->traceLevels()->acmCat);
+    out << "monitored " << monitored << " connection(s) in " << duration.toMicroSeconds() << "us";
+    out << "\nnewly parked connections = " << parked;
+    out << "\nmonitored connections = " << _connections.size();
+    out << "\npending buckets = " << _buckets.size();
+}
+
 void
 FactoryACMMonitor::handleException(const exception& ex)
 {
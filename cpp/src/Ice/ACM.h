@@ -14,7 +14,7 @@
 #include <Ice/InstanceF.h>
 #include <Ice/PropertiesF.h>
 #include <Ice/LoggerF.h>
-#include <set>
+#include <map>
 
 namespace IceInternal
 {
@@ -52,7 +52,7 @@ class FactoryACMMonitor : public ACMMonitor, public IceUtil::Monitor<IceUtil::Mu
 {
 public:
 
-    FactoryACMMonitor(const InstancePtr&, const ACMConfig&);
+    FactoryACMMonitor(const InstancePtr&, const ACMConfig&, const std::string&);
     virtual ~FactoryACMMonitor();
 
     virtual void add(const Ice::ConnectionIPtr&);
@@ -75,11 +75,23 @@ private:
 
     virtual void runTimerTask();
 
+    void schedule(const Ice::ConnectionIPtr&, const IceUtil::Time&);
+    void trace(size_t, size_t, const IceUtil::Time&);
+
     InstancePtr _instance;
     const ACMConfig _config;
-
-    std::vector<std::pair<Ice::ConnectionIPtr, bool> > _changes;
-    std::set<Ice::ConnectionIPtr> _connections;
+    const std::string _id; // The id of the monitor sweeps metrics.
+
+    //
+    // Connections are kept in deadline buckets of _period width, the
+    // timer task only monitors the connections from expired buckets.
+    // The _connections map associates each monitored connection with
+    // its bucket or with one of the special values below.
+    //
+    const IceUtil::Time _period;
+    std::map<Ice::ConnectionIPtr, IceUtil::Int64> _connections;
+    std::map<IceUtil::Int64, std::vector<Ice::ConnectionIPtr> > _buckets;
+    bool _scheduled;
     std::vector<Ice::ConnectionIPtr> _reapedConnections;
 };
 
@@ -131,6 +131,15 @@ CollocatedRequestHandler::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAs
 AsyncStatus
 CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int batchRequestNum, bool synchronous)
 {
+    //
+    // Enforce the adapter MessageSizeMax limit as the adapter
+    // connections would when reading the request.
+    //
+    if(outAsync->getOs()->b.size() > _adapter->messageSizeMax())
+    {
+        Ex::throwMemoryLimitException(__FILE__, __LINE__, outAsync->getOs()->b.size(), _adapter->messageSizeMax());
+    }
+
     //
     // Increase the direct count to prevent the thread pool from being destroyed before
     // invokeAll is called. This will also throw if the object adapter has been deactivated.
@@ -8,6 +8,7 @@
 #include <Ice/Instance.h>
 #include <Ice/Proxy.h>
 #include <Ice/ConnectionI.h>
+#include <Ice/ConnectionFactory.h>
 #include <Ice/RouterInfo.h>
 #include <Ice/OutgoingAsync.h>
 #include <Ice/Protocol.h>
@@ -317,7 +318,22 @@ ConnectRequestHandler::flushRequests()
     //
     if(_reference->getCacheConnection() && !exception)
     {
-        _requestHandler = ICE_MAKE_SHARED(ConnectionRequestHandler, _reference, _connection, _compress);
+        //
+        // If connection pooling is enabled, the connection request handler sends each
+        // invocation over the least loaded connection of the pool.
+        //
+        OutgoingConnectionFactoryPtr factory;
+        ConnectionPoolPtr pool;
+        try
+        {
+            factory = _reference->getInstance()->outgoingConnectionFactory();
+            pool = factory->getConnectionPool(_connection);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+        _requestHandler = ICE_MAKE_SHARED(ConnectionRequestHandler, _reference, _connection, _compress,
+                                          pool ? factory : OutgoingConnectionFactoryPtr(), pool);
         for(set<Ice::ObjectPrxPtr>::const_iterator p = _proxies.begin(); p != _proxies.end(); ++p)
         {
             (*p)->_updateRequestHandler(ICE_SHARED_FROM_THIS, _requestHandler);
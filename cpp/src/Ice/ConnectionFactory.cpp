@@ -40,6 +40,7 @@ using namespace Ice::Instrumentation;
 using namespace IceInternal;
 
 IceUtil::Shared* IceInternal::upCast(OutgoingConnectionFactory* p) { return p; }
+IceUtil::Shared* IceInternal::upCast(ConnectionPool* p) { return p; }
 
 #ifndef ICE_CPP11_MAPPING
 IceUtil::Shared* IceInternal::upCast(IncomingConnectionFactory* p) { return p; }
@@ -114,6 +115,53 @@ find(const multimap<K,::IceInternal::Handle<V> >& m,
 }
 #endif
 
+//
+// Returns the active connection with the fewest outstanding requests from the
+// given range of a connection map.
+//
+template<typename Range> ConnectionIPtr
+leastLoaded(const Range& range)
+{
+    ConnectionIPtr connection;
+    int outstanding = 0;
+    for(typename Range::first_type p = range.first; p != range.second; ++p)
+    {
+        int n = p->second->outstandingRequests();
+        if((!connection || n < outstanding) && p->second->isActiveOrHolding())
+        {
+            connection = p->second;
+            outstanding = n;
+        }
+    }
+    return connection;
+}
+
+class PooledConnectionCallback : public OutgoingConnectionFactory::CreateConnectionCallback
+{
+public:
+
+    PooledConnectionCallback(const ConnectionPoolPtr& pool) : _pool(pool)
+    {
+    }
+
+    virtual void
+    setConnection(const Ice::ConnectionIPtr&, bool)
+    {
+        _pool->expanded();
+    }
+
+    virtual void
+    setException(const Ice::LocalException&)
+    {
+        // The connection failure is traced by the factory.
+        _pool->expanded();
+    }
+
+private:
+
+    const ConnectionPoolPtr _pool;
+};
+
 class StartAcceptor : public IceUtil::TimerTask
 #ifdef ICE_CPP11_MAPPING
                     , public std::enable_shared_from_this<StartAcceptor>
@@ -170,6 +218,81 @@ private:
 
 }
 
+IceInternal::ConnectionPool::ConnectionPool(size_t size) :
+    _size(size),
+    _expanding(false)
+{
+}
+
+ConnectionIPtr
+IceInternal::ConnectionPool::get(const ConnectionIPtr& connection, bool& expand)
+{
+    expand = false;
+
+    IceUtil::Mutex::Lock sync(*this);
+    ConnectionIPtr pooled;
+    int outstanding = 0;
+    for(vector<ConnectionIPtr>::const_iterator p = _connections.begin(); p != _connections.end(); ++p)
+    {
+        int n = (*p)->outstandingRequests();
+        if((!pooled || n < outstanding) && (*p)->isActiveOrHoldingSnapshot())
+        {
+            pooled = *p;
+            outstanding = n;
+        }
+    }
+
+    if(!pooled)
+    {
+        return connection; // No active connections, the invocation will fail and be retried.
+    }
+
+    //
+    // A connection is added to the pool only if the least loaded connection is
+    // busy and if no other connection is being added to the pool. The invocation
+    // uses the least loaded connection meanwhile.
+    //
+    if(!_expanding && _connections.size() < _size && outstanding > 0)
+    {
+        _expanding = true;
+        expand = true;
+    }
+    return pooled;
+}
+
+vector<ConnectionIPtr>
+IceInternal::ConnectionPool::connections(const ConnectionIPtr& connection) const
+{
+    IceUtil::Mutex::Lock sync(*this);
+    if(_connections.empty())
+    {
+        return vector<ConnectionIPtr>(1, connection);
+    }
+    return _connections;
+}
+
+void
+IceInternal::ConnectionPool::add(const ConnectionIPtr& connection)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _connections.push_back(connection);
+}
+
+bool
+IceInternal::ConnectionPool::remove(const ConnectionIPtr& connection)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _connections.erase(std::remove(_connections.begin(), _connections.end(), connection), _connections.end());
+    return _connections.empty();
+}
+
+void
+IceInternal::ConnectionPool::expanded()
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _expanding = false;
+}
+
 bool
 IceInternal::OutgoingConnectionFactory::ConnectorInfo::operator==(const ConnectorInfo& other) const
 {
@@ -260,6 +383,7 @@ IceInternal::OutgoingConnectionFactory::waitUntilFinished()
         cons.clear();
         _connections.clear();
         _connectionsByEndpoint.clear();
+        _pools.clear();
     }
 
     //
@@ -413,11 +537,57 @@ IceInternal::OutgoingConnectionFactory::flushAsyncBatchRequests(const Communicat
     }
 }
 
+ConnectionPoolPtr
+IceInternal::OutgoingConnectionFactory::getConnectionPool(const ConnectionIPtr& connection)
+{
+    if(_connectionPoolSize <= 1)
+    {
+        return 0;
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    map<ConnectorPtr, ConnectionPoolPtr>::const_iterator p = _pools.find(connection->connector());
+    return p != _pools.end() ? p->second : ConnectionPoolPtr();
+}
+
+void
+IceInternal::OutgoingConnectionFactory::expandConnectionPool(const ConnectionPoolPtr& pool,
+                                                             const ConnectionIPtr& connection)
+{
+    vector<EndpointIPtr> endpoints;
+    endpoints.push_back(connection->endpoint());
+    CreateConnectionCallbackPtr callback = new PooledConnectionCallback(pool);
+#ifdef ICE_CPP11_MAPPING
+    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, false, callback,
+                                           Ice::EndpointSelectionType::Ordered, true);
+#else
+    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, false, callback, Ice::Ordered, true);
+#endif
+    try
+    {
+        incPendingConnectCount();
+    }
+    catch(const Ice::LocalException&)
+    {
+        pool->expanded();
+        return;
+    }
+
+    //
+    // The connector is already known, there's no need to resolve the endpoint.
+    //
+    cb->connectors(vector<ConnectorPtr>(1, connection->connector()));
+}
+
 IceInternal::OutgoingConnectionFactory::OutgoingConnectionFactory(const CommunicatorPtr& communicator,
                                                                   const InstancePtr& instance) :
     _communicator(communicator),
     _instance(instance),
-    _monitor(new FactoryACMMonitor(instance, instance->clientACM())),
+    _monitor(new FactoryACMMonitor(instance, instance->clientACM(), "Client")),
+    _connectAttemptDelay(instance->initializationData().properties->getPropertyAsIntWithDefault(
+                             "Ice.ConnectAttemptDelay", -1)),
+    _connectionPoolSize(static_cast<size_t>(max(instance->initializationData().properties->getPropertyAsIntWithDefault(
+                                                    "Ice.ConnectionPoolSize", 1), 1))),
     _destroyed(false),
     _pendingConnectCount(0)
 {
@@ -463,15 +633,23 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
     assert(!endpoints.empty());
     for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
     {
+        ConnectionIPtr connection;
+        if(_connectionPoolSize > 1)
+        {
+            connection = leastLoaded(_connectionsByEndpoint.equal_range(*p));
+        }
+        else
+        {
 #ifdef ICE_CPP11_MAPPING
-        auto connection = find(_connectionsByEndpoint, *p,
-                               [](const ConnectionIPtr& conn)
-                               {
-                                   return conn->isActiveOrHolding();
-                               });
+            connection = find(_connectionsByEndpoint, *p,
+                              [](const ConnectionIPtr& conn)
+                              {
+                                  return conn->isActiveOrHolding();
+                              });
 #else
-        ConnectionIPtr connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+            connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
 #endif
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -496,20 +674,32 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInf
     DefaultsAndOverridesPtr defaultsAndOverrides = _instance->defaultsAndOverrides();
     for(vector<ConnectorInfo>::const_iterator p = connectors.begin(); p != connectors.end(); ++p)
     {
-        if(_pending.find(p->connector) != _pending.end())
+        ConnectionIPtr connection;
+        if(_connectionPoolSize > 1)
         {
-            continue;
+            //
+            // Unlike non-pooled connections, pooled connections can be used while
+            // another connection to the same connector is being established.
+            //
+            connection = leastLoaded(_connections.equal_range(p->connector));
         }
+        else
+        {
+            if(_pending.find(p->connector) != _pending.end())
+            {
+                continue;
+            }
 
 #ifdef ICE_CPP11_MAPPING
-        auto connection = find(_connections, p->connector,
-                               [](const ConnectionIPtr& conn)
-                               {
-                                   return conn->isActiveOrHolding();
-                               });
+            connection = find(_connections, p->connector,
+                              [](const ConnectionIPtr& conn)
+                              {
+                                  return conn->isActiveOrHolding();
+                              });
 #else
-        ConnectionIPtr connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+            connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
 #endif
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -580,6 +770,12 @@ IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo
             remove(_connections, (*p)->connector(), *p);
             remove(_connectionsByEndpoint, (*p)->endpoint(), *p);
             remove(_connectionsByEndpoint, (*p)->endpoint()->compress(true), *p);
+
+            map<ConnectorPtr, ConnectionPoolPtr>::iterator q = _pools.find((*p)->connector());
+            if(q != _pools.end() && q->second->remove(*p))
+            {
+                _pools.erase(q);
+            }
         }
 
         //
@@ -595,12 +791,16 @@ IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo
             }
 
             //
-            // Search for a matching connection. If we find one, we're done.
+            // Search for a matching connection. If we find one, we're done. A
+            // connection pool is expanded with a new connection instead.
             //
-            Ice::ConnectionIPtr connection = findConnection(connectors, compress);
-            if(connection)
+            if(!cb || !cb->expandsPool())
             {
-                return connection;
+                Ice::ConnectionIPtr connection = findConnection(connectors, compress);
+                if(connection)
+                {
+                    return connection;
+                }
             }
 
             //
@@ -689,6 +889,15 @@ IceInternal::OutgoingConnectionFactory::createConnection(const TransceiverPtr& t
     _connectionsByEndpoint.insert(pair<const EndpointIPtr, ConnectionIPtr>(connection->endpoint(), connection));
     _connectionsByEndpoint.insert(pair<const EndpointIPtr, ConnectionIPtr>(connection->endpoint()->compress(true),
                                                                            connection));
+    if(_connectionPoolSize > 1)
+    {
+        ConnectionPoolPtr& pool = _pools[ci.connector];
+        if(!pool)
+        {
+            pool = new ConnectionPool(_connectionPoolSize);
+        }
+        pool->add(connection);
+    }
     return connection;
 }
 
@@ -928,13 +1137,17 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
                                                                          const vector<EndpointIPtr>& endpoints,
                                                                          bool hasMore,
                                                                          const CreateConnectionCallbackPtr& cb,
-                                                                         Ice::EndpointSelectionType selType) :
+                                                                         Ice::EndpointSelectionType selType,
+                                                                         bool expandPool) :
     _instance(instance),
     _factory(factory),
     _endpoints(endpoints),
     _hasMore(hasMore),
     _callback(cb),
-    _selType(selType)
+    _selType(selType),
+    _expandPool(expandPool),
+    _attemptTimerScheduled(false),
+    _done(false)
 {
     _endpointsIter = _endpoints.begin();
 }
@@ -945,6 +1158,12 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartCompleted(const ConnectionIPtr& connection)
 {
+    if(_factory->_connectAttemptDelay >= 0)
+    {
+        attemptCompleted(connection);
+        return;
+    }
+
     if(_observer)
     {
         _observer->detach();
@@ -955,9 +1174,34 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartComplete
 }
 
 void
-IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& /*connection*/,
+IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& connection,
                                                                                const LocalException& ex)
 {
+    if(_factory->_connectAttemptDelay >= 0)
+    {
+        Ice::Instrumentation::ObserverPtr observer;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            list<Attempt>::iterator p = findAttempt(connection);
+            observer = p->observer;
+            _attempts.erase(p);
+            if(_done)
+            {
+                //
+                // Another attempt already established the connection, this
+                // attempt failed because it was canceled.
+                //
+                if(observer)
+                {
+                    observer->detach();
+                }
+                return;
+            }
+        }
+        attemptFailed(observer, ex);
+        return;
+    }
+
     assert(_iter != _connectors.end());
     if(connectionStartFailedImpl(ex))
     {
@@ -1017,6 +1261,35 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::exception(const Ice::Lo
     }
 }
 
+//
+// Methods from IceUtil::TimerTask
+//
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::runTimerTask()
+{
+    //
+    // The connection attempt delay expired without the connection being
+    // established, start the connection attempt to the next connector.
+    //
+    startAttempt();
+
+    bool more;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        more = !_done && _iter != _connectors.end();
+    }
+    if(!more)
+    {
+        try
+        {
+            _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+    }
+}
+
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnectors()
 {
@@ -1088,6 +1361,21 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnection()
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::nextConnector()
 {
+    if(_factory->_connectAttemptDelay >= 0)
+    {
+        //
+        // Start the first connection attempt. Other attempts are started by the timer
+        // or when an attempt fails. With no delay, all the attempts are started now.
+        //
+        bool started;
+        do
+        {
+            started = startAttempt();
+        }
+        while(started && _factory->_connectAttemptDelay == 0);
+        return;
+    }
+
     while(true)
     {
         try
@@ -1211,6 +1499,225 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailedIm
     return false;
 }
 
+bool
+IceInternal::OutgoingConnectionFactory::ConnectCallback::startAttempt()
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_done || _iter == _connectors.end())
+    {
+        return false;
+    }
+    vector<ConnectorInfo>::const_iterator ci = _iter++;
+
+    Ice::Instrumentation::ObserverPtr observer;
+    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+    if(obsv)
+    {
+        observer = obsv->getConnectionEstablishmentObserver(ci->endpoint, ci->connector->toString());
+        if(observer)
+        {
+            observer->attach();
+        }
+    }
+
+    if(_instance->traceLevels()->network >= 2)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+        out << "trying to establish " << ci->endpoint->protocol() << " connection to " << ci->connector->toString();
+    }
+
+    Ice::ConnectionIPtr connection;
+    try
+    {
+        //
+        // The connection is created with the mutex locked to ensure it's either canceled by
+        // attemptCompleted() or not created at all if another attempt completes concurrently.
+        //
+        connection = _factory->createConnection(ci->connector->connect(), *ci);
+        _attempts.push_back(Attempt(ci, connection, observer));
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        if(_instance->traceLevels()->network >= 2)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            out << "failed to establish " << ci->endpoint->protocol() << " connection to "
+                << ci->connector->toString() << "\n" << ex;
+        }
+        sync.release();
+        attemptFailed(observer, ex);
+        return true;
+    }
+
+    if(!_attemptTimerScheduled && _factory->_connectAttemptDelay > 0 && _iter != _connectors.end())
+    {
+        try
+        {
+            _instance->timer()->scheduleRepeated(ICE_SHARED_FROM_THIS,
+                                                 IceUtil::Time::milliSeconds(_factory->_connectAttemptDelay));
+            _attemptTimerScheduled = true;
+        }
+        catch(const IceUtil::Exception&)
+        {
+            // The communicator is being destroyed, the pending attempts will fail.
+        }
+    }
+    sync.release();
+
+    connection->start(ICE_SHARED_FROM_THIS);
+    return true;
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::attemptCompleted(const Ice::ConnectionIPtr& connection)
+{
+    vector<ConnectorInfo>::const_iterator ci;
+    Ice::Instrumentation::ObserverPtr observer;
+    bool first;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        list<Attempt>::iterator p = findAttempt(connection);
+        ci = p->connector;
+        observer = p->observer;
+        _attempts.erase(p);
+        first = !_done;
+        _done = true;
+    }
+
+    if(observer)
+    {
+        observer->detach();
+    }
+
+    if(!first)
+    {
+        //
+        // Another connection attempt completed first, close this connection.
+        //
+        connection->close(ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
+        return;
+    }
+
+    cancelAttempts();
+    connection->activate();
+    _factory->finishGetConnection(_connectors, *ci, connection, ICE_SHARED_FROM_THIS);
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::attemptFailed(const Ice::Instrumentation::ObserverPtr& observer,
+                                                                       const Ice::LocalException& ex)
+{
+    if(observer)
+    {
+        observer->failed(ex.ice_id());
+        observer->detach();
+    }
+
+    bool hasMore;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_done)
+        {
+            return;
+        }
+        hasMore = _iter != _connectors.end() || !_attempts.empty();
+    }
+    _factory->handleConnectionException(ex, _hasMore || hasMore);
+
+    bool destroyed = dynamic_cast<const Ice::CommunicatorDestroyedException*>(&ex);
+    if(!destroyed)
+    {
+        resetAttemptTimer();
+        if(startAttempt())
+        {
+            return; // Try the next connector.
+        }
+    }
+
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_done || (!destroyed && !_attempts.empty()))
+        {
+            return; // Wait for the pending attempts to complete.
+        }
+        _done = true;
+    }
+
+    cancelAttempts();
+    _factory->finishGetConnection(_connectors, ex, ICE_SHARED_FROM_THIS);
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::resetAttemptTimer()
+{
+    //
+    // A failed attempt starts the next attempt right away, the attempt timer
+    // is canceled and rescheduled by startAttempt() so that the following
+    // attempt is started after a full delay.
+    //
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_attemptTimerScheduled)
+    {
+        try
+        {
+            _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+        _attemptTimerScheduled = false;
+    }
+}
+
+list<IceInternal::OutgoingConnectionFactory::ConnectCallback::Attempt>::iterator
+IceInternal::OutgoingConnectionFactory::ConnectCallback::findAttempt(const Ice::ConnectionIPtr& connection)
+{
+    // Must be called with the mutex locked.
+    list<Attempt>::iterator p = _attempts.begin();
+    while(p != _attempts.end() && p->connection.get() != connection.get())
+    {
+        ++p;
+    }
+    assert(p != _attempts.end());
+    return p;
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::cancelAttempts()
+{
+    //
+    // Close the connections of the attempts still pending and cancel the attempt
+    // timer, this must be called once the connection establishment is done.
+    //
+    vector<Ice::ConnectionIPtr> connections;
+    bool cancelTimer;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        assert(_done);
+        for(list<Attempt>::const_iterator p = _attempts.begin(); p != _attempts.end(); ++p)
+        {
+            connections.push_back(p->connection);
+        }
+        cancelTimer = _attemptTimerScheduled;
+    }
+
+    if(cancelTimer)
+    {
+        try
+        {
+            _instance->timer()->cancel(ICE_SHARED_FROM_THIS);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+    }
+
+    for(vector<Ice::ConnectionIPtr>::const_iterator p = connections.begin(); p != connections.end(); ++p)
+    {
+        (*p)->close(ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
+    }
+}
+
 void
 IceInternal::IncomingConnectionFactory::activate()
 {
@@ -1698,7 +2205,8 @@ IceInternal::IncomingConnectionFactory::IncomingConnectionFactory(const Instance
                                                                   const EndpointIPtr& publishedEndpoint,
                                                                   const ObjectAdapterIPtr& adapter) :
     _instance(instance),
-    _monitor(new FactoryACMMonitor(instance, dynamic_cast<ObjectAdapterI*>(adapter.get())->getACM())),
+    _monitor(new FactoryACMMonitor(instance, dynamic_cast<ObjectAdapterI*>(adapter.get())->getACM(),
+                                   adapter->getName())),
     _endpoint(endpoint),
     _publishedEndpoint(publishedEndpoint),
     _acceptorStarted(false),
@@ -7,6 +7,7 @@
 
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
+#include <IceUtil/Timer.h>
 #include <Ice/CommunicatorF.h>
 #include <Ice/ConnectionFactoryF.h>
 #include <Ice/ConnectionI.h>
@@ -39,6 +40,36 @@ ICE_DEFINE_PTR(ObjectAdapterIPtr, ObjectAdapterI);
 namespace IceInternal
 {
 
+//
+// The connections to a connector, used when Ice.ConnectionPoolSize is greater
+// than 1. The connection request handlers keep the pool of their connection to
+// select the least loaded connection without locking the factory.
+//
+class ConnectionPool : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    ConnectionPool(size_t);
+
+    //
+    // Get the active connection with the fewest outstanding requests, or the
+    // given connection if the pool has no active connections. expand is set
+    // to true if the caller must expand the pool with a new connection.
+    //
+    Ice::ConnectionIPtr get(const Ice::ConnectionIPtr&, bool&);
+    std::vector<Ice::ConnectionIPtr> connections(const Ice::ConnectionIPtr&) const;
+
+    void add(const Ice::ConnectionIPtr&);
+    bool remove(const Ice::ConnectionIPtr&);
+    void expanded();
+
+private:
+
+    const size_t _size;
+    std::vector<Ice::ConnectionIPtr> _connections;
+    bool _expanding;
+};
+
 class OutgoingConnectionFactory : public virtual IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
@@ -63,6 +94,16 @@ public:
     void removeAdapter(const Ice::ObjectAdapterPtr&);
     void flushAsyncBatchRequests(const CommunicatorFlushBatchAsyncPtr&, Ice::CompressBatch);
 
+    //
+    // Connection pooling, used when Ice.ConnectionPoolSize is greater than 1: up
+    // to ConnectionPoolSize connections are established to the same connector and
+    // invocations are sent over the connection with the fewest outstanding requests.
+    // The pool size is communicator-wide, proxies which need their own pool can use
+    // ice_connectionId since connections with different ids are pooled separately.
+    //
+    ConnectionPoolPtr getConnectionPool(const Ice::ConnectionIPtr&);
+    void expandConnectionPool(const ConnectionPoolPtr&, const Ice::ConnectionIPtr&);
+
     OutgoingConnectionFactory(const Ice::CommunicatorPtr&, const InstancePtr&);
     virtual ~OutgoingConnectionFactory();
     friend class Instance;
@@ -82,7 +123,8 @@ private:
     };
 
     class ConnectCallback : public Ice::ConnectionI::StartCallback,
-                            public IceInternal::EndpointI_connectors
+                            public IceInternal::EndpointI_connectors,
+                            public IceUtil::TimerTask
 #ifdef ICE_CPP11_MAPPING
                           , public std::enable_shared_from_this<ConnectCallback>
 #endif
@@ -91,7 +133,7 @@ private:
     public:
 
         ConnectCallback(const InstancePtr&, const OutgoingConnectionFactoryPtr&, const std::vector<EndpointIPtr>&, bool,
-                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType);
+                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType, bool = false);
 
         virtual void connectionStartCompleted(const Ice::ConnectionIPtr&);
         virtual void connectionStartFailed(const Ice::ConnectionIPtr&, const Ice::LocalException&);
@@ -99,6 +141,8 @@ private:
         virtual void connectors(const std::vector<ConnectorPtr>&);
         virtual void exception(const Ice::LocalException&);
 
+        virtual void runTimerTask();
+
         void getConnectors();
         void nextEndpoint();
 
@@ -114,20 +158,60 @@ private:
 
         bool operator<(const ConnectCallback&) const;
 
+        //
+        // Returns true if the callback establishes a new connection for a connection
+        // pool, existing connections to the connectors are not used in this case.
+        //
+        bool expandsPool() const
+        {
+            return _expandPool;
+        }
+
     private:
 
         bool connectionStartFailedImpl(const Ice::LocalException&);
 
+        //
+        // Parallel connection establishment, used when Ice.ConnectAttemptDelay is
+        // not negative: connection attempts to the connectors are started in turn
+        // every ConnectAttemptDelay milliseconds (or immediately if the previous
+        // attempt failed) until one of the connections is established.
+        //
+        struct Attempt
+        {
+            Attempt(std::vector<ConnectorInfo>::const_iterator ci, const Ice::ConnectionIPtr& c,
+                    const Ice::Instrumentation::ObserverPtr& o) : connector(ci), connection(c), observer(o)
+            {
+            }
+
+            std::vector<ConnectorInfo>::const_iterator connector;
+            Ice::ConnectionIPtr connection;
+            Ice::Instrumentation::ObserverPtr observer;
+        };
+
+        bool startAttempt();
+        void attemptCompleted(const Ice::ConnectionIPtr&);
+        void attemptFailed(const Ice::Instrumentation::ObserverPtr&, const Ice::LocalException&);
+        void resetAttemptTimer();
+        std::list<Attempt>::iterator findAttempt(const Ice::ConnectionIPtr&);
+        void cancelAttempts();
+
         const InstancePtr _instance;
         const OutgoingConnectionFactoryPtr _factory;
         const std::vector<EndpointIPtr> _endpoints;
         const bool _hasMore;
         const CreateConnectionCallbackPtr _callback;
         const Ice::EndpointSelectionType _selType;
+        const bool _expandPool;
         Ice::Instrumentation::ObserverPtr _observer;
         std::vector<EndpointIPtr>::const_iterator _endpointsIter;
         std::vector<ConnectorInfo> _connectors;
         std::vector<ConnectorInfo>::const_iterator _iter;
+
+        IceUtil::Mutex _mutex;
+        std::list<Attempt> _attempts;
+        bool _attemptTimerScheduled;
+        bool _done;
     };
     ICE_DEFINE_PTR(ConnectCallbackPtr, ConnectCallback);
     friend class ConnectCallback;
@@ -147,15 +231,19 @@ private:
     Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, bool&);
     Ice::ConnectionIPtr createConnection(const TransceiverPtr&, const ConnectorInfo&);
 
+
     void handleException(const Ice::LocalException&, bool);
     void handleConnectionException(const Ice::LocalException&, bool);
 
     Ice::CommunicatorPtr _communicator;
     const InstancePtr _instance;
     const FactoryACMMonitorPtr _monitor;
+    const int _connectAttemptDelay;
+    const size_t _connectionPoolSize;
     bool _destroyed;
 
     std::multimap<ConnectorPtr, Ice::ConnectionIPtr> _connections;
+    std::map<ConnectorPtr, ConnectionPoolPtr> _pools;
     std::map<ConnectorPtr, std::set<ConnectCallbackPtr> > _pending;
 
 #ifdef ICE_CPP11_MAPPING
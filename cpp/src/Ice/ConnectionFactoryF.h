@@ -16,6 +16,10 @@ class OutgoingConnectionFactory;
 IceUtil::Shared* upCast(OutgoingConnectionFactory*);
 typedef IceInternal::Handle<OutgoingConnectionFactory> OutgoingConnectionFactoryPtr;
 
+class ConnectionPool;
+IceUtil::Shared* upCast(ConnectionPool*);
+typedef IceInternal::Handle<ConnectionPool> ConnectionPoolPtr;
+
 class IncomingConnectionFactory;
 
 #ifdef ICE_CPP11_MAPPING
@@ -92,6 +92,20 @@ public:
                               _outAsync, _heartbeatCallback, _stream);
     }
 
+    virtual void
+    cancel(const LocalException& ex)
+    {
+        //
+        // Only requests are cancelled, they're queued without the
+        // other callbacks of the message.
+        //
+        assert(!_startCB && _sentCBs.empty() && !_outAsync && !_heartbeatCallback);
+        if(_invokeNum > 0)
+        {
+            _connection->invokeException(_requestId, ex, _invokeNum, false);
+        }
+    }
+
 private:
 
     const ConnectionIPtr _connection;
@@ -107,6 +121,71 @@ private:
     InputStream _stream;
 };
 
+//
+// Returns true if the request read from the given stream must be
+// dispatched with high priority. The request header is read without
+// consuming the stream, only the operation and the _priority context
+// entry are unmarshaled.
+//
+bool
+isHighPriority(InputStream& stream, Int invokeNum, const ObjectAdapterPtr& adapter)
+{
+    ObjectAdapterI* adapterI = dynamic_cast<ObjectAdapterI*>(adapter.get());
+    if(!adapterI)
+    {
+        return true; // The dispatch fails without calling a servant.
+    }
+    if(invokeNum > 1)
+    {
+        return false; // Batch requests are always dispatched with normal priority.
+    }
+
+    InputStream::Container::iterator start = stream.i;
+    try
+    {
+        stream.skip(static_cast<size_t>(stream.readSize())); // Identity name
+        stream.skip(static_cast<size_t>(stream.readSize())); // Identity category
+        for(Int sz = stream.readSize(); sz > 0; --sz)
+        {
+            stream.skip(static_cast<size_t>(stream.readSize())); // Facet path
+        }
+        bool highPriority = false;
+        if(adapterI->hasPriorityOperations())
+        {
+            string operation;
+            stream.read(operation, false);
+            highPriority = adapterI->isPriorityOperation(operation);
+        }
+        else
+        {
+            stream.skip(static_cast<size_t>(stream.readSize())); // Operation
+        }
+        stream.skip(1); // Mode
+        for(Int sz = stream.readSize(); sz > 0 && !highPriority; --sz)
+        {
+            string key;
+            stream.read(key, false);
+            if(key == "_priority")
+            {
+                string value;
+                stream.read(value, false);
+                highPriority = value == "high";
+            }
+            else
+            {
+                stream.skip(static_cast<size_t>(stream.readSize()));
+            }
+        }
+        stream.i = start;
+        return highPriority;
+    }
+    catch(const LocalException&)
+    {
+        stream.i = start;
+        return true; // The dispatch raises the exception right away.
+    }
+}
+
 class FinishCall : public DispatchWorkItem
 {
 public:
@@ -529,6 +608,18 @@ Ice::ConnectionI::isActiveOrHolding() const
     return _state > StateNotValidated && _state < StateClosing;
 }
 
+int
+Ice::ConnectionI::outstandingRequests() const
+{
+    return _outstandingRequests.load();
+}
+
+bool
+Ice::ConnectionI::isActiveOrHoldingSnapshot() const
+{
+    return _activeOrHolding.load() != 0;
+}
+
 bool
 Ice::ConnectionI::isFinished() const
 {
@@ -618,13 +709,14 @@ Ice::ConnectionI::updateObserver()
     _observer.attach(o);
 }
 
-void
-Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
+IceUtil::Time
+Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm, bool park)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    const IceUtil::Time next = now + acm.timeout / 2;
     if(_state != StateActive)
     {
-        return;
+        return next;
     }
     assert(acm.timeout != IceUtil::Time());
 
@@ -658,7 +750,7 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
         // This check is necessary because the actitivy timer is
         // only set when a message is fully read/written.
         //
-        return;
+        return next;
     }
 
     if(acm.close != ICE_ENUM(ACMClose, CloseOff) && now >= (_acmLastActivity + acm.timeout))
@@ -680,6 +772,64 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
             //
             setState(StateClosing, ConnectionTimeoutException(__FILE__, __LINE__));
         }
+
+        if(_state != StateActive)
+        {
+            return next;
+        }
+    }
+
+    //
+    // Compute when the connection needs to be monitored again. A
+    // heartbeat might be due every (timeout / 2) period, the close
+    // check is only due once the connection has been inactive for
+    // the timeout period.
+    //
+    IceUtil::Time deadline;
+    if(acm.heartbeat == ICE_ENUM(ACMHeartbeat, HeartbeatAlways) ||
+       acm.heartbeat == ICE_ENUM(ACMHeartbeat, HeartbeatOnIdle) ||
+       (acm.heartbeat == ICE_ENUM(ACMHeartbeat, HeartbeatOnDispatch) && _dispatchCount > 0))
+    {
+        deadline = next;
+    }
+    if(acm.close != ICE_ENUM(ACMClose, CloseOff) &&
+       (acm.close != ICE_ENUM(ACMClose, CloseOnInvocation) || !_asyncRequests.empty()))
+    {
+        IceUtil::Time closeDeadline = _acmLastActivity + acm.timeout;
+        if(closeDeadline <= now)
+        {
+            closeDeadline = next;
+        }
+        if(deadline == IceUtil::Time() || closeDeadline < deadline)
+        {
+            deadline = closeDeadline;
+        }
+    }
+
+    //
+    // If there's nothing to monitor until a dispatch or invocation
+    // occurs, the connection is parked if the caller allows it. It
+    // will be added back to the monitor on the next dispatch or
+    // invocation.
+    //
+    if(deadline == IceUtil::Time())
+    {
+        if(!park)
+        {
+            return next;
+        }
+        _acmParked = true;
+    }
+    return deadline;
+}
+
+void
+Ice::ConnectionI::unparkMonitor()
+{
+    if(_acmParked && _state == StateActive)
+    {
+        _acmParked = false;
+        _monitor->add(ICE_SHARED_FROM_THIS);
     }
 }
 
@@ -767,6 +917,8 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
         //
         _asyncRequestsHint = _asyncRequests.insert(_asyncRequests.end(),
                                                    pair<const Int, OutgoingAsyncBasePtr>(requestId, out));
+        _outstandingRequests.exchange(static_cast<int>(_asyncRequests.size()));
+        unparkMonitor();
     }
     return status;
 }
@@ -1160,6 +1312,7 @@ Ice::ConnectionI::setACM(const IceUtil::Optional<int>& timeout,
         _monitor->remove(ICE_SHARED_FROM_THIS);
     }
     _monitor = _monitor->acm(timeout, close, heartbeat);
+    _acmParked = false;
 
     if(_monitor->getACM().timeout <= 0)
     {
@@ -1216,6 +1369,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 {
                     _asyncRequests.erase(o->requestId);
                 }
+                _outstandingRequests.exchange(static_cast<int>(_asyncRequests.size()));
             }
 
             if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
@@ -1260,6 +1414,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 {
                     _asyncRequests.erase(_asyncRequestsHint);
                     _asyncRequestsHint = _asyncRequests.end();
+                    _outstandingRequests.exchange(static_cast<int>(_asyncRequests.size()));
                     if(outAsync->exception(ex))
                     {
                         outAsync->invokeExceptionAsync();
@@ -1281,6 +1436,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 {
                     assert(p != _asyncRequestsHint);
                     _asyncRequests.erase(p);
+                    _outstandingRequests.exchange(static_cast<int>(_asyncRequests.size()));
                     if(outAsync->exception(ex))
                     {
                         outAsync->invokeExceptionAsync();
@@ -1295,73 +1451,91 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
 void
 Ice::ConnectionI::sendResponse(Int, OutputStream* os, Byte compressFlag, bool /*amd*/)
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    assert(_state > StateNotValidated);
-
-    try
+    ObjectAdapterIPtr dispatchAdapter;
     {
-        if(--_dispatchCount == 0)
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        assert(_state > StateNotValidated);
+
+        dispatchAdapter = finishRequests(1);
+
+        try
         {
-            if(_state == StateFinished)
+            if(--_dispatchCount == 0)
             {
-                reap();
+                if(_state == StateFinished)
+                {
+                    reap();
+                }
+                notifyAll();
             }
-            notifyAll();
-        }
 
-        if(_state >= StateClosed)
-        {
-            assert(_exception);
-            _exception->ice_throw();
-        }
+            if(_state >= StateClosed)
+            {
+                assert(_exception);
+                _exception->ice_throw();
+            }
 
-        OutgoingMessage message(os, compressFlag > 0);
-        sendMessage(message);
+            OutgoingMessage message(os, compressFlag > 0);
+            sendMessage(message);
 
-        if(_state == StateClosing && _dispatchCount == 0)
+            if(_state == StateClosing && _dispatchCount == 0)
+            {
+                initiateShutdown();
+            }
+        }
+        catch(const LocalException& ex)
         {
-            initiateShutdown();
+            setState(StateClosed, ex);
         }
-
-        return;
     }
-    catch(const LocalException& ex)
+
+    if(dispatchAdapter)
     {
-        setState(StateClosed, ex);
+        dispatchAdapter->decDispatchCount(1);
     }
 }
 
 void
 Ice::ConnectionI::sendNoResponse()
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    assert(_state > StateNotValidated);
-
-    try
+    ObjectAdapterIPtr dispatchAdapter;
     {
-        if(--_dispatchCount == 0)
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        assert(_state > StateNotValidated);
+
+        dispatchAdapter = finishRequests(1);
+
+        try
         {
-            if(_state == StateFinished)
+            if(--_dispatchCount == 0)
             {
-                reap();
+                if(_state == StateFinished)
+                {
+                    reap();
+                }
+                notifyAll();
             }
-            notifyAll();
-        }
 
-        if(_state >= StateClosed)
-        {
-            assert(_exception);
-            _exception->ice_throw();
-        }
+            if(_state >= StateClosed)
+            {
+                assert(_exception);
+                _exception->ice_throw();
+            }
 
-        if(_state == StateClosing && _dispatchCount == 0)
+            if(_state == StateClosing && _dispatchCount == 0)
+            {
+                initiateShutdown();
+            }
+        }
+        catch(const LocalException& ex)
         {
-            initiateShutdown();
+            setState(StateClosed, ex);
         }
     }
-    catch(const LocalException& ex)
+
+    if(dispatchAdapter)
     {
-        setState(StateClosed, ex);
+        dispatchAdapter->decDispatchCount(1);
     }
 }
 
@@ -1379,22 +1553,32 @@ Ice::ConnectionI::invokeException(Ice::Int, const LocalException& ex, int invoke
     // called in case of a fatal exception we decrement _dispatchCount here.
     //
 
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    setState(StateClosed, ex);
-
-    if(invokeNum > 0)
+    ObjectAdapterIPtr dispatchAdapter;
     {
-        assert(_dispatchCount >= invokeNum);
-        _dispatchCount -= invokeNum;
-        if(_dispatchCount == 0)
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        setState(StateClosed, ex);
+
+        if(invokeNum > 0)
         {
-            if(_state == StateFinished)
+            dispatchAdapter = finishRequests(invokeNum);
+
+            assert(_dispatchCount >= invokeNum);
+            _dispatchCount -= invokeNum;
+            if(_dispatchCount == 0)
             {
-                reap();
+                if(_state == StateFinished)
+                {
+                    reap();
+                }
+                notifyAll();
             }
-            notifyAll();
         }
     }
+
+    if(dispatchAdapter)
+    {
+        dispatchAdapter->decDispatchCount(invokeNum);
+    }
 }
 
 EndpointIPtr
@@ -1460,6 +1644,28 @@ Ice::ConnectionI::createProxy(const Identity& ident) const
         _instance->referenceFactory()->create(ident, ICE_SHARED_FROM_CONST_THIS(ConnectionI)));
 }
 
+void
+Ice::ConnectionI::resumeAdapterDispatches()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(_readSuspended & ReadSuspendedByAdapter)
+    {
+        _readSuspended &= ~ReadSuspendedByAdapter;
+        resumeReading();
+    }
+}
+
+void
+Ice::ConnectionI::resumeNormalPriorityDispatches()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(_readSuspended & ReadSuspendedByThreadPool)
+    {
+        _readSuspended &= ~ReadSuspendedByThreadPool;
+        resumeReading();
+    }
+}
+
 void
 Ice::ConnectionI::setAdapterAndServantManager(const ObjectAdapterPtr& adapter,
                                               const IceInternal::ServantManagerPtr& servantManager)
@@ -1586,6 +1792,7 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
     ObjectAdapterPtr adapter;
     OutgoingAsyncBasePtr outAsync;
     ICE_DELEGATE(HeartbeatCallback) heartbeatCallback;
+    ObjectAdapterIPtr dispatchAdapter;
     int dispatchCount = 0;
 
     ThreadPoolMessage<ConnectionI> msg(current, *this);
@@ -1776,6 +1983,10 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                                                                               outAsync,
                                                                               heartbeatCallback,
                                                                               dispatchCount));
+                    if(invokeNum > 0)
+                    {
+                        dispatchAdapter = _dispatchAdapter;
+                    }
                 }
 
                 if(readyOp & SocketOperationWrite)
@@ -1805,6 +2016,7 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
             }
 
             _dispatchCount += dispatchCount;
+            unparkMonitor();
             io.completed();
         }
         catch(const DatagramLimitException&) // Expected.
@@ -1851,8 +2063,87 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                                                          invokeNum, servantManager, adapter, outAsync,
                                                          heartbeatCallback, current.stream));
 #else
+    if(dispatchAdapter && !dispatchAdapter->startDispatch(invokeNum))
+    {
+        //
+        // The adapter dispatches the maximum number of requests, the
+        // requests are queued with the adapter and dispatched once
+        // other dispatches complete. The other callbacks of this
+        // message are dispatched right away.
+        //
+        dispatchAdapter->queueDispatch(invokeNum, _threadPool,
+                                       new DispatchCall(ICE_SHARED_FROM_THIS, ICE_NULLPTR, vector<OutgoingMessage>(),
+                                                        compress, requestId, invokeNum, servantManager, adapter,
+                                                        ICE_NULLPTR, ICE_NULLPTR, current.stream));
+        if(!startCB && sentCBs.empty() && !outAsync && !heartbeatCallback)
+        {
+            return;
+        }
+        invokeNum = 0;
+    }
+
     if(!_dispatcher) // Optimization, call dispatch() directly if there's no dispatcher.
     {
+        if(invokeNum > 0 && _threadPool->hasReservedThreads() && !isHighPriority(current.stream, invokeNum, adapter))
+        {
+            //
+            // Normal priority requests are queued if the threads not
+            // reserved for high priority requests are all busy.
+            //
+            if(!_threadPool->startNormalPriority())
+            {
+                //
+                // Only the requests are queued, the other callbacks of
+                // this message are dispatched right away.
+                //
+                _threadPool->queueNormalPriority(new DispatchCall(ICE_SHARED_FROM_THIS, ICE_NULLPTR,
+                                                                  vector<OutgoingMessage>(), compress, requestId,
+                                                                  invokeNum, servantManager, adapter, ICE_NULLPTR,
+                                                                  ICE_NULLPTR, current.stream));
+                if(startCB || !sentCBs.empty() || outAsync || heartbeatCallback)
+                {
+                    dispatch(startCB, sentCBs, compress, requestId, 0, servantManager, adapter, outAsync,
+                             heartbeatCallback, current.stream);
+                }
+                return;
+            }
+
+            try
+            {
+                dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, outAsync,
+                         heartbeatCallback, current.stream);
+            }
+            catch(...)
+            {
+                _threadPool->finishNormalPriority();
+                throw;
+            }
+            _threadPool->finishNormalPriority();
+            return;
+        }
+
+        if(_threadPool->workStealing())
+        {
+            //
+            // The dispatch is queued with this thread, it's executed by
+            // this thread once it returns to the thread pool or stolen
+            // by an idle thread of the pool. The dispatch is executed
+            // right away if the thread pool is being destroyed.
+            //
+            DispatchWorkItemPtr workItem = new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress,
+                                                            requestId, invokeNum, servantManager, adapter, outAsync,
+                                                            heartbeatCallback, current.stream);
+            try
+            {
+                _threadPool->dispatch(workItem);
+            }
+            catch(const CommunicatorDestroyedException&)
+            {
+                workItem->run();
+            }
+            return;
+        }
+
         dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, outAsync, heartbeatCallback,
                  current.stream);
     }
@@ -2141,6 +2432,7 @@ Ice::ConnectionI::finish(bool close)
     }
 
     _asyncRequests.clear();
+    _outstandingRequests.exchange(0);
 
     //
     // Don't wait to be reaped to reclaim memory allocated by read/write streams.
@@ -2271,15 +2563,21 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _readTimeoutScheduled(false),
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _warnUdp(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Datagrams") > 0),
+    _acmParked(false),
     _compressionLevel(1),
     _nextRequestId(1),
     _asyncRequestsHint(_asyncRequests.end()),
+    _outstandingRequests(0),
+    _activeOrHolding(0),
     _messageSizeMax(adapter ? adapter->messageSizeMax() : _instance->messageSizeMax()),
     _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
     _dispatchCount(0),
+    _requestCount(0),
+    _maxRequestCount(0),
+    _readSuspended(0),
     _state(StateNotInitialized),
     _shutdownInitiated(false),
     _initialized(false),
@@ -2448,7 +2746,10 @@ Ice::ConnectionI::setState(State state)
                 {
                     return;
                 }
-                _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+                if(!_readSuspended)
+                {
+                    _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+                }
                 break;
             }
 
@@ -2462,7 +2763,7 @@ Ice::ConnectionI::setState(State state)
                 {
                     return;
                 }
-                if(_state == StateActive)
+                if(_state == StateActive && !_readSuspended)
                 {
                     _threadPool->unregister(ICE_SHARED_FROM_THIS, SocketOperationRead);
                 }
@@ -2524,6 +2825,7 @@ Ice::ConnectionI::setState(State state)
     //
     if(_monitor)
     {
+        _acmParked = false;
         if(state == StateActive)
         {
             if(_acmLastActivity != IceUtil::Time())
@@ -2563,6 +2865,7 @@ Ice::ConnectionI::setState(State state)
         }
     }
     _state = state;
+    _activeOrHolding.exchange(_state > StateNotValidated && _state < StateClosing ? 1 : 0);
 
     notifyAll();
 
@@ -3323,6 +3626,7 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                     servantManager = _servantManager;
                     adapter = _adapter;
                     ++dispatchCount;
+                    startRequests(invokeNum);
                 }
                 break;
             }
@@ -3346,6 +3650,7 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                     servantManager = _servantManager;
                     adapter = _adapter;
                     dispatchCount += invokeNum;
+                    startRequests(invokeNum);
                 }
                 break;
             }
@@ -3384,6 +3689,7 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                     {
                         _asyncRequests.erase(q);
                     }
+                    _outstandingRequests.exchange(static_cast<int>(_asyncRequests.size()));
 
                     stream.swap(*outAsync->getIs());
 
@@ -3457,7 +3763,88 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
         }
     }
 
-    return _state == StateHolding ? SocketOperationNone : SocketOperationRead;
+    return _state == StateHolding || _readSuspended ? SocketOperationNone : SocketOperationRead;
+}
+
+void
+Ice::ConnectionI::startRequests(Int invokeNum)
+{
+    if(invokeNum == 0)
+    {
+        return;
+    }
+
+    //
+    // The dispatch limits are those of the adapter set when the first
+    // of the requests being dispatched was received. If the adapter
+    // is changed, the new limits apply once these requests complete.
+    //
+    if(_requestCount == 0)
+    {
+        ObjectAdapterI* adapter = dynamic_cast<ObjectAdapterI*>(_adapter.get());
+        _maxRequestCount = adapter ? adapter->maxConnectionDispatches() : 0;
+        if(adapter && adapter->maxDispatches() > 0)
+        {
+            _dispatchAdapter = ICE_DYNAMIC_CAST(ObjectAdapterI, _adapter);
+        }
+    }
+    _requestCount += invokeNum;
+
+    //
+    // Stop reading once a limit is reached, requests then wait in the
+    // socket buffers and the peer is eventually blocked from sending
+    // instead of queueing an unbounded number of dispatches.
+    //
+    if(_maxRequestCount > 0 && _requestCount >= _maxRequestCount)
+    {
+        _readSuspended |= ReadSuspendedByConnection;
+    }
+    if(_dispatchAdapter && _dispatchAdapter->suspendReading(ICE_SHARED_FROM_THIS))
+    {
+        _readSuspended |= ReadSuspendedByAdapter;
+    }
+    if(_threadPool->hasReservedThreads() && _threadPool->suspendNormalPriorityReading(ICE_SHARED_FROM_THIS))
+    {
+        _readSuspended |= ReadSuspendedByThreadPool;
+    }
+}
+
+ObjectAdapterIPtr
+Ice::ConnectionI::finishRequests(Int invokeNum)
+{
+    //
+    // Returns the adapter whose dispatch count must be decreased, the
+    // caller must decrease it once the connection is unlocked since
+    // it might resume reading on other connections.
+    //
+    assert(_requestCount >= invokeNum);
+    _requestCount -= invokeNum;
+    if((_readSuspended & ReadSuspendedByConnection) && _requestCount < _maxRequestCount)
+    {
+        _readSuspended &= ~ReadSuspendedByConnection;
+        resumeReading();
+    }
+
+    ObjectAdapterIPtr adapter = _dispatchAdapter;
+    if(_requestCount == 0)
+    {
+        _dispatchAdapter = ICE_NULLPTR;
+    }
+    return adapter;
+}
+
+void
+Ice::ConnectionI::resumeReading()
+{
+    //
+    // Reading is resumed only if the connection is active, reading is
+    // resumed when the connection is activated if it's on hold. If
+    // it's closing, it reads again once the shutdown is initiated.
+    //
+    if(!_readSuspended && _state == StateActive)
+    {
+        _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+    }
 }
 
 void
@@ -10,6 +10,7 @@
 #include <IceUtil/Time.h>
 #include <IceUtil/StopWatch.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/Atomic.h>
 #include <Ice/UniquePtr.h>
 
 #include <Ice/CommunicatorF.h>
@@ -156,6 +157,19 @@ public:
     bool isActiveOrHolding() const;
     bool isFinished() const;
 
+    //
+    // Returns the number of two-way requests waiting for a reply. This
+    // doesn't lock the connection and can be used for load balancing.
+    //
+    int outstandingRequests() const;
+
+    //
+    // Returns true if the connection is active or holding. Like
+    // outstandingRequests, this doesn't lock the connection, the state
+    // might be changing concurrently.
+    //
+    bool isActiveOrHoldingSnapshot() const;
+
     virtual void throwException() const; // From Connection. Throws the connection exception if destroyed.
 
     void waitUntilHolding() const;
@@ -163,7 +177,7 @@ public:
 
     void updateObserver();
 
-    void monitor(const IceUtil::Time&, const IceInternal::ACMConfig&);
+    IceUtil::Time monitor(const IceUtil::Time&, const IceInternal::ACMConfig&, bool = false);
 
     IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int);
 
@@ -222,6 +236,8 @@ public:
     virtual ObjectPrxPtr createProxy(const Identity& ident) const; // From Connection.
 
     void setAdapterAndServantManager(const ObjectAdapterPtr&, const IceInternal::ServantManagerPtr&);
+    void resumeAdapterDispatches();
+    void resumeNormalPriorityDispatches();
 
     //
     // Operations from EventHandler
@@ -287,6 +303,7 @@ private:
 
     void initiateShutdown();
     void sendHeartbeatNow();
+    void unparkMonitor();
 
     bool initialize(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     bool validate(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
@@ -305,6 +322,10 @@ private:
     void invokeAll(Ice::InputStream&, Int, Int, Byte,
                    const IceInternal::ServantManagerPtr&, const ObjectAdapterPtr&);
 
+    void startRequests(Int);
+    ObjectAdapterIPtr finishRequests(Int);
+    void resumeReading();
+
     void scheduleTimeout(IceInternal::SocketOperation status);
     void unscheduleTimeout(IceInternal::SocketOperation status);
 
@@ -354,6 +375,7 @@ private:
     const bool _warnUdp;
 
     IceUtil::Time _acmLastActivity;
+    bool _acmParked;
 
     const int _compressionLevel;
 
@@ -361,6 +383,8 @@ private:
 
     std::map<Int, IceInternal::OutgoingAsyncBasePtr> _asyncRequests;
     std::map<Int, IceInternal::OutgoingAsyncBasePtr>::iterator _asyncRequestsHint;
+    IceUtilInternal::Atomic _outstandingRequests;
+    IceUtilInternal::Atomic _activeOrHolding;
 
     IceInternal::UniquePtr<LocalException> _exception;
 
@@ -377,6 +401,18 @@ private:
 
     int _dispatchCount;
 
+    enum ReadSuspended
+    {
+        ReadSuspendedByConnection = 1,
+        ReadSuspendedByAdapter = 2,
+        ReadSuspendedByThreadPool = 4
+    };
+
+    int _requestCount; // The number of requests being dispatched.
+    int _maxRequestCount;
+    ObjectAdapterIPtr _dispatchAdapter; // The adapter limiting the dispatch of requests, if any.
+    int _readSuspended;
+
     State _state; // The current state.
     bool _shutdownInitiated;
     bool _initialized;
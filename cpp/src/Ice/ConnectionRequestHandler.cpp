@@ -8,16 +8,21 @@
 #include <Ice/ConnectionI.h>
 #include <Ice/RouterInfo.h>
 #include <Ice/OutgoingAsync.h>
+#include <Ice/ConnectionFactory.h>
 
 using namespace std;
 using namespace IceInternal;
 
 ConnectionRequestHandler::ConnectionRequestHandler(const ReferencePtr& reference,
                                                    const Ice::ConnectionIPtr& connection,
-                                                   bool compress) :
+                                                   bool compress,
+                                                   const OutgoingConnectionFactoryPtr& factory,
+                                                   const ConnectionPoolPtr& pool) :
     RequestHandler(reference),
     _connection(connection),
-    _compress(compress)
+    _compress(compress),
+    _factory(factory),
+    _pool(pool)
 {
 }
 
@@ -51,12 +56,38 @@ ConnectionRequestHandler::update(const RequestHandlerPtr& previousHandler, const
 AsyncStatus
 ConnectionRequestHandler::sendAsyncRequest(const ProxyOutgoingAsyncBasePtr& out)
 {
+    if(_pool)
+    {
+        bool expand;
+        Ice::ConnectionIPtr connection = _pool->get(_connection, expand);
+        if(expand)
+        {
+            //
+            // All the pooled connections are busy, establish a new connection
+            // in the background.
+            //
+            _factory->expandConnectionPool(_pool, connection);
+        }
+        return out->invokeRemote(connection, _compress, _response);
+    }
     return out->invokeRemote(_connection, _compress, _response);
 }
 
 void
 ConnectionRequestHandler::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, const Ice::LocalException& ex)
 {
+    if(_pool)
+    {
+        //
+        // The request might have been sent over any of the pooled connections.
+        //
+        vector<Ice::ConnectionIPtr> connections = _pool->connections(_connection);
+        for(vector<Ice::ConnectionIPtr>::const_iterator p = connections.begin(); p != connections.end(); ++p)
+        {
+            (*p)->asyncRequestCanceled(outAsync, ex);
+        }
+        return;
+    }
     _connection->asyncRequestCanceled(outAsync, ex);
 }
 
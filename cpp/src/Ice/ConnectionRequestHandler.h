@@ -8,6 +8,7 @@
 #include <Ice/RequestHandler.h>
 #include <Ice/ReferenceF.h>
 #include <Ice/ProxyF.h>
+#include <Ice/ConnectionFactoryF.h>
 
 namespace IceInternal
 {
@@ -19,7 +20,8 @@ class ConnectionRequestHandler ICE_FINAL : public RequestHandler
 {
 public:
 
-    ConnectionRequestHandler(const ReferencePtr&, const Ice::ConnectionIPtr&, bool);
+    ConnectionRequestHandler(const ReferencePtr&, const Ice::ConnectionIPtr&, bool,
+                             const OutgoingConnectionFactoryPtr& = 0, const ConnectionPoolPtr& = 0);
 
     virtual RequestHandlerPtr update(const RequestHandlerPtr&, const RequestHandlerPtr&);
 
@@ -34,6 +36,8 @@ private:
 
     Ice::ConnectionIPtr _connection;
     bool _compress;
+    const OutgoingConnectionFactoryPtr _factory; // Set if the connection is pooled.
+    const ConnectionPoolPtr _pool;
 };
 
 }
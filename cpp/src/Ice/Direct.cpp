@@ -0,0 +1,259 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Direct.h>
+#include <Ice/Proxy.h>
+#include <Ice/Reference.h>
+#include <Ice/Instance.h>
+#include <Ice/ImplicitContextI.h>
+#include <Ice/CollocatedRequestHandler.h>
+#include <Ice/ObjectAdapterI.h>
+#include <Ice/ServantManager.h>
+#include <Ice/LocalException.h>
+#include <Ice/Properties.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/StringUtil.h>
+#include <Ice/Protocol.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace IceUtilInternal
+{
+
+extern bool printStackTraces;
+
+}
+
+#ifdef ICE_CPP11_MAPPING
+IceInternal::Direct::Direct(ObjectPrx* proxy, const string& operation, OperationMode mode, const Context& context)
+#else
+IceInternal::Direct::Direct(IceProxy::Ice::Object* proxy, const string& operation, OperationMode mode,
+                            const Context& context)
+#endif
+    : _dispatchCount(false)
+{
+    const ReferencePtr& ref = proxy->_getReference();
+    const InstancePtr& instance = ref->getInstance();
+
+    //
+    // Direct calls bypass the dispatcher, the observers and the
+    // invocation timeout, these invocations use the regular
+    // collocated invocation path.
+    //
+    if(!ref->getCollocationOptimized() ||
+       ref->getMode() != Reference::ModeTwoway ||
+       ref->getInvocationTimeout() > 0 ||
+       instance->initializationData().dispatcher ||
+       instance->initializationData().observer)
+    {
+        return;
+    }
+
+    RequestHandlerPtr handler;
+    try
+    {
+        handler = proxy->_getRequestHandler();
+    }
+    catch(const LocalException&)
+    {
+        return; // The regular invocation path reports the failure.
+    }
+
+    CollocatedRequestHandler* collocated = dynamic_cast<CollocatedRequestHandler*>(handler.get());
+    if(!collocated)
+    {
+        return;
+    }
+
+    ObjectAdapterIPtr adapter = collocated->getAdapter();
+    try
+    {
+        adapter->incDirectCount();
+    }
+    catch(const ObjectAdapterDeactivatedException&)
+    {
+        return;
+    }
+
+    //
+    // Only servants registered with the active servant map or default
+    // servants are called directly, servant locators are only called
+    // from the regular dispatch.
+    //
+    _servant = adapter->getServantManager()->findServant(ref->getIdentity(), ref->getFacet());
+    if(!_servant)
+    {
+        adapter->decDirectCount();
+        return;
+    }
+
+    //
+    // Direct calls are not suspended by the adapter MaxDispatches
+    // limit but they count toward it, the adapter stops reading new
+    // requests from its connections while direct calls are running.
+    //
+    if(adapter->maxDispatches() > 0)
+    {
+        adapter->incDispatchCount(1);
+        _dispatchCount = true;
+    }
+
+    _instance = instance;
+    _current.adapter = adapter;
+    _current.id = ref->getIdentity();
+    _current.facet = ref->getFacet();
+    _current.operation = operation;
+    _current.mode = mode;
+    _current.requestId = 1; // Twoway request.
+    _current.encoding = ref->getEncoding();
+
+    if(&context != &Ice::noExplicitContext)
+    {
+        _current.ctx = context;
+    }
+    else
+    {
+        const ImplicitContextIPtr& implicitContext = instance->getImplicitContext();
+        const Context& prxContext = ref->getContext()->getValue();
+        if(implicitContext == 0)
+        {
+            _current.ctx = prxContext;
+        }
+        else
+        {
+            implicitContext->combine(prxContext, _current.ctx);
+        }
+    }
+}
+
+IceInternal::Direct::~Direct()
+{
+    if(_servant)
+    {
+        ObjectAdapterI* adapter = dynamic_cast<ObjectAdapterI*>(_current.adapter.get());
+        assert(adapter);
+        if(_dispatchCount)
+        {
+            adapter->decDispatchCount(1);
+        }
+        adapter->decDirectCount();
+    }
+}
+
+void
+IceInternal::Direct::checkMessageSize(size_t size) const
+{
+    //
+    // The size is a lower bound of the size of the request that a
+    // regular invocation would send, only the message header is
+    // added to the size of the parameters.
+    //
+    ObjectAdapterI* adapter = dynamic_cast<ObjectAdapterI*>(_current.adapter.get());
+    assert(adapter);
+    size += static_cast<size_t>(headerSize);
+    if(size > adapter->messageSizeMax())
+    {
+        Ex::throwMemoryLimitException(__FILE__, __LINE__, size, adapter->messageSizeMax());
+    }
+}
+
+void
+IceInternal::Direct::handleException() const
+{
+    //
+    // Translate the exception as it would be by the dispatch and
+    // unmarshaling of the reply of a regular collocated invocation.
+    //
+    const PropertiesPtr& properties = _instance->initializationData().properties;
+    try
+    {
+        throw;
+    }
+    catch(const RequestFailedException& ex)
+    {
+        RequestFailedException& rfe = const_cast<RequestFailedException&>(ex);
+        if(rfe.id.name.empty())
+        {
+            rfe.id = _current.id;
+        }
+        if(rfe.facet.empty() && !_current.facet.empty())
+        {
+            rfe.facet = _current.facet;
+        }
+        if(rfe.operation.empty() && !_current.operation.empty())
+        {
+            rfe.operation = _current.operation;
+        }
+        if(properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 1)
+        {
+            ostringstream os;
+            os << rfe;
+            warning(os.str());
+        }
+        throw;
+    }
+    catch(const UserException& ex)
+    {
+        throw UnknownUserException(__FILE__, __LINE__, ex.ice_id());
+    }
+    catch(const SystemException&)
+    {
+        throw;
+    }
+    catch(const Ice::Exception& ex)
+    {
+        ostringstream str;
+        str << ex;
+        if(properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 0)
+        {
+            warning(str.str());
+        }
+
+        if(dynamic_cast<const UnknownException*>(&ex))
+        {
+            throw;
+        }
+
+        if(IceUtilInternal::printStackTraces)
+        {
+            str << '\n' << ex.ice_stackTrace();
+        }
+        if(dynamic_cast<const LocalException*>(&ex))
+        {
+            throw UnknownLocalException(__FILE__, __LINE__, str.str());
+        }
+        throw UnknownException(__FILE__, __LINE__, str.str());
+    }
+    catch(const std::exception& ex)
+    {
+        string str = string("std::exception: ") + ex.what();
+        if(properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 0)
+        {
+            warning(str);
+        }
+        throw UnknownException(__FILE__, __LINE__, str);
+    }
+    catch(...)
+    {
+        if(properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 0)
+        {
+            warning("unknown c++ exception");
+        }
+        throw UnknownException(__FILE__, __LINE__, "unknown c++ exception");
+    }
+}
+
+void
+IceInternal::Direct::warning(const string& msg) const
+{
+    Warning out(_instance->initializationData().logger);
+    ToStringMode toStringMode = _instance->toStringMode();
+
+    out << "dispatch exception: " << msg;
+    out << "\nidentity: " << identityToString(_current.id, toStringMode);
+    out << "\nfacet: " << escapeString(_current.facet, "", toStringMode);
+    out << "\noperation: " << _current.operation;
+}
@@ -42,6 +42,17 @@ Ice::MarshaledResult::MarshaledResult(const Ice::Current& current) :
 }
 #endif
 
+int
+IceInternal::findOperation(const OperationTable& table, const string& operation)
+{
+    unsigned int h = IceUtilInternal::operationHash(operation, table.seed);
+    int displacement = table.displacements[IceUtilInternal::operationHashMix(h, 0) %
+                                           static_cast<unsigned int>(table.buckets)];
+    int index = table.slots[IceUtilInternal::operationHashMix(h, static_cast<unsigned int>(displacement)) %
+                            static_cast<unsigned int>(table.size)];
+    return table.names[index] == operation ? index : -1;
+}
+
 IceInternal::IncomingBase::IncomingBase(Instance* instance, ResponseHandler* responseHandler,
                                         Ice::Connection* connection, const ObjectAdapterPtr& adapter,
                                         bool response, Byte compress, Int requestId) :
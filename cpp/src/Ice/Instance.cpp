@@ -33,6 +33,7 @@
 #include <Ice/PropertiesI.h>
 #include <Ice/Communicator.h>
 #include <Ice/InstrumentationI.h>
+#include <Ice/MetricsHttpServer.h>
 #include <Ice/ProtocolInstance.h>
 #include <Ice/LoggerAdminI.h>
 #include <Ice/RegisterPluginsInit.h>
@@ -206,6 +207,18 @@ public:
     {
     }
 
+    Timer(const IceUtil::Time& resolution, int priority) :
+        IceUtil::Timer(resolution, priority),
+        _hasObserver(0)
+    {
+    }
+
+    Timer(const IceUtil::Time& resolution) :
+        IceUtil::Timer(resolution),
+        _hasObserver(0)
+    {
+    }
+
     void updateObserver(const Ice::Instrumentation::CommunicatorObserverPtr&);
 
 private:
@@ -1128,17 +1141,30 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
                 {
                     sz = 0;
                 }
+                if(_initData.properties->getPropertyAsInt("Ice.LogAsync") > 0)
+                {
+                    _loggerQueue = new LoggerQueue(_initData.properties);
+                }
                 _initData.logger = ICE_MAKE_SHARED(LoggerI, _initData.properties->getProperty("Ice.ProgramName"),
-                                                   logfile, true, static_cast<size_t>(sz));
+                                                   logfile, true, static_cast<size_t>(sz), _loggerQueue);
             }
             else
             {
                 _initData.logger = getProcessLogger();
                 if(ICE_DYNAMIC_CAST(LoggerI, _initData.logger))
                 {
-                    _initData.logger = ICE_MAKE_SHARED(LoggerI, _initData.properties->getProperty("Ice.ProgramName"), "", logStdErrConvert);
+                    if(_initData.properties->getPropertyAsInt("Ice.LogAsync") > 0)
+                    {
+                        _loggerQueue = new LoggerQueue(_initData.properties);
+                    }
+                    _initData.logger = ICE_MAKE_SHARED(LoggerI, _initData.properties->getProperty("Ice.ProgramName"), "", logStdErrConvert, 0, _loggerQueue);
                 }
             }
+
+            if(_loggerQueue)
+            {
+                _loggerQueue->start();
+            }
         }
 
         const_cast<TraceLevelsPtr&>(_traceLevels) = new TraceLevels(_initData.properties);
@@ -1445,6 +1471,25 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
         }
     }
 
+#ifndef ICE_OS_UWP
+    //
+    // Start the OpenMetrics HTTP server if enabled. The metrics are
+    // collected even if the Ice.Admin Metrics facet isn't enabled.
+    //
+    if(_initData.properties->getPropertyAsInt("IceMX.Http.Port") > 0)
+    {
+        CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI, _initData.observer);
+        if(!observer)
+        {
+            observer = ICE_MAKE_SHARED(CommunicatorObserverI, _initData);
+            _initData.observer = observer;
+        }
+        _metricsHttpServer = new MetricsHttpServer(_initData.properties, _initData.logger, observer->getFacet(),
+                                                   _protocolSupport, _preferIPv6);
+        _metricsHttpServer->start();
+    }
+#endif
+
     //
     // Set observer updater
     //
@@ -1460,7 +1505,25 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
     {
         bool hasPriority = _initData.properties->getProperty("Ice.ThreadPriority") != "";
         int priority = _initData.properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
+
+        //
+        // If a resolution is set, the timer uses a timing wheel which provides
+        // constant time scheduling and cancellation of the tasks. This is useful
+        // with many invocation timeouts or connections.
+        //
+        int resolution = _initData.properties->getPropertyAsInt("Ice.TimerWheelResolution");
+        if(resolution > 0)
+        {
+            if(hasPriority)
+            {
+                _timer = new Timer(IceUtil::Time::milliSeconds(resolution), priority);
+            }
+            else
+            {
+                _timer = new Timer(IceUtil::Time::milliSeconds(resolution));
+            }
+        }
+        else if(hasPriority)
         {
             _timer = new Timer(priority);
         }
@@ -1631,6 +1694,14 @@ IceInternal::Instance::destroy()
         _retryQueue->destroy(); // Must be called before destroying thread pools.
     }
 
+#ifndef ICE_OS_UWP
+    if(_metricsHttpServer)
+    {
+        _metricsHttpServer->destroy();
+        _metricsHttpServer->getThreadControl().join();
+    }
+#endif
+
     if(_initData.observer)
     {
         CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI, _initData.observer);
@@ -1738,6 +1809,16 @@ IceInternal::Instance::destroy()
         _pluginManager->destroy();
     }
 
+    //
+    // Write the queued log messages, the logger writes messages
+    // synchronously once the queue is destroyed.
+    //
+    if(_loggerQueue)
+    {
+        _loggerQueue->destroy();
+        _loggerQueue->getThreadControl().join();
+    }
+
     {
         Lock sync(*this);
 
@@ -1749,6 +1830,8 @@ IceInternal::Instance::destroy()
         _clientThreadPool = 0;
         _endpointHostResolver = 0;
         _timer = 0;
+        _metricsHttpServer = 0;
+        _loggerQueue = 0;
 
         _referenceFactory = 0;
         _requestHandlerFactory = 0;
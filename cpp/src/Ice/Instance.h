@@ -57,6 +57,12 @@ ICE_DEFINE_PTR(MetricsAdminIPtr, MetricsAdminI);
 class RequestHandlerFactory;
 typedef IceUtil::Handle<RequestHandlerFactory> RequestHandlerFactoryPtr;
 
+class MetricsHttpServer;
+typedef IceUtil::Handle<MetricsHttpServer> MetricsHttpServerPtr;
+
+class LoggerQueue;
+typedef IceUtil::Handle<LoggerQueue> LoggerQueuePtr;
+
 //
 // Structure to track warnings for attempts to set socket buffer sizes
 //
@@ -206,6 +212,8 @@ private:
     Ice::Identity _adminIdentity;
     std::set<std::string> _adminFacetFilter;
     IceInternal::MetricsAdminIPtr _metricsAdmin;
+    MetricsHttpServerPtr _metricsHttpServer;
+    LoggerQueuePtr _loggerQueue;
     std::map<Ice::Short, BufSizeWarnInfo> _setBufSizeWarn;
     IceUtil::Mutex _setBufSizeWarnMutex;
     ObjectFactoryMap _objectFactoryMap;
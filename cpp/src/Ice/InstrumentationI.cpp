@@ -6,10 +6,12 @@
 
 #include <Ice/Connection.h>
 #include <Ice/Endpoint.h>
-#include <Ice/ObjectAdapter.h>
+#include <Ice/ObjectAdapterI.h>
 #include <Ice/LocalException.h>
 #include <Ice/Communicator.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/Reference.h>
+#include <Ice/Instance.h>
 
 using namespace std;
 using namespace Ice;
@@ -67,6 +69,51 @@ struct ThreadStateChanged
     ThreadState newState;
 };
 
+struct ACMSwept
+{
+    ACMSwept(Int monitoredP, Int parkedP, Int connectionsP, Int bucketsP) :
+        monitored(monitoredP), parked(parkedP), connections(connectionsP), buckets(bucketsP)
+    {
+    }
+
+    void operator()(const ACMMetricsPtr& v)
+    {
+        v->monitored += monitored;
+        v->parked += parked;
+        v->connections = connections;
+        v->buckets = buckets;
+    }
+
+    const Int monitored;
+    const Int parked;
+    const Int connections;
+    const Int buckets;
+};
+
+struct ThreadPoolWorkStealing
+{
+    ThreadPoolWorkStealing(Int queuedP, Int stolenP, Int queueDepthP, Int maxQueueDepthP) :
+        queued(queuedP), stolen(stolenP), queueDepth(queueDepthP), maxQueueDepth(maxQueueDepthP)
+    {
+    }
+
+    void operator()(const ThreadPoolMetricsPtr& v)
+    {
+        v->queued += queued;
+        v->stolen += stolen;
+        v->queueDepth = queueDepth;
+        if(maxQueueDepth > v->maxQueueDepth)
+        {
+            v->maxQueueDepth = maxQueueDepth;
+        }
+    }
+
+    const Int queued;
+    const Int stolen;
+    const Int queueDepth;
+    const Int maxQueueDepth;
+};
+
 IPConnectionInfo*
 getIPConnectionInfo(const ConnectionInfoPtr& info)
 {
@@ -223,6 +270,7 @@ public:
             add("facet", &DispatchHelper::getCurrent, &Current::facet);
             add("mode", &DispatchHelper::getMode);
             add("requestId", &DispatchHelper::getCurrent, &Current::requestId);
+            add("lane", &DispatchHelper::getLane);
 
             setDefault(&DispatchHelper::resolve);
         }
@@ -262,6 +310,13 @@ public:
         return _current.requestId == 0 ? "oneway" : "twoway";
     }
 
+    string
+    getLane() const
+    {
+        ObjectAdapterI* adapter = dynamic_cast<ObjectAdapterI*>(_current.adapter.get());
+        return adapter && adapter->isHighPriority(_current.operation, _current.ctx) ? "high" : "normal";
+    }
+
     const string&
     getId() const
     {
@@ -766,6 +821,147 @@ private:
 
 EndpointHelper::Attributes EndpointHelper::attributes;
 
+class ACMHelper : public MetricsHelperT<ACMMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<ACMHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &ACMHelper::getParent);
+            add("id", &ACMHelper::_id);
+        }
+    };
+    static Attributes attributes;
+
+    ACMHelper(const string& id) : _id(id)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+private:
+
+    const string _id;
+};
+
+ACMHelper::Attributes ACMHelper::attributes;
+
+class LocatorCacheHelper : public MetricsHelperT<LocatorCacheMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<LocatorCacheHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &LocatorCacheHelper::getParent);
+            add("id", &LocatorCacheHelper::getId);
+            add("locator", &LocatorCacheHelper::getId);
+            add("adapterId", &LocatorCacheHelper::getAdapterId);
+            add("identity", &LocatorCacheHelper::getIdentity);
+        }
+    };
+    static Attributes attributes;
+
+    LocatorCacheHelper(const LocatorPrxPtr& locator, const ReferencePtr& ref) : _locator(locator), _reference(ref)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+    const string&
+    getId() const
+    {
+        if(_id.empty())
+        {
+            _id = _locator->ice_toString();
+        }
+        return _id;
+    }
+
+    string
+    getAdapterId() const
+    {
+        return _reference->getAdapterId();
+    }
+
+    string
+    getIdentity() const
+    {
+        return identityToString(_reference->getIdentity(), _reference->getInstance()->toStringMode());
+    }
+
+private:
+
+    const LocatorPrxPtr& _locator;
+    const ReferencePtr& _reference;
+    mutable string _id;
+};
+
+LocatorCacheHelper::Attributes LocatorCacheHelper::attributes;
+
+class ThreadPoolHelper : public MetricsHelperT<ThreadPoolMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<ThreadPoolHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &ThreadPoolHelper::getParent);
+            add("id", &ThreadPoolHelper::_id);
+        }
+    };
+    static Attributes attributes;
+
+    ThreadPoolHelper(const string& id) : _id(id)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+private:
+
+    const string _id;
+};
+
+ThreadPoolHelper::Attributes ThreadPoolHelper::attributes;
+
 }
 
 void
@@ -799,6 +995,42 @@ ThreadObserverI::stateChanged(ThreadState oldState, ThreadState newState)
 
 }
 
+void
+ACMObserverI::swept(Int monitored, Int parked, Int connections, Int buckets)
+{
+    forEach(ACMSwept(monitored, parked, connections, buckets));
+}
+
+void
+LocatorCacheObserverI::hit()
+{
+    forEach(inc(&LocatorCacheMetrics::hits));
+}
+
+void
+LocatorCacheObserverI::miss()
+{
+    forEach(inc(&LocatorCacheMetrics::misses));
+}
+
+void
+LocatorCacheObserverI::negativeHit()
+{
+    forEach(inc(&LocatorCacheMetrics::negativeHits));
+}
+
+void
+LocatorCacheObserverI::refresh()
+{
+    forEach(inc(&LocatorCacheMetrics::refreshes));
+}
+
+void
+ThreadPoolObserverI::workStealing(Int queued, Int stolen, Int queueDepth, Int maxQueueDepth)
+{
+    forEach(ThreadPoolWorkStealing(queued, stolen, queueDepth, maxQueueDepth));
+}
+
 void
 DispatchObserverI::userException()
 {
@@ -910,7 +1142,10 @@ CommunicatorObserverI::CommunicatorObserverI(const InitializationData& initData)
     _invocations(_metrics, "Invocation"),
     _threads(_metrics, "Thread"),
     _connects(_metrics, "ConnectionEstablishment"),
-    _endpointLookups(_metrics, "EndpointLookup")
+    _endpointLookups(_metrics, "EndpointLookup"),
+    _acm(_metrics, "ACM"),
+    _locatorCache(_metrics, "LocatorCache"),
+    _threadPools(_metrics, "ThreadPool")
 {
     _invocations.registerSubMap<RemoteMetrics>("Remote", &InvocationMetrics::remotes);
     _invocations.registerSubMap<CollocatedMetrics>("Collocated", &InvocationMetrics::collocated);
@@ -1073,6 +1308,60 @@ CommunicatorObserverI::getDispatchObserver(const Current& current, int size)
     return ICE_NULLPTR;
 }
 
+ACMObserverIPtr
+CommunicatorObserverI::getACMObserver(const string& id)
+{
+    if(_acm.isEnabled())
+    {
+        try
+        {
+            return _acm.getObserver(ACMHelper(id));
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return ICE_NULLPTR;
+}
+
+LocatorCacheObserverIPtr
+CommunicatorObserverI::getLocatorCacheObserver(const LocatorPrxPtr& locator, const ReferencePtr& ref)
+{
+    if(_locatorCache.isEnabled())
+    {
+        try
+        {
+            return _locatorCache.getObserver(LocatorCacheHelper(locator, ref));
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return ICE_NULLPTR;
+}
+
+ThreadPoolObserverIPtr
+CommunicatorObserverI::getThreadPoolObserver(const string& id)
+{
+    if(_threadPools.isEnabled())
+    {
+        try
+        {
+            return _threadPools.getObserver(ThreadPoolHelper(id));
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return ICE_NULLPTR;
+}
+
 const IceInternal::MetricsAdminIPtr&
 CommunicatorObserverI::getFacet() const
 {
@@ -1089,6 +1378,9 @@ CommunicatorObserverI::destroy()
     _threads.destroy();
     _connects.destroy();
     _endpointLookups.destroy();
+    _acm.destroy();
+    _locatorCache.destroy();
+    _threadPools.destroy();
 
     _metrics->destroy();
 }
@@ -7,6 +7,7 @@
 
 #include <Ice/MetricsObserverI.h>
 #include <Ice/Connection.h>
+#include <Ice/ReferenceF.h>
 
 namespace IceInternal
 {
@@ -204,6 +205,38 @@ public:
 
 typedef ObserverWithDelegateT<IceMX::Metrics, Ice::Instrumentation::Observer> ObserverI;
 
+//
+// The connection monitor sweeps and the locator cache lookups are
+// internal to the Ice run time, they are only observed by the metrics
+// and don't have a delegate.
+//
+class ACMObserverI : public IceMX::ObserverT<IceMX::ACMMetrics>
+{
+public:
+
+    void swept(Ice::Int, Ice::Int, Ice::Int, Ice::Int);
+};
+ICE_DEFINE_PTR(ACMObserverIPtr, ACMObserverI);
+
+class LocatorCacheObserverI : public IceMX::ObserverT<IceMX::LocatorCacheMetrics>
+{
+public:
+
+    void hit();
+    void miss();
+    void negativeHit();
+    void refresh();
+};
+ICE_DEFINE_PTR(LocatorCacheObserverIPtr, LocatorCacheObserverI);
+
+class ThreadPoolObserverI : public IceMX::ObserverT<IceMX::ThreadPoolMetrics>
+{
+public:
+
+    void workStealing(Ice::Int, Ice::Int, Ice::Int, Ice::Int);
+};
+ICE_DEFINE_PTR(ThreadPoolObserverIPtr, ThreadPoolObserverI);
+
 class ICE_API CommunicatorObserverI : public Ice::Instrumentation::CommunicatorObserver
 {
 public:
@@ -233,6 +266,11 @@ public:
 
     virtual Ice::Instrumentation::DispatchObserverPtr getDispatchObserver(const Ice::Current&, Ice::Int);
 
+    ACMObserverIPtr getACMObserver(const std::string&);
+    LocatorCacheObserverIPtr getLocatorCacheObserver(const Ice::LocatorPrxPtr&, const ReferencePtr&);
+
+    ThreadPoolObserverIPtr getThreadPoolObserver(const std::string&);
+
     const IceInternal::MetricsAdminIPtr& getFacet() const;
 
     void destroy();
@@ -248,6 +286,9 @@ private:
     ObserverFactoryWithDelegateT<ThreadObserverI> _threads;
     ObserverFactoryWithDelegateT<ObserverI> _connects;
     ObserverFactoryWithDelegateT<ObserverI> _endpointLookups;
+    IceMX::ObserverFactoryT<ACMObserverI> _acm;
+    IceMX::ObserverFactoryT<LocatorCacheObserverI> _locatorCache;
+    IceMX::ObserverFactoryT<ThreadPoolObserverI> _threadPools;
 };
 ICE_DEFINE_PTR(CommunicatorObserverIPtr, CommunicatorObserverI);
 
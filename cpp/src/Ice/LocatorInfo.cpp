@@ -14,6 +14,8 @@
 #include <Ice/Functional.h>
 #include <Ice/Properties.h>
 #include <Ice/Comparable.h>
+#include <Ice/InstrumentationI.h>
+#include <Ice/ObserverHelper.h>
 #include <iterator>
 
 using namespace std;
@@ -124,6 +126,8 @@ public:
 
 IceInternal::LocatorManager::LocatorManager(const Ice::PropertiesPtr& properties) :
     _background(properties->getPropertyAsInt("Ice.BackgroundLocatorCacheUpdates") > 0),
+    _refreshThreshold(properties->getPropertyAsInt("Ice.LocatorCacheRefreshThreshold")),
+    _negativeTimeout(properties->getPropertyAsInt("Ice.LocatorCacheNegativeTimeout")),
     _tableHint(_table.end())
 {
 }
@@ -188,7 +192,7 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
         {
             t = _locatorTables.insert(_locatorTables.begin(),
                                       pair<const pair<Identity, EncodingVersion>, LocatorTablePtr>(
-                                          locatorKey, new LocatorTable()));
+                                          locatorKey, new LocatorTable(_refreshThreshold, _negativeTimeout)));
         }
 
         _tableHint = _table.insert(_tableHint,
@@ -204,7 +208,13 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
     return _tableHint->second;
 }
 
-IceInternal::LocatorTable::LocatorTable()
+IceInternal::LocatorTable::LocatorTable(int refreshThreshold, int negativeTimeout) :
+    //
+    // The refresh threshold is a percentage of the locator cache
+    // timeout, values outside the ]0, 100[ range disable refreshes.
+    //
+    _refreshThreshold(refreshThreshold > 0 && refreshThreshold < 100 ? refreshThreshold : 0),
+    _negativeTimeout(negativeTimeout > 0 ? negativeTimeout : 0)
 {
 }
 
@@ -215,10 +225,13 @@ IceInternal::LocatorTable::clear()
 
      _adapterEndpointsMap.clear();
      _objectMap.clear();
+     _adapterNotFoundMap.clear();
+     _objectNotFoundMap.clear();
 }
 
 bool
-IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints)
+IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints,
+                                               bool& refresh)
 {
     if(ttl == 0) // No locator cache.
     {
@@ -232,7 +245,11 @@ IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, v
     if(p != _adapterEndpointsMap.end())
     {
         endpoints = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        if(checkTTL(p->second.first, ttl))
+        {
+            refresh = checkRefresh(p->second.first, ttl);
+            return true;
+        }
     }
     return false;
 }
@@ -253,6 +270,7 @@ IceInternal::LocatorTable::addAdapterEndpoints(const string& adapter, const vect
         _adapterEndpointsMap.insert(
             make_pair(adapter, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints)));
     }
+    _adapterNotFoundMap.erase(adapter);
 }
 
 vector<EndpointIPtr>
@@ -274,7 +292,7 @@ IceInternal::LocatorTable::removeAdapterEndpoints(const string& adapter)
 }
 
 bool
-IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref)
+IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref, bool& refresh)
 {
     if(ttl == 0) // No locator cache
     {
@@ -288,7 +306,11 @@ IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, Refer
     if(p != _objectMap.end())
     {
         ref = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        if(checkTTL(p->second.first, ttl))
+        {
+            refresh = checkRefresh(p->second.first, ttl);
+            return true;
+        }
     }
     return false;
 }
@@ -308,6 +330,7 @@ IceInternal::LocatorTable::addObjectReference(const Identity& id, const Referenc
     {
         _objectMap.insert(make_pair(id, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref)));
     }
+    _objectNotFoundMap.erase(id);
 }
 
 ReferencePtr
@@ -326,6 +349,76 @@ IceInternal::LocatorTable::removeObjectReference(const Identity& id)
     return ref;
 }
 
+bool
+IceInternal::LocatorTable::isAdapterNotFound(const string& adapter, int ttl)
+{
+    if(ttl == 0 || _negativeTimeout == 0) // No locator cache or no negative caching.
+    {
+        return false;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+
+    map<string, IceUtil::Time>::iterator p = _adapterNotFoundMap.find(adapter);
+    if(p == _adapterNotFoundMap.end())
+    {
+        return false;
+    }
+    else if(!checkNegativeTTL(p->second, ttl))
+    {
+        _adapterNotFoundMap.erase(p);
+        return false;
+    }
+    return true;
+}
+
+void
+IceInternal::LocatorTable::addAdapterNotFound(const string& adapter)
+{
+    if(_negativeTimeout == 0)
+    {
+        return;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+    _adapterNotFoundMap[adapter] = IceUtil::Time::now(IceUtil::Time::Monotonic);
+}
+
+bool
+IceInternal::LocatorTable::isObjectNotFound(const Identity& id, int ttl)
+{
+    if(ttl == 0 || _negativeTimeout == 0) // No locator cache or no negative caching.
+    {
+        return false;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+
+    map<Identity, IceUtil::Time>::iterator p = _objectNotFoundMap.find(id);
+    if(p == _objectNotFoundMap.end())
+    {
+        return false;
+    }
+    else if(!checkNegativeTTL(p->second, ttl))
+    {
+        _objectNotFoundMap.erase(p);
+        return false;
+    }
+    return true;
+}
+
+void
+IceInternal::LocatorTable::addObjectNotFound(const Identity& id)
+{
+    if(_negativeTimeout == 0)
+    {
+        return;
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+    _objectNotFoundMap[id] = IceUtil::Time::now(IceUtil::Time::Monotonic);
+}
+
 bool
 IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
 {
@@ -340,6 +433,31 @@ IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
     }
 }
 
+bool
+IceInternal::LocatorTable::checkRefresh(const IceUtil::Time& time, int ttl) const
+{
+    if(ttl < 0 || _refreshThreshold == 0) // TTL = infinite or refresh disabled
+    {
+        return false;
+    }
+    else
+    {
+        IceUtil::Time threshold = IceUtil::Time::milliSeconds(static_cast<IceUtil::Int64>(ttl) * 10 * _refreshThreshold);
+        return IceUtil::Time::now(IceUtil::Time::Monotonic) - time > threshold;
+    }
+}
+
+bool
+IceInternal::LocatorTable::checkNegativeTTL(const IceUtil::Time& time, int ttl) const
+{
+    //
+    // Negative entries never outlive the locator cache timeout of the
+    // proxy.
+    //
+    int timeout = ttl > 0 && ttl < _negativeTimeout ? ttl : _negativeTimeout;
+    return IceUtil::Time::now(IceUtil::Time::Monotonic) - time <= IceUtil::Time::seconds(timeout);
+}
+
 void
 IceInternal::LocatorInfo::RequestCallback::response(const LocatorInfoPtr& locatorInfo, const Ice::ObjectPrxPtr& proxy)
 {
@@ -486,7 +604,11 @@ IceInternal::LocatorInfo::Request::exception(const Ice::Exception& ex)
 IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background) :
     _locator(locator),
     _table(table),
-    _background(background)
+    _background(background),
+    _cacheHits(0),
+    _cacheMisses(0),
+    _cacheRefreshes(0),
+    _cacheNegativeHits(0)
 {
     assert(_locator);
     assert(_table);
@@ -553,14 +675,42 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref,
                                        const GetEndpointsCallbackPtr& callback)
 {
     assert(ref->isIndirect());
+
+    //
+    // The lookup is observed by the locator cache metrics.
+    //
+    ObserverHelperT<LocatorCacheObserverI> observer;
+    CommunicatorObserverI* communicatorObserver =
+        dynamic_cast<CommunicatorObserverI*>(ref->getInstance()->initializationData().observer.get());
+    if(communicatorObserver)
+    {
+        observer.attach(communicatorObserver->getLocatorCacheObserver(_locator, ref));
+    }
+
     vector<EndpointIPtr> endpoints;
+    bool refresh = false;
     if(!ref->isWellKnown())
     {
-        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints))
+        if(_table->isAdapterNotFound(ref->getAdapterId(), ttl))
         {
+            if(observer)
+            {
+                observer->negativeHit();
+            }
+            getEndpointsNotFound(ref, wellKnownRef, callback);
+            return;
+        }
+
+        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints, refresh))
+        {
+            _cacheMisses.fetch_add(1);
+            if(observer)
+            {
+                observer->miss();
+            }
             if(_background && !endpoints.empty())
             {
-                getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
+                refresh = true;
             }
             else
             {
@@ -568,15 +718,56 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref,
                 return;
             }
         }
+        else
+        {
+            _cacheHits.fetch_add(1);
+            if(observer)
+            {
+                observer->hit();
+            }
+        }
+
+        //
+        // Update the cached endpoints in the background if they are
+        // about to expire or if they expired and background updates
+        // are enabled. The cached endpoints are used meanwhile.
+        //
+        if(refresh)
+        {
+            RequestPtr request = getAdapterRequest(ref, true);
+            if(request)
+            {
+                if(observer)
+                {
+                    observer->refresh();
+                }
+                request->addCallback(ref, wellKnownRef, ttl, 0);
+            }
+        }
     }
     else
     {
+        if(_table->isObjectNotFound(ref->getIdentity(), ttl))
+        {
+            if(observer)
+            {
+                observer->negativeHit();
+            }
+            getEndpointsNotFound(ref, 0, callback);
+            return;
+        }
+
         ReferencePtr r;
-        if(!_table->getObjectReference(ref->getIdentity(), ttl, r))
+        if(!_table->getObjectReference(ref->getIdentity(), ttl, r, refresh))
         {
+            _cacheMisses.fetch_add(1);
+            if(observer)
+            {
+                observer->miss();
+            }
             if(_background && r)
             {
-                getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
+                refresh = true;
             }
             else
             {
@@ -584,6 +775,27 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref,
                 return;
             }
         }
+        else
+        {
+            _cacheHits.fetch_add(1);
+            if(observer)
+            {
+                observer->hit();
+            }
+        }
+
+        if(refresh)
+        {
+            RequestPtr request = getObjectRequest(ref, true);
+            if(request)
+            {
+                if(observer)
+                {
+                    observer->refresh();
+                }
+                request->addCallback(ref, 0, ttl, 0);
+            }
+        }
 
         if(!r->isIndirect())
         {
@@ -708,6 +920,53 @@ IceInternal::LocatorInfo::getEndpointsException(const ReferencePtr& ref, const I
     }
 }
 
+void
+IceInternal::LocatorInfo::getEndpointsNotFound(const ReferencePtr& ref,
+                                               const ReferencePtr& wellKnownRef,
+                                               const GetEndpointsCallbackPtr& callback)
+{
+    _cacheNegativeHits.fetch_add(1);
+
+    if(wellKnownRef)
+    {
+        //
+        // The cached adapter of the well-known object isn't registered,
+        // remove the well-known object reference from the cache as if
+        // the adapter had been looked up from the locator.
+        //
+        _table->removeObjectReference(wellKnownRef->getIdentity());
+    }
+
+    if(ref->getInstance()->traceLevels()->location >= 1)
+    {
+        Trace out(ref->getInstance()->initializationData().logger, ref->getInstance()->traceLevels()->locationCat);
+        if(!ref->isWellKnown())
+        {
+            out << "adapter not found in locator cache\n";
+            out << "adapter = " << ref->getAdapterId();
+        }
+        else
+        {
+            out << "object not found in locator cache\n";
+            out << "object = " << Ice::identityToString(ref->getIdentity(), ref->getInstance()->toStringMode());
+        }
+    }
+
+    if(callback)
+    {
+        if(!ref->isWellKnown())
+        {
+            callback->setException(NotRegisteredException(__FILE__, __LINE__, "object adapter", ref->getAdapterId()));
+        }
+        else
+        {
+            callback->setException(
+                NotRegisteredException(__FILE__, __LINE__, "object",
+                                       Ice::identityToString(ref->getIdentity(), ref->getInstance()->toStringMode())));
+        }
+    }
+}
+
 void
 IceInternal::LocatorInfo::getEndpointsTrace(const ReferencePtr& ref,
                                             const vector<EndpointIPtr>& endpoints,
@@ -798,46 +1057,86 @@ IceInternal::LocatorInfo::trace(const string& msg, const ReferencePtr& ref, cons
 }
 
 IceInternal::LocatorInfo::RequestPtr
-IceInternal::LocatorInfo::getAdapterRequest(const ReferencePtr& ref)
+IceInternal::LocatorInfo::getAdapterRequest(const ReferencePtr& ref, bool refresh)
 {
     IceUtil::Mutex::Lock sync(*this);
+    map<string, RequestPtr>::const_iterator p = _adapterRequests.find(ref->getAdapterId());
+    if(p != _adapterRequests.end() && refresh)
+    {
+        return 0; // Already being refreshed.
+    }
+
     if(ref->getInstance()->traceLevels()->location >= 1)
     {
         Trace out(ref->getInstance()->initializationData().logger, ref->getInstance()->traceLevels()->locationCat);
-        out << "searching for adapter by id\nadapter = " << ref->getAdapterId();
+        out << (refresh ? "refreshing" : "searching for") << " adapter by id\nadapter = " << ref->getAdapterId();
     }
 
-    map<string, RequestPtr>::const_iterator p = _adapterRequests.find(ref->getAdapterId());
     if(p != _adapterRequests.end())
     {
         return p->second;
     }
 
+    if(refresh)
+    {
+        _cacheRefreshes.fetch_add(1);
+    }
+    if(ref->getInstance()->traceLevels()->location >= 2)
+    {
+        traceCacheStats(ref);
+    }
+
     RequestPtr request = new AdapterRequest(this, ref);
     _adapterRequests.insert(make_pair(ref->getAdapterId(), request));
     return request;
 }
 
 IceInternal::LocatorInfo::RequestPtr
-IceInternal::LocatorInfo::getObjectRequest(const ReferencePtr& ref)
+IceInternal::LocatorInfo::getObjectRequest(const ReferencePtr& ref, bool refresh)
 {
     IceUtil::Mutex::Lock sync(*this);
+    map<Ice::Identity, RequestPtr>::const_iterator p = _objectRequests.find(ref->getIdentity());
+    if(p != _objectRequests.end() && refresh)
+    {
+        return 0; // Already being refreshed.
+    }
+
     if(ref->getInstance()->traceLevels()->location >= 1)
     {
         Trace out(ref->getInstance()->initializationData().logger, ref->getInstance()->traceLevels()->locationCat);
-        out << "searching for well-known object\nwell-known proxy = " << ref->toString();
+        out << (refresh ? "refreshing" : "searching for") << " well-known object\nwell-known proxy = "
+            << ref->toString();
     }
 
-    map<Ice::Identity, RequestPtr>::const_iterator p = _objectRequests.find(ref->getIdentity());
     if(p != _objectRequests.end())
     {
         return p->second;
     }
+
+    if(refresh)
+    {
+        _cacheRefreshes.fetch_add(1);
+    }
+    if(ref->getInstance()->traceLevels()->location >= 2)
+    {
+        traceCacheStats(ref);
+    }
+
     RequestPtr request = new ObjectRequest(this, ref);
     _objectRequests.insert(make_pair(ref->getIdentity(), request));
     return request;
 }
 
+void
+IceInternal::LocatorInfo::traceCacheStats(const ReferencePtr& ref)
+{
+    Trace out(ref->getInstance()->initializationData().logger, ref->getInstance()->traceLevels()->locationCat);
+    out << "locator cache statistics\n";
+    out << "locator = " << _locator->ice_toString() << '\n';
+    out << "hits = " << _cacheHits.load() << ", misses = " << _cacheMisses.load();
+    out << ", refreshes = " << _cacheRefreshes.load() << ", negative hits = " << _cacheNegativeHits.load();
+}
+
 void
 IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
                                         const vector<ReferencePtr>& wellKnownRefs,
@@ -865,6 +1164,7 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
         else if(notRegistered) // If the adapter isn't registered anymore, remove it from the cache.
         {
             _table->removeAdapterEndpoints(ref->getAdapterId());
+            _table->addAdapterNotFound(ref->getAdapterId());
         }
 
         IceUtil::Mutex::Lock sync(*this);
@@ -880,6 +1180,7 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
         else if(notRegistered) // If the well-known object isn't registered anymore, remove it from the cache.
         {
             _table->removeObjectReference(ref->getIdentity());
+            _table->addObjectNotFound(ref->getIdentity());
         }
 
         IceUtil::Mutex::Lock sync(*this);
@@ -16,6 +16,7 @@
 #include <Ice/EndpointIF.h>
 #include <Ice/PropertiesF.h>
 #include <Ice/Version.h>
+#include <IceUtil/Atomic.h>
 
 #include <Ice/UniquePtr.h>
 
@@ -39,6 +40,8 @@ public:
 private:
 
     const bool _background;
+    const int _refreshThreshold;
+    const int _negativeTimeout;
 
 #ifdef ICE_CPP11_MAPPING
     using LocatorInfoTable = std::map<std::shared_ptr<Ice::LocatorPrx>,
@@ -57,24 +60,47 @@ class LocatorTable : public IceUtil::Shared, public IceUtil::Mutex
 {
 public:
 
-    LocatorTable();
+    LocatorTable(int, int);
 
     void clear();
 
-    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&);
+    //
+    // The refresh parameter is set to true if the cached entry is
+    // still valid but close enough to expiration to be refreshed in
+    // the background.
+    //
+    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&, bool&);
     void addAdapterEndpoints(const std::string&, const ::std::vector<EndpointIPtr>&);
     ::std::vector<EndpointIPtr> removeAdapterEndpoints(const std::string&);
 
-    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&);
+    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&, bool&);
     void addObjectReference(const Ice::Identity&, const ReferencePtr&);
     ReferencePtr removeObjectReference(const Ice::Identity&);
 
+    //
+    // Negative entries record adapters and well-known objects which
+    // the locator reported as not registered.
+    //
+    bool isAdapterNotFound(const std::string&, int);
+    void addAdapterNotFound(const std::string&);
+
+    bool isObjectNotFound(const Ice::Identity&, int);
+    void addObjectNotFound(const Ice::Identity&);
+
 private:
 
     bool checkTTL(const IceUtil::Time&, int) const;
+    bool checkRefresh(const IceUtil::Time&, int) const;
+    bool checkNegativeTTL(const IceUtil::Time&, int) const;
+
+    const int _refreshThreshold;
+    const int _negativeTimeout;
 
     std::map<std::string, std::pair<IceUtil::Time, std::vector<EndpointIPtr> > > _adapterEndpointsMap;
     std::map<Ice::Identity, std::pair<IceUtil::Time, ReferencePtr> > _objectMap;
+
+    std::map<std::string, IceUtil::Time> _adapterNotFoundMap;
+    std::map<Ice::Identity, IceUtil::Time> _objectNotFoundMap;
 };
 
 class LocatorInfo : public IceUtil::Shared, public IceUtil::Mutex
@@ -164,12 +190,14 @@ public:
 private:
 
     void getEndpointsException(const ReferencePtr&, const Ice::Exception&);
+    void getEndpointsNotFound(const ReferencePtr&, const ReferencePtr&, const GetEndpointsCallbackPtr&);
     void getEndpointsTrace(const ReferencePtr&, const std::vector<EndpointIPtr>&, bool);
     void trace(const std::string&, const ReferencePtr&, const std::vector<EndpointIPtr>&);
     void trace(const std::string&, const ReferencePtr&, const ReferencePtr&);
 
-    RequestPtr getAdapterRequest(const ReferencePtr&);
-    RequestPtr getObjectRequest(const ReferencePtr&);
+    RequestPtr getAdapterRequest(const ReferencePtr&, bool = false);
+    RequestPtr getObjectRequest(const ReferencePtr&, bool = false);
+    void traceCacheStats(const ReferencePtr&);
 
     void finishRequest(const ReferencePtr&, const std::vector<ReferencePtr>&, const Ice::ObjectPrxPtr&, bool);
     friend class Request;
@@ -180,6 +208,16 @@ private:
     const LocatorTablePtr _table;
     const bool _background;
 
+    //
+    // Locator cache statistics reported by the locator traces, with
+    // each locator request when Ice.Trace.Locator is 2 or more. The
+    // lookups are also counted by the IceMX LocatorCache metrics.
+    //
+    IceUtilInternal::Atomic _cacheHits;
+    IceUtilInternal::Atomic _cacheMisses;
+    IceUtilInternal::Atomic _cacheRefreshes;
+    IceUtilInternal::Atomic _cacheNegativeHits;
+
     std::map<std::string, RequestPtr> _adapterRequests;
     std::map<Ice::Identity, RequestPtr> _objectRequests;
 };
@@ -11,6 +11,7 @@
 #include <Ice/Connection.h>
 #include <Ice/LocalException.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/LoggerI.h>
 
 #include <set>
 
@@ -177,6 +178,14 @@ private:
     bool _destroyed;
     IceUtil::ThreadPtr _sendLogThread;
     std::deque<JobPtr> _jobQueue;
+
+    //
+    // The job queue is bounded with Ice.LogAsync.QueueSize when
+    // asynchronous logging is enabled, 0 otherwise.
+    //
+    size_t _queueSize;
+    IceInternal::LoggerQueue::OverflowPolicy _overflowPolicy;
+    Ice::Long _dropped;
 };
 ICE_DEFINE_PTR(LoggerAdminLoggerIPtr, LoggerAdminLoggerI);
 
@@ -684,8 +693,18 @@ LoggerAdminI::initCompleted(const AsyncResultPtr& r)
 LoggerAdminLoggerI::LoggerAdminLoggerI(const PropertiesPtr& props,
                                        const LoggerPtr& localLogger) :
     _loggerAdmin(new LoggerAdminI(props)),
-    _destroyed(false)
+    _destroyed(false),
+    _queueSize(0),
+    _overflowPolicy(IceInternal::LoggerQueue::DropNewest),
+    _dropped(0)
 {
+    if(props->getPropertyAsInt("Ice.LogAsync") > 0)
+    {
+        Int size = props->getPropertyAsIntWithDefault("Ice.LogAsync.QueueSize", 1024);
+        _queueSize = static_cast<size_t>(size > 0 ? size : 1);
+        _overflowPolicy = IceInternal::LoggerQueue::getOverflowPolicy(props);
+    }
+
     //
     // There is currently no way to have a null local logger
     //
@@ -772,6 +791,33 @@ LoggerAdminLoggerI::log(const LogMessage& logMessage)
             _sendLogThread->start();
         }
 
+        if(_queueSize > 0 && _jobQueue.size() >= _queueSize)
+        {
+            const bool droppable = logMessage.type == ICE_ENUM(LogMessageType, PrintMessage) ||
+                logMessage.type == ICE_ENUM(LogMessageType, TraceMessage);
+            if(droppable && _overflowPolicy == IceInternal::LoggerQueue::DropNewest)
+            {
+                ++_dropped;
+                return;
+            }
+            else if(droppable && _overflowPolicy == IceInternal::LoggerQueue::DropOldest)
+            {
+                _jobQueue.pop_front();
+                ++_dropped;
+            }
+            else
+            {
+                while(_jobQueue.size() >= _queueSize && !_destroyed)
+                {
+                    _monitor.wait();
+                }
+                if(_destroyed)
+                {
+                    return;
+                }
+            }
+        }
+
         _jobQueue.push_back(new Job(remoteLoggers, logMessage));
         _monitor.notifyAll();
     }
@@ -817,6 +863,7 @@ LoggerAdminLoggerI::run()
     CallbackPtr logCompletedCb = newCallback(this, &LoggerAdminLoggerI::logCompleted);
 #endif
 
+    std::deque<JobPtr> jobs;
     for(;;)
     {
         IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_monitor);
@@ -829,58 +876,74 @@ LoggerAdminLoggerI::run()
             break; // for(;;)
         }
 
+        //
+        // Send all the queued jobs in a batch.
+        //
         assert(!_jobQueue.empty());
-        JobPtr job = _jobQueue.front();
-        _jobQueue.pop_front();
+        jobs.swap(_jobQueue);
+        Ice::Long dropped = _dropped;
+        _dropped = 0;
+        _monitor.notifyAll(); // Wake up the loggers waiting for room in the queue.
         lock.release();
 
-        for(vector<RemoteLoggerPrxPtr>::const_iterator p = job->remoteLoggers.begin(); p != job->remoteLoggers.end(); ++p)
+        if(dropped > 0)
         {
-            if(_loggerAdmin->getTraceLevel() > 1)
-            {
-                Trace trace(_localLogger, traceCategory);
-                trace << "sending log message to `" << *p << "'";
-            }
+            Warning warning(_localLogger);
+            warning << dropped << " log message(s) not sent to remote loggers because the queue is full";
+        }
 
-            try
+        for(; !jobs.empty(); jobs.pop_front())
+        {
+            const JobPtr& job = jobs.front();
+            for(vector<RemoteLoggerPrxPtr>::const_iterator p = job->remoteLoggers.begin();
+                p != job->remoteLoggers.end(); ++p)
             {
+                if(_loggerAdmin->getTraceLevel() > 1)
+                {
+                    Trace trace(_localLogger, traceCategory);
+                    trace << "sending log message to `" << *p << "'";
+                }
+
+                try
+                {
 #ifdef ICE_CPP11_MAPPING
-                RemoteLoggerPrxPtr remoteLogger = *p;
-                auto self = shared_from_this();
-                remoteLogger->logAsync(job->logMessage,
-                    [self, remoteLogger]()
-                    {
-                        if(self->_loggerAdmin->getTraceLevel() > 1)
-                        {
-                            Trace trace(self->_localLogger, traceCategory);
-                            trace << "log on `" << remoteLogger << "' completed successfully";
-                        }
-                    },
-                    [self, remoteLogger](exception_ptr e)
-                    {
-                        try
+                    RemoteLoggerPrxPtr remoteLogger = *p;
+                    auto self = shared_from_this();
+                    remoteLogger->logAsync(job->logMessage,
+                        [self, remoteLogger]()
                         {
-                            rethrow_exception(e);
-                        }
-                        catch(const CommunicatorDestroyedException&)
+                            if(self->_loggerAdmin->getTraceLevel() > 1)
+                            {
+                                Trace trace(self->_localLogger, traceCategory);
+                                trace << "log on `" << remoteLogger << "' completed successfully";
+                            }
+                        },
+                        [self, remoteLogger](exception_ptr e)
                         {
-                            // expected if there are outstanding calls during communicator destruction
-                        }
-                        catch(const LocalException& ex)
-                        {
-                            self->_loggerAdmin->deadRemoteLogger(remoteLogger, self->_localLogger, ex, "log");
-                        }
-                    });
+                            try
+                            {
+                                rethrow_exception(e);
+                            }
+                            catch(const CommunicatorDestroyedException&)
+                            {
+                                // expected if there are outstanding calls during communicator destruction
+                            }
+                            catch(const LocalException& ex)
+                            {
+                                self->_loggerAdmin->deadRemoteLogger(remoteLogger, self->_localLogger, ex, "log");
+                            }
+                        });
 #else
-                //
-                // *p is a proxy associated with the _sendLogCommunicator
-                //
-                (*p)->begin_log(job->logMessage, logCompletedCb);
+                    //
+                    // *p is a proxy associated with the _sendLogCommunicator
+                    //
+                    (*p)->begin_log(job->logMessage, logCompletedCb);
 #endif
-            }
-            catch(const LocalException& ex)
-            {
-                _loggerAdmin->deadRemoteLogger(*p, _localLogger, ex, "log");
+                }
+                catch(const LocalException& ex)
+                {
+                    _loggerAdmin->deadRemoteLogger(*p, _localLogger, ex, "log");
+                }
             }
         }
     }
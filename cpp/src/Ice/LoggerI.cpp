@@ -9,6 +9,7 @@
 #include <IceUtil/MutexPtrLock.h>
 
 #include <Ice/LocalException.h>
+#include <Ice/Properties.h>
 #include <IceUtil/FileUtil.h>
 
 #ifdef __IBMCPP__
@@ -54,10 +55,11 @@ const IceUtil::Time retryTimeout = IceUtil::Time::seconds(5 * 60);
 }
 
 Ice::LoggerI::LoggerI(const string& prefix, const string& file,
-                      bool convert, size_t sizeMax) :
+                      bool convert, size_t sizeMax, const LoggerQueuePtr& queue) :
     _prefix(prefix),
     _convert(convert),
     _converter(getProcessStringConverter()),
+    _queue(queue),
     _sizeMax(sizeMax)
 {
     if(!prefix.empty())
@@ -83,6 +85,11 @@ Ice::LoggerI::LoggerI(const string& prefix, const string& file,
 
 Ice::LoggerI::~LoggerI()
 {
+    if(_queue)
+    {
+        _queue->flush(); // Wait for the queued messages of this logger to be written.
+    }
+
     if(_out.is_open())
     {
         _out.close();
@@ -92,7 +99,7 @@ Ice::LoggerI::~LoggerI()
 void
 Ice::LoggerI::print(const string& message)
 {
-    write(message, false);
+    write(message, false, true);
 }
 
 void
@@ -105,19 +112,19 @@ Ice::LoggerI::trace(const string& category, const string& message)
     }
     s += message;
 
-    write(s, true);
+    write(s, true, true);
 }
 
 void
 Ice::LoggerI::warning(const string& message)
 {
-    write("-! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "warning: " + message, true);
+    write("-! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "warning: " + message, true, false);
 }
 
 void
 Ice::LoggerI::error(const string& message)
 {
-    write("!! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "error: " + message, true);
+    write("!! " + IceUtil::Time::now().toDateTime() + " " + _formattedPrefix + "error: " + message, true, false);
 }
 
 string
@@ -130,11 +137,20 @@ LoggerPtr
 Ice::LoggerI::cloneWithPrefix(const std::string& prefix)
 {
     IceUtilInternal::MutexPtrLock<IceUtil::Mutex> sync(outputMutex); // for _sizeMax
-    return ICE_MAKE_SHARED(LoggerI, prefix, _file, _convert, _sizeMax);
+    return ICE_MAKE_SHARED(LoggerI, prefix, _file, _convert, _sizeMax, _queue);
 }
 
 void
-Ice::LoggerI::write(const string& message, bool indent)
+Ice::LoggerI::write(const string& message, bool indent, bool droppable)
+{
+    if(!_queue || !_queue->push(this, message, indent, droppable))
+    {
+        writeMessage(message, indent, true);
+    }
+}
+
+void
+Ice::LoggerI::writeMessage(const string& message, bool indent, bool flush)
 {
     IceUtilInternal::MutexPtrLock<IceUtil::Mutex> sync(outputMutex);
 
@@ -224,11 +240,15 @@ Ice::LoggerI::write(const string& message, bool indent)
                 {
                     sync.release();
                     error("FileLogger: cannot open `" + _file + "':\nlog messages will be sent to stderr");
-                    write(message, indent);
+                    writeMessage(message, indent, flush);
                     return;
                 }            }
         }
-        _out << s << endl;
+        _out << s << '\n';
+        if(flush)
+        {
+            _out.flush();
+        }
     }
     else
     {
@@ -255,7 +275,191 @@ Ice::LoggerI::write(const string& message, bool indent)
             consoleErr << s << endl;
         }
 #else
-        cerr << s << endl;
+        cerr << s << '\n';
+        if(flush)
+        {
+            cerr.flush();
+        }
 #endif
     }
 }
+
+IceInternal::LoggerQueue::OverflowPolicy
+IceInternal::LoggerQueue::getOverflowPolicy(const PropertiesPtr& properties)
+{
+    string policy = properties->getPropertyWithDefault("Ice.LogAsync.Overflow", "DropNewest");
+    if(policy == "DropNewest")
+    {
+        return DropNewest;
+    }
+    else if(policy == "DropOldest")
+    {
+        return DropOldest;
+    }
+    else if(policy == "Block")
+    {
+        return Block;
+    }
+    throw InitializationException(__FILE__, __LINE__, "invalid value for Ice.LogAsync.Overflow: `" + policy + "'");
+}
+
+IceInternal::LoggerQueue::LoggerQueue(const PropertiesPtr& properties) :
+    IceUtil::Thread("Ice.LoggerQueue"),
+    _policy(getOverflowPolicy(properties)),
+    _head(0),
+    _size(0),
+    _destroyed(false),
+    _pushed(0),
+    _done(0),
+    _dropped(0),
+    _droppedTotal(0)
+{
+    Int size = properties->getPropertyAsIntWithDefault("Ice.LogAsync.QueueSize", 1024);
+    _entries.resize(static_cast<size_t>(size > 0 ? size : 1));
+}
+
+bool
+IceInternal::LoggerQueue::push(LoggerI* logger, const string& message, bool indent, bool droppable)
+{
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        return false;
+    }
+
+    if(_size == _entries.size())
+    {
+        if(getThreadControl() == IceUtil::ThreadControl())
+        {
+            return false; // Called by the queue thread, the message is written synchronously.
+        }
+        else if(droppable && _policy == DropNewest)
+        {
+            ++_dropped;
+            return true;
+        }
+        else if(droppable && _policy == DropOldest)
+        {
+            _head = (_head + 1) % _entries.size();
+            --_size;
+            ++_done;
+            ++_dropped;
+        }
+        else
+        {
+            while(_size == _entries.size() && !_destroyed)
+            {
+                wait();
+            }
+            if(_destroyed)
+            {
+                return false;
+            }
+        }
+    }
+
+    //
+    // The message is copied in the entry string which keeps its
+    // capacity from previous messages.
+    //
+    Entry& entry = _entries[(_head + _size) % _entries.size()];
+    entry.logger = logger;
+    entry.message.assign(message);
+    entry.indent = indent;
+    ++_pushed;
+    if(++_size == 1)
+    {
+        notifyAll();
+    }
+    return true;
+}
+
+void
+IceInternal::LoggerQueue::flush()
+{
+    Lock sync(*this);
+    Ice::Long pushed = _pushed;
+    while(_done < pushed && isAlive())
+    {
+        wait();
+    }
+}
+
+void
+IceInternal::LoggerQueue::destroy()
+{
+    Lock sync(*this);
+    _destroyed = true;
+    notifyAll();
+}
+
+void
+IceInternal::LoggerQueue::run()
+{
+    vector<Entry> batch;
+    while(true)
+    {
+        Ice::Long dropped;
+        Ice::Long droppedTotal;
+        {
+            Lock sync(*this);
+            while(_size == 0 && !_destroyed)
+            {
+                wait();
+            }
+
+            if(_size == 0)
+            {
+                break; // Destroyed and all the messages are written.
+            }
+
+            //
+            // Swap the messages with the batch strings to avoid copies.
+            //
+            const bool full = _size == _entries.size();
+            batch.resize(_size);
+            for(size_t i = 0; i < _size; ++i)
+            {
+                Entry& entry = _entries[(_head + i) % _entries.size()];
+                batch[i].logger = entry.logger;
+                batch[i].indent = entry.indent;
+                batch[i].message.swap(entry.message);
+            }
+            _head = (_head + _size) % _entries.size();
+            _size = 0;
+
+            dropped = _dropped;
+            _droppedTotal += _dropped;
+            droppedTotal = _droppedTotal;
+            _dropped = 0;
+
+            if(full)
+            {
+                notifyAll(); // Wake up the producers waiting for room.
+            }
+        }
+
+        //
+        // Each logger output is only flushed once per batch.
+        //
+        for(vector<Entry>::size_type i = 0; i < batch.size(); ++i)
+        {
+            bool flush = i + 1 == batch.size() || batch[i + 1].logger != batch[i].logger;
+            batch[i].logger->writeMessage(batch[i].message, batch[i].indent, flush);
+        }
+
+        if(dropped > 0)
+        {
+            ostringstream os;
+            os << dropped << " log message(s) dropped because the logger queue is full (" << droppedTotal
+               << " dropped since the communicator was initialized)";
+            batch.back().logger->warning(os.str());
+        }
+
+        {
+            Lock sync(*this);
+            _done += static_cast<Ice::Long>(batch.size());
+            notifyAll();
+        }
+    }
+}
@@ -7,16 +7,80 @@
 
 #include <Ice/Logger.h>
 #include <Ice/StringConverter.h>
+#include <Ice/PropertiesF.h>
+#include <IceUtil/Thread.h>
+#include <IceUtil/Monitor.h>
 #include <fstream>
 
 namespace Ice
 {
 
+class LoggerI;
+
+}
+
+namespace IceInternal
+{
+
+//
+// Bounded queue of the formatted messages of the asynchronous loggers
+// (Ice.LogAsync). The queue thread writes the messages in batches. When
+// the queue is full, print and trace messages are dropped or wait
+// according to the overflow policy, warnings and errors always wait.
+//
+class LoggerQueue : public IceUtil::Thread, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    enum OverflowPolicy
+    {
+        DropNewest,
+        DropOldest,
+        Block
+    };
+
+    static OverflowPolicy getOverflowPolicy(const Ice::PropertiesPtr&);
+
+    LoggerQueue(const Ice::PropertiesPtr&);
+
+    bool push(Ice::LoggerI*, const std::string&, bool, bool);
+    void flush();
+    void destroy();
+
+    virtual void run();
+
+private:
+
+    struct Entry
+    {
+        Ice::LoggerI* logger;
+        std::string message;
+        bool indent;
+    };
+
+    const OverflowPolicy _policy;
+    std::vector<Entry> _entries;
+    size_t _head;
+    size_t _size;
+    bool _destroyed;
+    Ice::Long _pushed;
+    Ice::Long _done;
+    Ice::Long _dropped;
+    Ice::Long _droppedTotal;
+};
+typedef IceUtil::Handle<LoggerQueue> LoggerQueuePtr;
+
+}
+
+namespace Ice
+{
+
 class LoggerI : public Logger
 {
 public:
 
-    LoggerI(const std::string&, const std::string&, bool convert = true, std::size_t sizeMax = 0);
+    LoggerI(const std::string&, const std::string&, bool convert = true, std::size_t sizeMax = 0,
+            const IceInternal::LoggerQueuePtr& = 0);
     ~LoggerI();
 
     virtual void print(const std::string&);
@@ -28,13 +92,17 @@ public:
 
 private:
 
-    void write(const std::string&, bool);
+    friend class IceInternal::LoggerQueue;
+
+    void write(const std::string&, bool, bool);
+    void writeMessage(const std::string&, bool, bool);
 
     const std::string _prefix;
     std::string _formattedPrefix;
     const bool _convert;
     const StringConverterPtr _converter;
     std::ofstream _out;
+    const IceInternal::LoggerQueuePtr _queue;
 
     std::string _file;
     std::size_t _sizeMax;
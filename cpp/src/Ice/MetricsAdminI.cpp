@@ -28,6 +28,7 @@ const string suffixes[] =
     "Accept.*",
     "Reject.*",
     "RetainDetached",
+    "Histogram",
     "Map.*",
 };
 
@@ -122,6 +123,27 @@ MetricsMapI::RegExp::~RegExp()
 
 bool
 MetricsMapI::RegExp::match(const string& value)
+{
+    CacheShard& shard = _cache[getMetricsShard()];
+    IceUtil::Mutex::Lock sync(shard);
+    map<string, bool>::const_iterator p = shard.results.find(value);
+    if(p != shard.results.end())
+    {
+        return p->second;
+    }
+
+    if(shard.order.size() >= CacheShardSize)
+    {
+        shard.results.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+    bool matched = matchRegExp(value);
+    shard.order.push_back(shard.results.insert(make_pair(value, matched)).first);
+    return matched;
+}
+
+bool
+MetricsMapI::RegExp::matchRegExp(const string& value)
 {
 #ifdef __MINGW32__
     //
@@ -145,11 +167,160 @@ MetricsMapI::~MetricsMapI()
     // Out of line to avoid weak vtable
 }
 
+LatencyHistogram::LatencyHistogram()
+{
+    for(int i = 0; i < BucketCount; ++i)
+    {
+        _counts[i].exchange(0);
+    }
+}
+
+void
+LatencyHistogram::record(Ice::Long value)
+{
+    int index;
+    if(value < SubBucketCount)
+    {
+        index = value > 0 ? static_cast<int>(value) : 0; // Values smaller than the sub-bucket count are exact.
+    }
+    else
+    {
+        //
+        // Compute the index of the most significant bit, the bucket
+        // is given by the bits following the most significant bit.
+        //
+        int msb = 0;
+        Ice::Long v = value;
+        for(int shift = 32; shift > 0; shift >>= 1)
+        {
+            if(v >> shift)
+            {
+                v >>= shift;
+                msb += shift;
+            }
+        }
+        if(msb >= MaxBits)
+        {
+            index = BucketCount - 1;
+        }
+        else
+        {
+            int subBucket = static_cast<int>(value >> (msb - SubBucketBits)) - SubBucketCount;
+            index = (msb - SubBucketBits + 1) * SubBucketCount + subBucket;
+        }
+    }
+    _counts[index].fetch_add(1);
+}
+
+IceMX::Histogram
+LatencyHistogram::getHistogram() const
+{
+    IceMX::Histogram histogram;
+    for(int i = 0; i < BucketCount; ++i)
+    {
+        int count = _counts[i].load();
+        if(count > 0)
+        {
+            IceMX::HistogramBucket bucket;
+            if(i < SubBucketCount)
+            {
+                bucket.upperBound = i;
+            }
+            else
+            {
+                int shift = i / SubBucketCount - 1;
+                Ice::Long subBucket = i % SubBucketCount + SubBucketCount;
+                bucket.upperBound = ((subBucket + 1) << shift) - 1;
+            }
+            bucket.count = count;
+            histogram.push_back(bucket);
+        }
+    }
+    return histogram;
+}
+
+namespace
+{
+
+//
+// The metrics shard assigned to the calling thread, the thread
+// specific value points to the shard slot in _slots.
+//
+class ThreadShard
+{
+public:
+
+    ThreadShard() : _next(0)
+    {
+#ifdef _WIN32
+        _key = TlsAlloc();
+        assert(_key != TLS_OUT_OF_INDEXES);
+#else
+        int err = pthread_key_create(&_key, 0);
+        assert(err == 0);
+        (void)err;
+#endif
+    }
+
+    ~ThreadShard()
+    {
+#ifdef _WIN32
+        TlsFree(_key);
+#else
+        pthread_key_delete(_key);
+#endif
+    }
+
+    int
+    get()
+    {
+#ifdef _WIN32
+        void* value = TlsGetValue(_key);
+#else
+        void* value = pthread_getspecific(_key);
+#endif
+        if(value)
+        {
+            return static_cast<int>(static_cast<char*>(value) - _slots);
+        }
+
+        int shard = static_cast<int>(static_cast<unsigned int>(_next.fetch_add(1)) % MetricsShardCount);
+        value = &_slots[shard];
+#ifdef _WIN32
+        TlsSetValue(_key, value);
+#else
+        pthread_setspecific(_key, value);
+#endif
+        return shard;
+    }
+
+private:
+
+#ifdef _WIN32
+    DWORD _key;
+#else
+    pthread_key_t _key;
+#endif
+    IceUtilInternal::Atomic _next;
+    char _slots[MetricsShardCount];
+};
+
+ThreadShard threadShard;
+
+}
+
+int
+IceInternal::getMetricsShard()
+{
+    return threadShard.get();
+}
+
 MetricsMapI::MetricsMapI(const std::string& mapPrefix, const PropertiesPtr& properties) :
     _properties(properties->getPropertiesForPrefix(mapPrefix)),
     _retain(properties->getPropertyAsIntWithDefault(mapPrefix + "RetainDetached", 10)),
     _accept(parseRule(properties, mapPrefix + "Accept")),
-    _reject(parseRule(properties, mapPrefix + "Reject"))
+    _reject(parseRule(properties, mapPrefix + "Reject")),
+    _histogram(properties->getPropertyAsInt(mapPrefix + "Histogram") > 0)
 {
     validateProperties(mapPrefix, properties);
 
@@ -208,7 +379,8 @@ MetricsMapI::MetricsMapI(const MetricsMapI& map) :
     _groupBySeparators(map._groupBySeparators),
     _retain(map._retain),
     _accept(map._accept),
-    _reject(map._reject)
+    _reject(map._reject),
+    _histogram(map._histogram)
 {
 }
 
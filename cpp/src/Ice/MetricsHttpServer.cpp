@@ -0,0 +1,807 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/MetricsHttpServer.h>
+#include <Ice/HttpParser.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+
+#include <cstring>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+using namespace IceMX;
+
+namespace
+{
+
+const char* const contentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+//
+// A metrics attribute exposed as an OpenMetrics metric family. The
+// metrics object is cast to the attribute class by the accessor, the
+// class is checked once for each metrics map.
+//
+struct Attribute
+{
+    const char* suffix;
+    bool counter;
+    Ice::Long (*value)(const Metrics*);
+};
+
+template<class T, typename Y, Y T::*member> Ice::Long
+getValue(const Metrics* m)
+{
+    return static_cast<Ice::Long>(static_cast<const T*>(m)->*member);
+}
+
+const Attribute metricsAttributes[] =
+{
+    { "", true, &getValue<Metrics, Ice::Long, &Metrics::total> },
+    { "_current", false, &getValue<Metrics, Ice::Int, &Metrics::current> },
+    { "_lifetime_microseconds", true, &getValue<Metrics, Ice::Long, &Metrics::totalLifetime> },
+    { "_failures", true, &getValue<Metrics, Ice::Int, &Metrics::failures> },
+    { 0, false, 0 }
+};
+
+const Attribute threadAttributes[] =
+{
+    { "_in_use_for_io", false, &getValue<ThreadMetrics, Ice::Int, &ThreadMetrics::inUseForIO> },
+    { "_in_use_for_user", false, &getValue<ThreadMetrics, Ice::Int, &ThreadMetrics::inUseForUser> },
+    { "_in_use_for_other", false, &getValue<ThreadMetrics, Ice::Int, &ThreadMetrics::inUseForOther> },
+    { 0, false, 0 }
+};
+
+const Attribute dispatchAttributes[] =
+{
+    { "_user_exceptions", true, &getValue<DispatchMetrics, Ice::Int, &DispatchMetrics::userException> },
+    { "_size_bytes", true, &getValue<DispatchMetrics, Ice::Long, &DispatchMetrics::size> },
+    { "_reply_size_bytes", true, &getValue<DispatchMetrics, Ice::Long, &DispatchMetrics::replySize> },
+    { 0, false, 0 }
+};
+
+const Attribute childInvocationAttributes[] =
+{
+    { "_size_bytes", true, &getValue<ChildInvocationMetrics, Ice::Long, &ChildInvocationMetrics::size> },
+    { "_reply_size_bytes", true, &getValue<ChildInvocationMetrics, Ice::Long, &ChildInvocationMetrics::replySize> },
+    { 0, false, 0 }
+};
+
+const Attribute invocationAttributes[] =
+{
+    { "_retries", true, &getValue<InvocationMetrics, Ice::Int, &InvocationMetrics::retry> },
+    { "_user_exceptions", true, &getValue<InvocationMetrics, Ice::Int, &InvocationMetrics::userException> },
+    { 0, false, 0 }
+};
+
+const Attribute connectionAttributes[] =
+{
+    { "_received_bytes", true, &getValue<ConnectionMetrics, Ice::Long, &ConnectionMetrics::receivedBytes> },
+    { "_sent_bytes", true, &getValue<ConnectionMetrics, Ice::Long, &ConnectionMetrics::sentBytes> },
+    { 0, false, 0 }
+};
+
+const Attribute acmAttributes[] =
+{
+    { "_monitored", true, &getValue<ACMMetrics, Ice::Long, &ACMMetrics::monitored> },
+    { "_parked", true, &getValue<ACMMetrics, Ice::Long, &ACMMetrics::parked> },
+    { "_connections", false, &getValue<ACMMetrics, Ice::Int, &ACMMetrics::connections> },
+    { "_buckets", false, &getValue<ACMMetrics, Ice::Int, &ACMMetrics::buckets> },
+    { 0, false, 0 }
+};
+
+const Attribute locatorCacheAttributes[] =
+{
+    { "_hits", true, &getValue<LocatorCacheMetrics, Ice::Long, &LocatorCacheMetrics::hits> },
+    { "_misses", true, &getValue<LocatorCacheMetrics, Ice::Long, &LocatorCacheMetrics::misses> },
+    { "_negative_hits", true, &getValue<LocatorCacheMetrics, Ice::Long, &LocatorCacheMetrics::negativeHits> },
+    { "_refreshes", true, &getValue<LocatorCacheMetrics, Ice::Long, &LocatorCacheMetrics::refreshes> },
+    { 0, false, 0 }
+};
+
+const Attribute threadPoolAttributes[] =
+{
+    { "_queued", true, &getValue<ThreadPoolMetrics, Ice::Long, &ThreadPoolMetrics::queued> },
+    { "_stolen", true, &getValue<ThreadPoolMetrics, Ice::Long, &ThreadPoolMetrics::stolen> },
+    { "_queue_depth", false, &getValue<ThreadPoolMetrics, Ice::Int, &ThreadPoolMetrics::queueDepth> },
+    { "_max_queue_depth", false, &getValue<ThreadPoolMetrics, Ice::Int, &ThreadPoolMetrics::maxQueueDepth> },
+    { 0, false, 0 }
+};
+
+const Attribute*
+getAttributes(const Metrics* m)
+{
+    if(dynamic_cast<const ThreadMetrics*>(m))
+    {
+        return threadAttributes;
+    }
+    else if(dynamic_cast<const DispatchMetrics*>(m))
+    {
+        return dispatchAttributes;
+    }
+    else if(dynamic_cast<const ChildInvocationMetrics*>(m))
+    {
+        return childInvocationAttributes;
+    }
+    else if(dynamic_cast<const InvocationMetrics*>(m))
+    {
+        return invocationAttributes;
+    }
+    else if(dynamic_cast<const ConnectionMetrics*>(m))
+    {
+        return connectionAttributes;
+    }
+    else if(dynamic_cast<const ACMMetrics*>(m))
+    {
+        return acmAttributes;
+    }
+    else if(dynamic_cast<const LocatorCacheMetrics*>(m))
+    {
+        return locatorCacheAttributes;
+    }
+    else if(dynamic_cast<const ThreadPoolMetrics*>(m))
+    {
+        return threadPoolAttributes;
+    }
+    return 0; // Only the base attributes are exposed for other metrics (IceStorm, Glacier2, etc).
+}
+
+//
+// The metrics maps of the different views are grouped by name since
+// the samples of a metric family must be contiguous.
+//
+struct Series
+{
+    const string* view;
+    const string* parent;
+    const MetricsMap* metrics;
+};
+typedef map<string, vector<Series> > SeriesMap;
+
+string
+toMetricName(const string& name)
+{
+    string result;
+    for(string::size_type i = 0; i < name.size(); ++i)
+    {
+        char c = name[i];
+        if(c >= 'A' && c <= 'Z')
+        {
+            if(i > 0 && ((name[i - 1] >= 'a' && name[i - 1] <= 'z') || (name[i - 1] >= '0' && name[i - 1] <= '9')))
+            {
+                result += '_';
+            }
+            result += static_cast<char>(c - 'A' + 'a');
+        }
+        else if((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))
+        {
+            result += c;
+        }
+        else
+        {
+            result += '_';
+        }
+    }
+    return result;
+}
+
+void
+addSeries(SeriesMap& series, const string& name, const string& view, const string* parent, const MetricsMap& metrics)
+{
+    if(metrics.empty())
+    {
+        return;
+    }
+
+    Series s = { &view, parent, &metrics };
+    series[name].push_back(s);
+
+    //
+    // The invocation remote and collocated sub-maps are exposed as
+    // separate families labeled with the parent invocation id.
+    //
+    for(MetricsMap::const_iterator p = metrics.begin(); p != metrics.end(); ++p)
+    {
+        const InvocationMetrics* m = dynamic_cast<const InvocationMetrics*>(p->get());
+        if(m)
+        {
+            addSeries(series, name + "_remote", view, &m->id, m->remotes);
+            addSeries(series, name + "_collocated", view, &m->id, m->collocated);
+        }
+    }
+}
+
+}
+
+namespace IceInternal
+{
+
+//
+// Serializes the metrics directly into a fixed size buffer which is
+// sent as an HTTP chunk whenever it's full, the response is never
+// built in memory.
+//
+class OpenMetricsWriter : private IceUtil::noncopyable
+{
+public:
+
+    OpenMetricsWriter(MetricsHttpServer& server, SOCKET fd, bool chunked) :
+        _server(server), _fd(fd), _chunked(chunked), _pos(0)
+    {
+    }
+
+    void
+    write(const char* s, size_t length)
+    {
+        while(length > 0)
+        {
+            if(_pos == BufferSize)
+            {
+                flush();
+            }
+            size_t n = min(length, static_cast<size_t>(BufferSize) - _pos);
+            memcpy(_buffer + _pos, s, n);
+            _pos += n;
+            s += n;
+            length -= n;
+        }
+    }
+
+    void
+    write(const char* s)
+    {
+        write(s, strlen(s));
+    }
+
+    void
+    write(const string& s)
+    {
+        write(s.data(), s.size());
+    }
+
+    void
+    write(char c)
+    {
+        if(_pos == BufferSize)
+        {
+            flush();
+        }
+        _buffer[_pos++] = c;
+    }
+
+    void
+    writeLong(Ice::Long value)
+    {
+        char digits[24];
+        char* p = digits + sizeof(digits);
+        Ice::Long v = value;
+        do
+        {
+            int digit = static_cast<int>(v % 10);
+            *--p = static_cast<char>('0' + (digit < 0 ? -digit : digit));
+            v /= 10;
+        }
+        while(v != 0);
+        if(value < 0)
+        {
+            *--p = '-';
+        }
+        write(p, static_cast<size_t>(digits + sizeof(digits) - p));
+    }
+
+    void
+    writeLabel(const char* name, const string& value)
+    {
+        write(name);
+        write("=\"", 2);
+        for(string::const_iterator p = value.begin(); p != value.end(); ++p)
+        {
+            switch(*p)
+            {
+            case '\\':
+                write("\\\\", 2);
+                break;
+            case '"':
+                write("\\\"", 2);
+                break;
+            case '\n':
+                write("\\n", 2);
+                break;
+            default:
+                write(*p);
+                break;
+            }
+        }
+        write('"');
+    }
+
+    void
+    writeLabels(const Series& series, const Metrics* m)
+    {
+        write('{');
+        writeLabel("view", *series.view);
+        write(',');
+        writeLabel("id", m->id);
+        if(series.parent)
+        {
+            write(',');
+            writeLabel("parent", *series.parent);
+        }
+    }
+
+    void
+    flush()
+    {
+        if(_pos == 0)
+        {
+            return;
+        }
+
+        if(_chunked)
+        {
+            char header[16];
+            char* p = header + sizeof(header);
+            *--p = '\n';
+            *--p = '\r';
+            size_t length = _pos;
+            do
+            {
+                *--p = "0123456789abcdef"[length % 16];
+                length /= 16;
+            }
+            while(length > 0);
+            _server.send(_fd, p, static_cast<size_t>(header + sizeof(header) - p));
+            _server.send(_fd, _buffer, _pos);
+            _server.send(_fd, "\r\n", 2);
+        }
+        else
+        {
+            _server.send(_fd, _buffer, _pos);
+        }
+        _pos = 0;
+    }
+
+    void
+    finish()
+    {
+        flush();
+        if(_chunked)
+        {
+            _server.send(_fd, "0\r\n\r\n", 5);
+        }
+    }
+
+private:
+
+    enum { BufferSize = 16 * 1024 };
+
+    MetricsHttpServer& _server;
+    const SOCKET _fd;
+    const bool _chunked;
+    char _buffer[BufferSize];
+    size_t _pos;
+};
+
+}
+
+namespace
+{
+
+void
+writeFamily(OpenMetricsWriter& out, const string& name, const vector<Series>& series, const Attribute& attribute)
+{
+    out.write("# TYPE ", 7);
+    out.write(name);
+    out.write(attribute.suffix);
+    out.write(attribute.counter ? " counter\n" : " gauge\n");
+    for(vector<Series>::const_iterator s = series.begin(); s != series.end(); ++s)
+    {
+        for(MetricsMap::const_iterator p = s->metrics->begin(); p != s->metrics->end(); ++p)
+        {
+            if(!*p)
+            {
+                continue;
+            }
+            out.write(name);
+            out.write(attribute.suffix);
+            if(attribute.counter)
+            {
+                out.write("_total", 6);
+            }
+            out.writeLabels(*s, p->get());
+            out.write("} ", 2);
+            out.writeLong(attribute.value(p->get()));
+            out.write('\n');
+        }
+    }
+}
+
+void
+writeHistogramFamily(OpenMetricsWriter& out, const string& name, const vector<Series>& series)
+{
+    bool header = false;
+    for(vector<Series>::const_iterator s = series.begin(); s != series.end(); ++s)
+    {
+        for(MetricsMap::const_iterator p = s->metrics->begin(); p != s->metrics->end(); ++p)
+        {
+            const Metrics* m = p->get();
+            if(!m || !m->lifetimeHistogram)
+            {
+                continue;
+            }
+
+            if(!header)
+            {
+                out.write("# TYPE ", 7);
+                out.write(name);
+                out.write("_latency_microseconds histogram\n");
+                header = true;
+            }
+
+            Ice::Long count = 0;
+            for(Histogram::const_iterator q = m->lifetimeHistogram->begin(); q != m->lifetimeHistogram->end(); ++q)
+            {
+                count += q->count;
+                out.write(name);
+                out.write("_latency_microseconds_bucket");
+                out.writeLabels(*s, m);
+                out.write(",le=\"", 5);
+                out.writeLong(q->upperBound);
+                out.write("\"} ", 3);
+                out.writeLong(count);
+                out.write('\n');
+            }
+
+            out.write(name);
+            out.write("_latency_microseconds_bucket");
+            out.writeLabels(*s, m);
+            out.write(",le=\"+Inf\"} ");
+            out.writeLong(count);
+            out.write('\n');
+
+            out.write(name);
+            out.write("_latency_microseconds_count");
+            out.writeLabels(*s, m);
+            out.write("} ", 2);
+            out.writeLong(count);
+            out.write('\n');
+
+            out.write(name);
+            out.write("_latency_microseconds_sum");
+            out.writeLabels(*s, m);
+            out.write("} ", 2);
+            out.writeLong(m->totalLifetime);
+            out.write('\n');
+        }
+    }
+}
+
+}
+
+IceInternal::MetricsHttpServer::MetricsHttpServer(const PropertiesPtr& properties,
+                                                  const LoggerPtr& logger,
+                                                  const MetricsAdminIPtr& metricsAdmin,
+                                                  ProtocolSupport protocol,
+                                                  bool preferIPv6) :
+    IceUtil::Thread("Ice.MetricsHttpServer"),
+    _logger(logger),
+    _metricsAdmin(metricsAdmin),
+    _timeout(properties->getPropertyAsIntWithDefault("IceMX.Http.Timeout", 5000)),
+    _fd(INVALID_SOCKET),
+    _fdIntrRead(INVALID_SOCKET),
+    _fdIntrWrite(INVALID_SOCKET)
+{
+    //
+    // Listen on the loopback interface by default, IceMX.Http.Host must
+    // be set (for example to 0.0.0.0) to serve the metrics to other hosts.
+    //
+    string host = properties->getProperty("IceMX.Http.Host");
+    if(host.empty())
+    {
+        host = protocol == EnableIPv6 ? "::1" : "127.0.0.1";
+    }
+    const int port = properties->getPropertyAsInt("IceMX.Http.Port");
+
+    _addr = getAddressForServer(host, port, protocol, preferIPv6, true);
+    _fd = createServerSocket(false, _addr, protocol);
+    try
+    {
+#ifndef _WIN32
+        setReuseAddress(_fd, true);
+#endif
+        _addr = doBind(_fd, _addr);
+        doListen(_fd, 16);
+
+        SOCKET fds[2];
+        createPipe(fds);
+        _fdIntrRead = fds[0];
+        _fdIntrWrite = fds[1];
+    }
+    catch(...)
+    {
+        closeSocketNoThrow(_fd);
+        throw;
+    }
+}
+
+IceInternal::MetricsHttpServer::~MetricsHttpServer()
+{
+    closeSocketNoThrow(_fd);
+    if(_fdIntrRead != INVALID_SOCKET)
+    {
+        closeSocketNoThrow(_fdIntrRead);
+        closeSocketNoThrow(_fdIntrWrite);
+    }
+}
+
+void
+IceInternal::MetricsHttpServer::destroy()
+{
+    //
+    // Wake up the server thread, it returns once the interrupt pipe
+    // is readable.
+    //
+    char c = 0;
+#ifdef _WIN32
+    ::send(_fdIntrWrite, &c, 1, 0);
+#else
+    while(::write(_fdIntrWrite, &c, 1) == SOCKET_ERROR && interrupted())
+    {
+    }
+#endif
+}
+
+void
+IceInternal::MetricsHttpServer::run()
+{
+    while(wait(_fd, WaitRead, -1))
+    {
+        SOCKET fd;
+        try
+        {
+            fd = doAccept(_fd);
+        }
+        catch(const SocketException& ex)
+        {
+            if(noMoreFds(ex.error))
+            {
+                Error out(_logger);
+                out << "failed to accept metrics HTTP connection:\n" << ex << '\n' << toString();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(1));
+            }
+            continue;
+        }
+
+        try
+        {
+            setBlock(fd, false);
+            handleRequest(fd);
+        }
+        catch(const Ice::LocalException&)
+        {
+            // Ignore, the client connection is closed.
+        }
+        catch(const std::exception& ex)
+        {
+            Warning out(_logger);
+            out << "unexpected exception while serving metrics HTTP request:\n" << ex.what();
+        }
+        closeSocketNoThrow(fd);
+    }
+}
+
+string
+IceInternal::MetricsHttpServer::toString() const
+{
+    return "local address = " + addrToString(_addr);
+}
+
+void
+IceInternal::MetricsHttpServer::handleRequest(SOCKET fd)
+{
+    //
+    // Read the request headers, a request body isn't expected.
+    //
+    Byte buffer[4096];
+    size_t length = 0;
+    HttpParser parser;
+    const Byte* end = 0;
+    try
+    {
+        while((end = parser.isCompleteMessage(buffer, buffer + length)) == 0)
+        {
+            if(length == sizeof(buffer) || !wait(fd, WaitRead, _timeout))
+            {
+                return;
+            }
+
+#ifdef _WIN32
+            ssize_t ret = ::recv(fd, reinterpret_cast<char*>(buffer + length), static_cast<int>(sizeof(buffer) - length), 0);
+#else
+            ssize_t ret = ::recv(fd, reinterpret_cast<char*>(buffer + length), sizeof(buffer) - length, 0);
+#endif
+            if(ret == 0)
+            {
+                return;
+            }
+            else if(ret == SOCKET_ERROR)
+            {
+                if(interrupted() || wouldBlock())
+                {
+                    continue;
+                }
+                return;
+            }
+            length += static_cast<size_t>(ret);
+        }
+
+        if(!parser.parse(buffer, end) || parser.type() != HttpParser::TypeRequest)
+        {
+            throw WebSocketException("malformed request");
+        }
+    }
+    catch(const WebSocketException&)
+    {
+        const string response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        send(fd, response.c_str(), response.size());
+        return;
+    }
+
+    string path = parser.uri();
+    string::size_type pos = path.find('?');
+    if(pos != string::npos)
+    {
+        path.erase(pos);
+    }
+
+    if(parser.method() != "GET")
+    {
+        const string response = "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET\r\nContent-Length: 0\r\n"
+                                "Connection: close\r\n\r\n";
+        send(fd, response.c_str(), response.size());
+        return;
+    }
+    else if(path != "/metrics")
+    {
+        const string response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        send(fd, response.c_str(), response.size());
+        return;
+    }
+
+    //
+    // Retrieve the metrics of all the enabled views.
+    //
+    StringSeq disabledViews;
+    StringSeq views = _metricsAdmin->getMetricsViewNames(disabledViews, Ice::emptyCurrent);
+    vector<MetricsView> metricsViews;
+    metricsViews.reserve(views.size());
+    for(StringSeq::const_iterator p = views.begin(); p != views.end(); ++p)
+    {
+        try
+        {
+            Ice::Long timestamp;
+            metricsViews.push_back(_metricsAdmin->getMetricsView(*p, timestamp, Ice::emptyCurrent));
+        }
+        catch(const UnknownMetricsView&)
+        {
+            metricsViews.push_back(MetricsView()); // The view was disabled or removed concurrently.
+        }
+    }
+
+    SeriesMap series;
+    for(vector<MetricsView>::size_type i = 0; i < metricsViews.size(); ++i)
+    {
+        for(MetricsView::const_iterator p = metricsViews[i].begin(); p != metricsViews[i].end(); ++p)
+        {
+            addSeries(series, "icemx_" + toMetricName(p->first), views[i], 0, p->second);
+        }
+    }
+
+    //
+    // HTTP/1.0 clients don't support the chunked transfer encoding,
+    // the end of the response is given by the connection closure.
+    //
+    const bool chunked = parser.versionMajor() > 1 || (parser.versionMajor() == 1 && parser.versionMinor() > 0);
+    string header = "HTTP/1.1 200 OK\r\nContent-Type: ";
+    header += contentType;
+    header += chunked ? "\r\nTransfer-Encoding: chunked" : "";
+    header += "\r\nConnection: close\r\n\r\n";
+    send(fd, header.c_str(), header.size());
+
+    OpenMetricsWriter out(*this, fd, chunked);
+    for(SeriesMap::const_iterator p = series.begin(); p != series.end(); ++p)
+    {
+        const Metrics* first = p->second.front().metrics->front().get();
+        for(const Attribute* a = metricsAttributes; a->suffix; ++a)
+        {
+            writeFamily(out, p->first, p->second, *a);
+        }
+        const Attribute* attributes = first ? getAttributes(first) : 0;
+        for(const Attribute* a = attributes; a && a->suffix; ++a)
+        {
+            writeFamily(out, p->first, p->second, *a);
+        }
+        writeHistogramFamily(out, p->first, p->second);
+    }
+    out.write("# EOF\n", 6);
+    out.finish();
+}
+
+bool
+IceInternal::MetricsHttpServer::wait(SOCKET fd, Wait op, int timeout)
+{
+    while(true)
+    {
+#ifdef _WIN32
+        WSAPOLLFD fds[2];
+#else
+        struct pollfd fds[2];
+#endif
+        fds[0].fd = _fdIntrRead;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = fd;
+        fds[1].events = op == WaitRead ? POLLIN : POLLOUT;
+        fds[1].revents = 0;
+
+#ifdef _WIN32
+        int ret = WSAPoll(fds, 2, timeout);
+#else
+        int ret = ::poll(fds, 2, timeout);
+#endif
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+
+        if(ret == 0 || fds[0].revents != 0)
+        {
+            return false; // Timeout or destroyed.
+        }
+        return true;
+    }
+}
+
+void
+IceInternal::MetricsHttpServer::send(SOCKET fd, const char* buf, size_t length)
+{
+    while(length > 0)
+    {
+#ifdef _WIN32
+        ssize_t ret = ::send(fd, buf, static_cast<int>(length), 0);
+#else
+        ssize_t ret = ::send(fd, buf, length, 0);
+#endif
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                if(!wait(fd, WaitWrite, _timeout))
+                {
+                    throw TimeoutException(__FILE__, __LINE__);
+                }
+                continue;
+            }
+
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        buf += ret;
+        length -= static_cast<size_t>(ret);
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_METRICS_HTTP_SERVER_H
+#define ICE_METRICS_HTTP_SERVER_H
+
+#include <IceUtil/Thread.h>
+#include <Ice/MetricsAdminI.h>
+#include <Ice/Network.h>
+
+namespace IceInternal
+{
+
+//
+// Serves the enabled IceMX metrics views in the OpenMetrics text
+// format over HTTP. The server is enabled with the IceMX.Http.Port
+// property and listens on the loopback interface unless IceMX.Http.Host
+// is set, requests are served one at a time by the server thread.
+//
+class MetricsHttpServer : public IceUtil::Thread
+{
+public:
+
+    MetricsHttpServer(const Ice::PropertiesPtr&, const Ice::LoggerPtr&, const MetricsAdminIPtr&, ProtocolSupport,
+                      bool);
+    virtual ~MetricsHttpServer();
+
+    void destroy();
+
+    virtual void run();
+
+    std::string toString() const;
+
+private:
+
+    enum Wait
+    {
+        WaitRead,
+        WaitWrite
+    };
+
+    void handleRequest(SOCKET);
+    bool wait(SOCKET, Wait, int);
+    void send(SOCKET, const char*, size_t);
+
+    friend class OpenMetricsWriter;
+
+    const Ice::LoggerPtr _logger;
+    const MetricsAdminIPtr _metricsAdmin;
+    const int _timeout;
+    SOCKET _fd;
+    Address _addr;
+    SOCKET _fdIntrRead;
+    SOCKET _fdIntrWrite;
+};
+typedef IceUtil::Handle<MetricsHttpServer> MetricsHttpServerPtr;
+
+}
+
+#endif
@@ -386,6 +386,11 @@ Ice::ObjectAdapterI::destroy() ICE_NOEXCEPT
         _objectAdapterFactory->removeObjectAdapter(ICE_SHARED_FROM_THIS);
     }
 
+    {
+        IceUtil::Mutex::Lock sync(_dispatchMutex);
+        _suspendedConnections.clear();
+    }
+
     {
         IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(*this);
 
@@ -922,6 +927,133 @@ Ice::ObjectAdapterI::getACM() const
     return _acm;
 }
 
+bool
+Ice::ObjectAdapterI::startDispatch(int count)
+{
+    //
+    // Returns true if the requests can be dispatched right away. If
+    // the adapter dispatches the maximum number of requests, the
+    // caller must queue them with queueDispatch.
+    //
+    IceUtil::Mutex::Lock sync(_dispatchMutex);
+    assert(_maxDispatches > 0);
+    if(_dispatchCount < _maxDispatches && _pendingDispatches.empty())
+    {
+        _dispatchCount += count;
+        return true;
+    }
+    return false;
+}
+
+void
+Ice::ObjectAdapterI::queueDispatch(int count, const ThreadPoolPtr& threadPool, const DispatchWorkItemPtr& workItem)
+{
+    //
+    // The work item is dispatched with the given thread pool once
+    // the dispatch count drops below the limit. It might have dropped
+    // since startDispatch was called, in which case it's dispatched
+    // right away.
+    //
+    PendingDispatch pending;
+    pending.threadPool = threadPool;
+    pending.workItem = workItem;
+    pending.count = count;
+    {
+        IceUtil::Mutex::Lock sync(_dispatchMutex);
+        assert(_maxDispatches > 0);
+        if(_dispatchCount >= _maxDispatches || !_pendingDispatches.empty())
+        {
+            _pendingDispatches.push_back(pending);
+            return;
+        }
+        _dispatchCount += count;
+    }
+    dispatchPending(vector<PendingDispatch>(1, pending));
+}
+
+bool
+Ice::ObjectAdapterI::suspendReading(const Ice::ConnectionIPtr& connection)
+{
+    //
+    // Called by the connection with its mutex locked, the connection
+    // stops reading if the limit is reached. It's resumed by
+    // decDispatchCount once the dispatch count drops below the limit
+    // and no more requests are waiting to be dispatched.
+    //
+    IceUtil::Mutex::Lock sync(_dispatchMutex);
+    assert(_maxDispatches > 0);
+    if(_dispatchCount >= _maxDispatches || !_pendingDispatches.empty())
+    {
+        _suspendedConnections.push_back(connection);
+        return true;
+    }
+    return false;
+}
+
+void
+Ice::ObjectAdapterI::incDispatchCount(int count)
+{
+    //
+    // Direct collocated calls are never queued, they count toward
+    // the limit even if it's reached.
+    //
+    IceUtil::Mutex::Lock sync(_dispatchMutex);
+    assert(_maxDispatches > 0);
+    _dispatchCount += count;
+}
+
+void
+Ice::ObjectAdapterI::decDispatchCount(int count)
+{
+    //
+    // Must not be called with a connection mutex locked.
+    //
+    vector<PendingDispatch> pending;
+    vector<ConnectionIPtr> connections;
+    {
+        IceUtil::Mutex::Lock sync(_dispatchMutex);
+        assert(_dispatchCount >= count);
+        _dispatchCount -= count;
+        while(_dispatchCount < _maxDispatches && !_pendingDispatches.empty())
+        {
+            pending.push_back(_pendingDispatches.front());
+            _dispatchCount += _pendingDispatches.front().count;
+            _pendingDispatches.pop_front();
+        }
+        if(_dispatchCount < _maxDispatches)
+        {
+            _suspendedConnections.swap(connections);
+        }
+    }
+
+    dispatchPending(pending);
+
+    for(vector<ConnectionIPtr>::const_iterator p = connections.begin(); p != connections.end(); ++p)
+    {
+        (*p)->resumeAdapterDispatches();
+    }
+}
+
+bool
+Ice::ObjectAdapterI::isHighPriority(const string& operation, const Context& context) const
+{
+    if(isPriorityOperation(operation))
+    {
+        return true;
+    }
+    Context::const_iterator p = context.find("_priority");
+    return p != context.end() && p->second == "high";
+}
+
+bool
+Ice::ObjectAdapterI::isPriorityOperation(const string& operation) const
+{
+    //
+    // No mutex lock necessary, _priorityOperations is immutable.
+    //
+    return _priorityOperations.find(operation) != _priorityOperations.end();
+}
+
 void
 Ice::ObjectAdapterI::setAdapterOnConnection(const Ice::ConnectionIPtr& connection)
 {
@@ -946,10 +1078,33 @@ Ice::ObjectAdapterI::ObjectAdapterI(const InstancePtr& instance, const Communica
     _name(name),
     _directCount(0),
     _noConfig(noConfig),
-    _messageSizeMax(0)
+    _messageSizeMax(0),
+    _maxDispatches(0),
+    _maxConnectionDispatches(0),
+    _dispatchCount(0)
 {
 }
 
+void
+Ice::ObjectAdapterI::dispatchPending(const vector<PendingDispatch>& pending)
+{
+    for(vector<PendingDispatch>::const_iterator p = pending.begin(); p != pending.end(); ++p)
+    {
+        try
+        {
+            p->threadPool->dispatch(p->workItem);
+        }
+        catch(const CommunicatorDestroyedException&)
+        {
+            //
+            // The thread pool is destroyed, dispatch the requests
+            // from this thread.
+            //
+            p->workItem->run();
+        }
+    }
+}
+
 void
 Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
 {
@@ -957,6 +1112,7 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
     {
         _reference = _instance->referenceFactory()->create("dummy -t", "");
         const_cast<ACMConfig&>(_acm) = _instance->serverACM();
+        const_cast<size_t&>(_messageSizeMax) = _instance->messageSizeMax();
         return;
     }
 
@@ -1021,6 +1177,22 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
             }
         }
 
+        //
+        // Maximum number of requests dispatched concurrently by the
+        // connections of this adapter and by each of them. Once the
+        // limit is reached, connections stop reading requests until
+        // dispatches complete.
+        //
+        _maxDispatches = max(properties->getPropertyAsInt(_name + ".MaxDispatches"), 0);
+        _maxConnectionDispatches = max(properties->getPropertyAsInt(_name + ".Connection.MaxDispatches"), 0);
+
+        //
+        // Operations dispatched with high priority by thread pools
+        // with reserved threads.
+        //
+        StringSeq priorityOperations = properties->getPropertyAsList(_name + ".PriorityOperations");
+        _priorityOperations.insert(priorityOperations.begin(), priorityOperations.end());
+
         int threadPoolSize = properties->getPropertyAsInt(_name + ".ThreadPool.Size");
         int threadPoolSizeMax = properties->getPropertyAsInt(_name + ".ThreadPool.SizeMax");
         bool hasPriority = properties->getProperty(_name + ".ThreadPool.ThreadPriority") != "";
@@ -1454,6 +1626,7 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "ACM.Heartbeat",
         "ACM.Timeout",
         "AdapterId",
+        "Connection.MaxDispatches",
         "Endpoints",
         "Locator",
         "Locator.EncodingVersion",
@@ -1462,7 +1635,9 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "Locator.PreferSecure",
         "Locator.CollocationOptimized",
         "Locator.Router",
+        "MaxDispatches",
         "MessageSizeMax",
+        "PriorityOperations",
         "PublishedEndpoints",
         "ReplicaGroupId",
         "Router",
@@ -1486,7 +1661,9 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "ThreadPool.SizeWarn",
         "ThreadPool.StackSize",
         "ThreadPool.Serialize",
-        "ThreadPool.ThreadPriority"
+        "ThreadPool.ThreadPriority",
+        "ThreadPool.WorkStealing",
+        "ThreadPool.ReservedThreads"
     };
 
     //
@@ -26,6 +26,16 @@
 #include <Ice/Proxy.h>
 #include <Ice/ACM.h>
 #include <list>
+#include <set>
+#include <deque>
+
+namespace IceInternal
+{
+
+class DispatchWorkItem;
+typedef IceUtil::Handle<DispatchWorkItem> DispatchWorkItemPtr;
+
+}
 
 namespace Ice
 {
@@ -105,6 +115,18 @@ public:
     void setAdapterOnConnection(const Ice::ConnectionIPtr&);
     size_t messageSizeMax() const { return _messageSizeMax; }
 
+    int maxDispatches() const { return _maxDispatches; }
+    int maxConnectionDispatches() const { return _maxConnectionDispatches; }
+    bool startDispatch(int);
+    void queueDispatch(int, const IceInternal::ThreadPoolPtr&, const IceInternal::DispatchWorkItemPtr&);
+    bool suspendReading(const Ice::ConnectionIPtr&);
+    void incDispatchCount(int);
+    void decDispatchCount(int);
+
+    bool isHighPriority(const std::string&, const Context&) const;
+    bool hasPriorityOperations() const { return !_priorityOperations.empty(); }
+    bool isPriorityOperation(const std::string&) const;
+
     ObjectAdapterI(const IceInternal::InstancePtr&, const CommunicatorPtr&,
                    const IceInternal::ObjectAdapterFactoryPtr&, const std::string&, bool);
     virtual ~ObjectAdapterI();
@@ -152,6 +174,22 @@ private:
     int _directCount; // The number of direct proxies dispatching on this object adapter.
     bool _noConfig;
     size_t _messageSizeMax;
+    int _maxDispatches;
+    int _maxConnectionDispatches;
+    std::set<std::string> _priorityOperations;
+
+    struct PendingDispatch
+    {
+        IceInternal::ThreadPoolPtr threadPool;
+        IceInternal::DispatchWorkItemPtr workItem;
+        int count;
+    };
+    void dispatchPending(const std::vector<PendingDispatch>&);
+
+    IceUtil::Mutex _dispatchMutex;
+    int _dispatchCount; // The number of requests being dispatched, if MaxDispatches is set.
+    std::deque<PendingDispatch> _pendingDispatches;
+    std::vector<Ice::ConnectionIPtr> _suspendedConnections;
 };
 
 }
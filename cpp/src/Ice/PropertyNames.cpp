@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Thu Jul  2 14:55:02 2020
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 11:49:04 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -60,7 +60,13 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("Ice.Admin.MessageSizeMax", false, 0),
+    IceInternal::Property("Ice.Admin.MaxDispatches", false, 0),
+    IceInternal::Property("Ice.Admin.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("Ice.Admin.PriorityOperations", false, 0),
     IceInternal::Property("Ice.Admin.DelayCreation", false, 0),
     IceInternal::Property("Ice.Admin.Enabled", false, 0),
     IceInternal::Property("Ice.Admin.Facets", false, 0),
@@ -78,6 +84,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Compression.Level", false, 0),
     IceInternal::Property("Ice.CollectObjects", false, 0),
     IceInternal::Property("Ice.Config", false, 0),
+    IceInternal::Property("Ice.ConnectAttemptDelay", false, 0),
+    IceInternal::Property("Ice.ConnectionPoolSize", false, 0),
     IceInternal::Property("Ice.ConsoleListener", false, 0),
     IceInternal::Property("Ice.Default.CollocationOptimized", false, 0),
     IceInternal::Property("Ice.Default.EncodingVersion", false, 0),
@@ -119,6 +127,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
     IceInternal::Property("Ice.IPv6", false, 0),
+    IceInternal::Property("Ice.LocatorCacheNegativeTimeout", false, 0),
+    IceInternal::Property("Ice.LocatorCacheRefreshThreshold", false, 0),
+    IceInternal::Property("Ice.LogAsync", false, 0),
+    IceInternal::Property("Ice.LogAsync.Overflow", false, 0),
+    IceInternal::Property("Ice.LogAsync.QueueSize", false, 0),
     IceInternal::Property("Ice.LogFile", false, 0),
     IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
@@ -153,6 +166,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.WorkStealing", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.ReservedThreads", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
@@ -160,8 +176,13 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Server.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.WorkStealing", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.ReservedThreads", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.TimerWheelResolution", false, 0),
     IceInternal::Property("Ice.ToStringMode", false, 0),
+    IceInternal::Property("Ice.Trace.ACM", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Properties", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Logger", false, 0),
     IceInternal::Property("Ice.Trace.Locator", false, 0),
@@ -197,11 +218,15 @@ const IceInternal::PropertyArray
 
 const IceInternal::Property IceMXPropsData[] =
 {
+    IceInternal::Property("IceMX.Http.Host", false, 0),
+    IceInternal::Property("IceMX.Http.Port", false, 0),
+    IceInternal::Property("IceMX.Http.Timeout", false, 0),
     IceInternal::Property("IceMX.Metrics.*.GroupBy", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Map", false, 0),
     IceInternal::Property("IceMX.Metrics.*.RetainDetached", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Accept", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Reject", false, 0),
+    IceInternal::Property("IceMX.Metrics.*.Histogram", false, 0),
     IceInternal::Property("IceMX.Metrics.*", false, 0),
 };
 
@@ -247,7 +272,13 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.MessageSizeMax", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.PriorityOperations", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Heartbeat", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Close", false, 0),
@@ -284,7 +315,13 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Reply.MessageSizeMax", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.PriorityOperations", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Heartbeat", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Close", false, 0),
@@ -321,7 +358,13 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Locator.MessageSizeMax", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.PriorityOperations", false, 0),
     IceInternal::Property("IceDiscovery.Lookup", false, 0),
     IceInternal::Property("IceDiscovery.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.RetryCount", false, 0),
@@ -374,7 +417,13 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.MessageSizeMax", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.MaxDispatches", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.PriorityOperations", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Heartbeat", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Close", false, 0),
@@ -411,7 +460,13 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.MessageSizeMax", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.MaxDispatches", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.PriorityOperations", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Lookup", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Timeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.RetryCount", false, 0),
@@ -508,7 +563,13 @@ const IceInternal::Property IceBridgePropsData[] =
     IceInternal::Property("IceBridge.Source.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceBridge.Source.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceBridge.Source.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceBridge.Source.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceBridge.Source.MessageSizeMax", false, 0),
+    IceInternal::Property("IceBridge.Source.MaxDispatches", false, 0),
+    IceInternal::Property("IceBridge.Source.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceBridge.Source.PriorityOperations", false, 0),
     IceInternal::Property("IceBridge.Target.Endpoints", false, 0),
     IceInternal::Property("IceBridge.InstanceName", false, 0),
 };
@@ -563,7 +624,13 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Server.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.PriorityOperations", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Address", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Interface", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Lookup", false, 0),
@@ -603,7 +670,13 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.PriorityOperations", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ACM.Heartbeat", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ACM.Close", false, 0),
@@ -640,7 +713,13 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.PriorityOperations", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.Observers", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.SaveToRegistry", false, 0),
 };
@@ -687,7 +766,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.InstanceName", false, 0),
     IceInternal::Property("IceGrid.Node.ACM.Timeout", false, 0),
     IceInternal::Property("IceGrid.Node.ACM.Heartbeat", false, 0),
@@ -725,7 +810,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.Node.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Node.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Node.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Node.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.Node.AllowRunningServersAsRoot", false, 0),
     IceInternal::Property("IceGrid.Node.AllowEndpointsOverride", false, 0),
     IceInternal::Property("IceGrid.Node.CollocateRegistry", false, 0),
@@ -803,7 +894,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.ConnectionCached", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.PreferSecure", false, 0),
@@ -850,7 +947,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.Registry.CryptPasswords", false, 0),
     IceInternal::Property("IceGrid.Registry.DefaultTemplates", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ACM.Timeout", false, 0),
@@ -889,7 +992,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Enabled", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Address", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Port", false, 0),
@@ -931,7 +1040,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.MapSize", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.Path", false, 0),
     IceInternal::Property("IceGrid.Registry.NodeSessionTimeout", false, 0),
@@ -985,7 +1100,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionFilters", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM.Timeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM.Heartbeat", false, 0),
@@ -1023,7 +1144,13 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.PriorityOperations", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.ConnectionCached", false, 0),
@@ -1094,7 +1221,13 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
+    IceInternal::Property("IcePatch2.MaxDispatches", false, 0),
+    IceInternal::Property("IcePatch2.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("IcePatch2.PriorityOperations", false, 0),
     IceInternal::Property("IcePatch2.Directory", false, 0),
     IceInternal::Property("IcePatch2.InstanceName", false, 0),
 };
@@ -1155,6 +1288,7 @@ const IceInternal::Property IceSSLPropsData[] =
     IceInternal::Property("IceSSL.TrustOnly.Client", false, 0),
     IceInternal::Property("IceSSL.TrustOnly.Server", false, 0),
     IceInternal::Property("IceSSL.TrustOnly.Server.*", false, 0),
+    IceInternal::Property("IceSSL.TrustOnly.CacheSize", false, 0),
     IceInternal::Property("IceSSL.Truststore", false, 0),
     IceInternal::Property("IceSSL.TruststorePassword", false, 0),
     IceInternal::Property("IceSSL.TruststoreType", false, 0),
@@ -1227,7 +1361,13 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
+    IceInternal::Property("Glacier2.Client.MaxDispatches", false, 0),
+    IceInternal::Property("Glacier2.Client.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("Glacier2.Client.PriorityOperations", false, 0),
     IceInternal::Property("Glacier2.Client.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Client.Buffered", false, 0),
     IceInternal::Property("Glacier2.Client.ForwardContext", false, 0),
@@ -1302,7 +1442,13 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.WorkStealing", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.ReservedThreads", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.NormalPriorityQueueSizeMax", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
+    IceInternal::Property("Glacier2.Server.MaxDispatches", false, 0),
+    IceInternal::Property("Glacier2.Server.Connection.MaxDispatches", false, 0),
+    IceInternal::Property("Glacier2.Server.PriorityOperations", false, 0),
     IceInternal::Property("Glacier2.Server.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Server.Buffered", false, 0),
     IceInternal::Property("Glacier2.Server.ForwardContext", false, 0),
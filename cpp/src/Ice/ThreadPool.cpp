@@ -12,6 +12,8 @@
 #include <Ice/ObjectAdapterFactory.h>
 #include <Ice/Properties.h>
 #include <Ice/TraceLevels.h>
+#include <Ice/InstrumentationI.h>
+#include <Ice/ConnectionI.h>
 
 #if defined(ICE_OS_UWP)
 #   include <Ice/StringConverter.h>
@@ -102,6 +104,37 @@ private:
     IceUtil::ThreadPtr _thread;
 };
 
+class NormalPriorityWorkItem : public ThreadPoolWorkItem
+{
+public:
+
+    NormalPriorityWorkItem(ThreadPool& threadPool, const DispatchWorkItemPtr& workItem) :
+        _threadPool(threadPool), _workItem(workItem)
+    {
+    }
+
+    virtual void
+    execute(ThreadPoolCurrent& current)
+    {
+        current.ioCompleted(); // Promote follower
+        try
+        {
+            _workItem->run();
+        }
+        catch(...)
+        {
+            _threadPool.finishNormalPriority();
+            throw;
+        }
+        _threadPool.finishNormalPriority();
+    }
+
+private:
+
+    ThreadPool& _threadPool;
+    const DispatchWorkItemPtr _workItem;
+};
+
 //
 // Exception raised by the thread pool work queue when the thread pool
 // is destroyed.
@@ -110,6 +143,65 @@ class ThreadPoolDestroyedException
 {
 };
 
+//
+// The thread pool thread running in the calling thread, if any.
+//
+class CurrentThread
+{
+public:
+
+    CurrentThread()
+    {
+#ifdef _WIN32
+        _key = TlsAlloc();
+        assert(_key != TLS_OUT_OF_INDEXES);
+#else
+        int err = pthread_key_create(&_key, 0);
+        assert(err == 0);
+        (void)err;
+#endif
+    }
+
+    ~CurrentThread()
+    {
+#ifdef _WIN32
+        TlsFree(_key);
+#else
+        pthread_key_delete(_key);
+#endif
+    }
+
+    void
+    set(void* thread)
+    {
+#ifdef _WIN32
+        TlsSetValue(_key, thread);
+#else
+        pthread_setspecific(_key, thread);
+#endif
+    }
+
+    void*
+    get() const
+    {
+#ifdef _WIN32
+        return TlsGetValue(_key);
+#else
+        return pthread_getspecific(_key);
+#endif
+    }
+
+private:
+
+#ifdef _WIN32
+    DWORD _key;
+#else
+    pthread_key_t _key;
+#endif
+};
+
+CurrentThread currentThread;
+
 #ifdef ICE_SWIFT
 string
 prefixToDispatchQueueLabel(const std::string& prefix)
@@ -162,7 +254,14 @@ IceInternal::DispatchWorkItem::execute(ThreadPoolCurrent& current)
 
 IceInternal::ThreadPoolWorkQueue::ThreadPoolWorkQueue(ThreadPool& threadPool) :
     _threadPool(threadPool),
-    _destroyed(false)
+    _destroyed(false),
+    _pending(0),
+    _queued(0),
+    _stolen(0),
+    _maxDepth(0),
+    _closed(0),
+    _observedQueued(0),
+    _observedStolen(0)
 {
     _registered = SocketOperationRead;
 }
@@ -173,6 +272,13 @@ IceInternal::ThreadPoolWorkQueue::destroy()
     //Lock sync(*this); Called with the thread pool locked
     assert(!_destroyed);
     _destroyed = true;
+    _closed.exchange(1);
+    if(_observer)
+    {
+        observe();
+        _observer->detach();
+        _observer = 0;
+    }
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
     _threadPool._selector.completed(this, SocketOperationRead);
 #else
@@ -195,6 +301,139 @@ IceInternal::ThreadPoolWorkQueue::queue(const ThreadPoolWorkItemPtr& item)
 #endif
 }
 
+void
+IceInternal::ThreadPoolWorkQueue::queue(ThreadPool::EventHandlerThread* thread, const ThreadPoolWorkItemPtr& item)
+{
+    //
+    // Called without the thread pool locked, the thread pool is only
+    // locked to wake up a thread if no work items were pending. Work
+    // items queued before the thread pool is destroyed are executed
+    // by the threads before they terminate.
+    //
+    if(_closed.load())
+    {
+        throw CommunicatorDestroyedException(__FILE__, __LINE__);
+    }
+
+    int depth = static_cast<int>(thread->queue(item));
+    _queued.fetch_add(1);
+    int maxDepth = _maxDepth.load();
+    while(depth > maxDepth)
+    {
+        maxDepth = _maxDepth.exchange(depth);
+        if(maxDepth > depth)
+        {
+            depth = maxDepth; // Restore the larger depth set by another thread.
+        }
+    }
+
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
+    _pending.fetch_add(1);
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_threadPool);
+    _threadPool._selector.completed(this, SocketOperationRead);
+#else
+    if(_pending.fetch_add(1) == 0)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_threadPool);
+        if(!_destroyed)
+        {
+            _threadPool._selector.ready(this, SocketOperationRead, true);
+        }
+    }
+#endif
+}
+
+void
+IceInternal::ThreadPoolWorkQueue::drain(ThreadPool::EventHandlerThread* thread)
+{
+    //Lock sync(*this); Called with the thread pool locked
+    list<ThreadPoolWorkItemPtr> workItems;
+    thread->drain(workItems);
+    _pending.fetch_sub(static_cast<int>(workItems.size()));
+    _workItems.splice(_workItems.end(), workItems);
+}
+
+void
+IceInternal::ThreadPoolWorkQueue::updateObserver()
+{
+    //Lock sync(*this); Called with the thread pool locked
+    if(_destroyed)
+    {
+        return;
+    }
+
+    CommunicatorObserverI* communicatorObserver =
+        dynamic_cast<CommunicatorObserverI*>(_threadPool._instance->initializationData().observer.get());
+    ThreadPoolObserverIPtr observer;
+    if(communicatorObserver)
+    {
+        observer = communicatorObserver->getThreadPoolObserver(_threadPool._prefix);
+    }
+
+    if(observer != _observer)
+    {
+        if(_observer)
+        {
+            observe();
+            _observer->detach();
+        }
+        _observer = observer;
+        if(_observer)
+        {
+            _observer->attach();
+        }
+        _observedQueued = _queued.load();
+        _observedStolen = _stolen.load();
+    }
+}
+
+void
+IceInternal::ThreadPoolWorkQueue::observe()
+{
+    //Lock sync(*this); Called with the thread pool locked
+    if(_observer)
+    {
+        int queued = _queued.load();
+        int stolen = _stolen.load();
+        _observer->workStealing(queued - _observedQueued, stolen - _observedStolen, _pending.load(),
+                                _maxDepth.load());
+        _observedQueued = queued;
+        _observedStolen = stolen;
+    }
+}
+
+void
+IceInternal::ThreadPoolWorkQueue::trace() const
+{
+    if(_queued.load() > 0)
+    {
+        Trace out(_threadPool._instance->initializationData().logger,
+                  _threadPool._instance->traceLevels()->threadPoolCat);
+        out << "work stealing for " << _threadPool._prefix << ": queued = " << _queued.load() << ", stolen = "
+            << _stolen.load() << ", max queue depth = " << _maxDepth.load();
+    }
+}
+
+ThreadPoolWorkItemPtr
+IceInternal::ThreadPoolWorkQueue::steal(ThreadPool::EventHandlerThread* thief)
+{
+    //Lock sync(*this); Called with the thread pool locked
+    for(set<ThreadPool::EventHandlerThreadPtr>::const_iterator p = _threadPool._threads.begin();
+        p != _threadPool._threads.end(); ++p)
+    {
+        if(p->get() != thief)
+        {
+            ThreadPoolWorkItemPtr workItem = (*p)->dequeue();
+            if(workItem)
+            {
+                _stolen.fetch_add(1);
+                return workItem;
+            }
+        }
+    }
+    return 0;
+}
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
 bool
 IceInternal::ThreadPoolWorkQueue::startAsync(SocketOperation)
@@ -214,7 +453,23 @@ IceInternal::ThreadPoolWorkQueue::finishAsync(SocketOperation)
 void
 IceInternal::ThreadPoolWorkQueue::message(ThreadPoolCurrent& current)
 {
+    //
+    // With work stealing, the thread first executes the work items it
+    // dispatched, then the work items of the shared queue and finally
+    // steals the work items dispatched by the other threads.
+    //
     ThreadPoolWorkItemPtr workItem;
+    if(_threadPool._workStealing)
+    {
+        workItem = current._thread->dequeue();
+        if(workItem)
+        {
+            _pending.fetch_sub(1);
+        }
+    }
+
+    bool destroyed = false;
+    if(!workItem)
     {
         IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_threadPool);
         if(!_workItems.empty())
@@ -222,14 +477,23 @@ IceInternal::ThreadPoolWorkQueue::message(ThreadPoolCurrent& current)
             workItem = _workItems.front();
             _workItems.pop_front();
         }
+        else if(_pending.load() > 0)
+        {
+            workItem = steal(current._thread.get());
+            if(workItem)
+            {
+                _pending.fetch_sub(1);
+            }
+        }
+        destroyed = _destroyed;
+        observe();
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
-        else
+        if(!workItem && _destroyed)
         {
-            assert(_destroyed);
             _threadPool._selector.completed(this, SocketOperationRead);
         }
 #else
-        if(_workItems.empty() && !_destroyed)
+        if(_workItems.empty() && _pending.load() == 0 && !_destroyed)
         {
             _threadPool._selector.ready(this, SocketOperationRead, false);
         }
@@ -240,12 +504,15 @@ IceInternal::ThreadPoolWorkQueue::message(ThreadPoolCurrent& current)
     {
         workItem->execute(current);
     }
-    else
+    else if(destroyed)
     {
-        assert(_destroyed);
         current.ioCompleted();
         throw ThreadPoolDestroyedException();
     }
+    //
+    // Otherwise, another thread executed the work item that made the
+    // work queue ready.
+    //
 }
 
 void
@@ -288,12 +555,16 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _serverIdleTime(timeout),
     _threadIdleTime(0),
     _stackSize(0),
+    _workStealing(false),
+    _reservedThreads(0),
+    _normalPriorityQueueSizeMax(0),
     _inUse(0),
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     _inUseIO(0),
     _nextHandler(_handlers.end()),
 #endif
-    _promote(true)
+    _promote(true),
+    _normalPriority(0)
 {
     PropertiesPtr properties = _instance->initializationData().properties;
 #ifndef ICE_OS_UWP
@@ -407,14 +678,59 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         const_cast<int&>(_priority) = properties->getPropertyAsInt("Ice.ThreadPriority");
     }
 
+    //
+    // Work stealing is only used if the work items can be executed
+    // concurrently by several threads.
+    //
+    const_cast<bool&>(_workStealing) = properties->getPropertyAsInt(_prefix + ".WorkStealing") > 0 &&
+        _sizeMax > 1 && !_serialize;
+
+    //
+    // Reserving threads for high priority dispatches requires the
+    // pool to dispatch requests concurrently.
+    //
+    int reservedThreads = properties->getPropertyAsInt(_prefix + ".ReservedThreads");
+    if(reservedThreads > 0 && _serialize)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".ReservedThreads is ignored with " << _prefix << ".Serialize";
+        reservedThreads = 0;
+    }
+    else if(reservedThreads >= _sizeMax)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".ReservedThreads >= " << _prefix << ".SizeMax; ReservedThreads adjusted to SizeMax - 1 ("
+            << _sizeMax - 1 << ")";
+        reservedThreads = _sizeMax - 1;
+    }
+    const_cast<int&>(_reservedThreads) = max(reservedThreads, 0);
+    if(_reservedThreads > 0)
+    {
+        int queueSizeMax = properties->getPropertyAsIntWithDefault(_prefix + ".NormalPriorityQueueSizeMax", 1000);
+        const_cast<size_t&>(_normalPriorityQueueSizeMax) = static_cast<size_t>(max(queueSizeMax, 1));
+    }
+
     _workQueue = ICE_MAKE_SHARED(ThreadPoolWorkQueue, *this);
     _selector.initialize(_workQueue.get());
+    if(_workStealing)
+    {
+        _workQueue->updateObserver();
+    }
 
     if(_instance->traceLevels()->threadPool >= 1)
     {
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
         out << "creating " << _prefix << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = "
             << _sizeWarn;
+        if(_workStealing)
+        {
+            out << ", WorkStealing = 1";
+        }
+        if(_reservedThreads > 0)
+        {
+            out << ", ReservedThreads = " << _reservedThreads << ", NormalPriorityQueueSizeMax = "
+                << _normalPriorityQueueSizeMax;
+        }
     }
 
     __setNoDelete(true);
@@ -465,13 +781,34 @@ IceInternal::ThreadPool::~ThreadPool()
 void
 IceInternal::ThreadPool::destroy()
 {
-    Lock sync(*this);
-    if(_destroyed)
+    deque<DispatchWorkItemPtr> normalPriorityQueue;
     {
-        return;
+        Lock sync(*this);
+        if(_destroyed)
+        {
+            return;
+        }
+        _destroyed = true;
+        _workQueue->destroy();
+
+        if(_workStealing && _instance->traceLevels()->threadPool >= 1)
+        {
+            _workQueue->trace();
+        }
+
+        _normalPriorityQueue.swap(normalPriorityQueue);
+        _normalPrioritySuspended.clear();
+    }
+
+    //
+    // The queued normal priority dispatches are failed outside the
+    // synchronization, this locks their connection.
+    //
+    CommunicatorDestroyedException ex(__FILE__, __LINE__);
+    for(deque<DispatchWorkItemPtr>::const_iterator p = normalPriorityQueue.begin(); p != normalPriorityQueue.end(); ++p)
+    {
+        (*p)->cancel(ex);
     }
-    _destroyed = true;
-    _workQueue->destroy();
 }
 
 void
@@ -482,6 +819,10 @@ IceInternal::ThreadPool::updateObservers()
     {
         (*p)->updateObserver();
     }
+    if(_workStealing)
+    {
+        _workQueue->updateObserver();
+    }
 }
 
 void
@@ -621,6 +962,21 @@ IceInternal::ThreadPool::dispatchFromThisThread(const DispatchWorkItemPtr& workI
 void
 IceInternal::ThreadPool::dispatch(const DispatchWorkItemPtr& workItem)
 {
+    if(_workStealing)
+    {
+        //
+        // Work items dispatched by a thread of this pool are queued
+        // with the thread, other threads of the pool steal them if
+        // they are idle.
+        //
+        EventHandlerThread* thread = static_cast<EventHandlerThread*>(currentThread.get());
+        if(thread && thread->pool() == this)
+        {
+            _workQueue->queue(thread, workItem);
+            return;
+        }
+    }
+
     Lock sync(*this);
     if(_destroyed)
     {
@@ -629,6 +985,98 @@ IceInternal::ThreadPool::dispatch(const DispatchWorkItemPtr& workItem)
     _workQueue->queue(workItem);
 }
 
+bool
+IceInternal::ThreadPool::startNormalPriority()
+{
+    assert(_reservedThreads > 0);
+    Lock sync(*this);
+    if(_normalPriority < _sizeMax - _reservedThreads)
+    {
+        ++_normalPriority;
+        return true;
+    }
+    return false;
+}
+
+void
+IceInternal::ThreadPool::queueNormalPriority(const DispatchWorkItemPtr& workItem)
+{
+    {
+        Lock sync(*this);
+        if(!_destroyed)
+        {
+            //
+            // A normal priority dispatch might have completed since the
+            // call to startNormalPriority, in which case the work item is
+            // executed right away by another thread.
+            //
+            if(_normalPriority < _sizeMax - _reservedThreads)
+            {
+                ++_normalPriority;
+                _workQueue->queue(new NormalPriorityWorkItem(*this, workItem));
+            }
+            else
+            {
+                _normalPriorityQueue.push_back(workItem);
+            }
+            return;
+        }
+    }
+    workItem->cancel(CommunicatorDestroyedException(__FILE__, __LINE__));
+}
+
+void
+IceInternal::ThreadPool::finishNormalPriority()
+{
+    vector<ConnectionIPtr> connections;
+    {
+        Lock sync(*this);
+        assert(_normalPriority > 0);
+        if(!_normalPriorityQueue.empty())
+        {
+            //
+            // The queued dispatch takes over the slot of the completed
+            // dispatch.
+            //
+            assert(!_destroyed);
+            _workQueue->queue(new NormalPriorityWorkItem(*this, _normalPriorityQueue.front()));
+            _normalPriorityQueue.pop_front();
+        }
+        else
+        {
+            --_normalPriority;
+        }
+
+        if(_normalPriorityQueue.size() < _normalPriorityQueueSizeMax)
+        {
+            _normalPrioritySuspended.swap(connections);
+        }
+    }
+
+    for(vector<ConnectionIPtr>::const_iterator p = connections.begin(); p != connections.end(); ++p)
+    {
+        (*p)->resumeNormalPriorityDispatches();
+    }
+}
+
+bool
+IceInternal::ThreadPool::suspendNormalPriorityReading(const ConnectionIPtr& connection)
+{
+    //
+    // Called by the connection with its mutex locked, the connection
+    // stops reading if the normal priority queue is full. It's resumed
+    // by finishNormalPriority once queued dispatches are started.
+    //
+    assert(_reservedThreads > 0);
+    Lock sync(*this);
+    if(!_destroyed && _normalPriorityQueue.size() >= _normalPriorityQueueSizeMax)
+    {
+        _normalPrioritySuspended.push_back(connection);
+        return true;
+    }
+    return false;
+}
+
 void
 IceInternal::ThreadPool::joinWithAllThreads()
 {
@@ -852,6 +1300,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
                         out << "shrinking " << _prefix << ": Size = " << (_threads.size() - 1);
                     }
+                    _workQueue->drain(thread.get());
                     _threads.erase(thread);
                     _workQueue->queue(new JoinThreadWorkItem(thread));
                     return;
@@ -1176,6 +1625,7 @@ IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
                         out << "shrinking " << _prefix << ": Size=" << (_threads.size() - 1);
                     }
                     assert(_threads.size() > 1); // Can only be called by a waiting follower thread.
+                    _workQueue->drain(current._thread.get());
                     _threads.erase(current._thread);
                     _workQueue->queue(new JoinThreadWorkItem(current._thread));
                     return true;
@@ -1234,6 +1684,35 @@ IceInternal::ThreadPool::EventHandlerThread::setState(Ice::Instrumentation::Thre
     _state = s;
 }
 
+size_t
+IceInternal::ThreadPool::EventHandlerThread::queue(const ThreadPoolWorkItemPtr& workItem)
+{
+    IceUtil::Mutex::Lock sync(_workItemsMutex);
+    _workItems.push_back(workItem);
+    return _workItems.size();
+}
+
+ThreadPoolWorkItemPtr
+IceInternal::ThreadPool::EventHandlerThread::dequeue()
+{
+    IceUtil::Mutex::Lock sync(_workItemsMutex);
+    if(_workItems.empty())
+    {
+        return 0;
+    }
+    ThreadPoolWorkItemPtr workItem = _workItems.front();
+    _workItems.pop_front();
+    return workItem;
+}
+
+void
+IceInternal::ThreadPool::EventHandlerThread::drain(list<ThreadPoolWorkItemPtr>& workItems)
+{
+    IceUtil::Mutex::Lock sync(_workItemsMutex);
+    workItems.insert(workItems.end(), _workItems.begin(), _workItems.end());
+    _workItems.clear();
+}
+
 void
 IceInternal::ThreadPool::EventHandlerThread::run()
 {
@@ -1263,6 +1742,7 @@ IceInternal::ThreadPool::EventHandlerThread::run()
         }
     }
 
+    currentThread.set(this);
     try
     {
         _pool->run(this);
@@ -1278,6 +1758,7 @@ IceInternal::ThreadPool::EventHandlerThread::run()
         out << "unknown exception in `" << _pool->_prefix << "'";
     }
 
+    currentThread.set(0);
     _observer.detach();
 
 #ifdef ICE_CPP11_MAPPING
@@ -9,10 +9,12 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Thread.h>
+#include <IceUtil/Atomic.h>
 
 #include <Ice/Config.h>
 #include <Ice/Dispatcher.h>
 #include <Ice/ThreadPoolF.h>
+#include <Ice/ConnectionIF.h>
 #include <Ice/InstanceF.h>
 #include <Ice/LoggerF.h>
 #include <Ice/PropertiesF.h>
@@ -23,10 +25,14 @@
 
 #include <set>
 #include <list>
+#include <deque>
 
 namespace IceInternal
 {
 
+class ThreadPoolObserverI;
+ICE_DEFINE_PTR(ThreadPoolObserverIPtr, ThreadPoolObserverI);
+
 class ThreadPoolCurrent;
 
 class ThreadPoolWorkQueue;
@@ -53,6 +59,14 @@ public:
         return _connection;
     }
 
+    //
+    // Called instead of run() if the work item is discarded.
+    //
+    virtual void
+    cancel(const Ice::LocalException&)
+    {
+    }
+
 private:
 
     virtual void execute(ThreadPoolCurrent&);
@@ -73,11 +87,28 @@ class ThreadPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mut
         void updateObserver();
         void setState(Ice::Instrumentation::ThreadState);
 
+        ThreadPool* pool() const
+        {
+            return _pool.get();
+        }
+
+        //
+        // The work items dispatched by this thread when work stealing
+        // is enabled. The items are executed by this thread or stolen
+        // by the other threads of the pool.
+        //
+        size_t queue(const ThreadPoolWorkItemPtr&);
+        ThreadPoolWorkItemPtr dequeue();
+        void drain(std::list<ThreadPoolWorkItemPtr>&);
+
     private:
 
         ThreadPoolPtr _pool;
         ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
         Ice::Instrumentation::ThreadState _state;
+
+        IceUtil::Mutex _workItemsMutex;
+        std::deque<ThreadPoolWorkItemPtr> _workItems;
     };
     typedef IceUtil::Handle<EventHandlerThread> EventHandlerThreadPtr;
 
@@ -106,6 +137,31 @@ public:
     void dispatchFromThisThread(const DispatchWorkItemPtr&);
     void dispatch(const DispatchWorkItemPtr&);
 
+    //
+    // With work stealing, the work items dispatched by a thread of the
+    // pool are queued with the thread.
+    //
+    bool workStealing() const
+    {
+        return _workStealing;
+    }
+
+    //
+    // Priority lanes: if threads are reserved for high priority
+    // dispatches, normal priority dispatches must be started with
+    // startNormalPriority and are queued if all the non-reserved
+    // threads are dispatching normal priority requests. Connections
+    // stop reading while the queue is full.
+    //
+    bool hasReservedThreads() const
+    {
+        return _reservedThreads > 0;
+    }
+    bool startNormalPriority();
+    void queueNormalPriority(const DispatchWorkItemPtr&);
+    void finishNormalPriority();
+    bool suspendNormalPriorityReading(const Ice::ConnectionIPtr&);
+
     void joinWithAllThreads();
 
     std::string prefix() const;
@@ -160,6 +216,9 @@ private:
     const int _serverIdleTime;
     const int _threadIdleTime;
     const size_t _stackSize;
+    const bool _workStealing; // True if dispatch work items are queued with the dispatching thread.
+    const int _reservedThreads; // Number of threads reserved for high priority dispatches.
+    const size_t _normalPriorityQueueSizeMax; // Connections stop reading when this many dispatches are queued.
 
     std::set<EventHandlerThreadPtr> _threads; // All threads, running or not.
     int _inUse; // Number of threads that are currently in use.
@@ -170,6 +229,10 @@ private:
 #endif
 
     bool _promote;
+
+    int _normalPriority; // Number of normal priority dispatches in progress.
+    std::deque<DispatchWorkItemPtr> _normalPriorityQueue;
+    std::vector<Ice::ConnectionIPtr> _normalPrioritySuspended;
 };
 
 class ThreadPoolCurrent
@@ -221,6 +284,7 @@ private:
     int _error;
 #endif
     friend class ThreadPool;
+    friend class ThreadPoolWorkQueue;
 };
 
 class ThreadPoolWorkQueue : public EventHandler
@@ -231,6 +295,10 @@ public:
 
     void destroy();
     void queue(const ThreadPoolWorkItemPtr&);
+    void queue(ThreadPool::EventHandlerThread*, const ThreadPoolWorkItemPtr&);
+    void drain(ThreadPool::EventHandlerThread*);
+    void trace() const;
+    void updateObserver();
 
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
     bool startAsync(SocketOperation);
@@ -244,9 +312,37 @@ public:
 
 private:
 
+    ThreadPoolWorkItemPtr steal(ThreadPool::EventHandlerThread*);
+    void observe();
+
     ThreadPool& _threadPool;
     bool _destroyed;
     std::list<ThreadPoolWorkItemPtr> _workItems;
+
+    //
+    // Work stealing counters: the number of work items queued with the
+    // threads that are not yet executed, the number of work items
+    // queued with the threads, the number of work items stolen and
+    // the maximum number of work items queued with a thread.
+    //
+    IceUtilInternal::Atomic _pending;
+    IceUtilInternal::Atomic _queued;
+    IceUtilInternal::Atomic _stolen;
+    IceUtilInternal::Atomic _maxDepth;
+
+    //
+    // Set once destroyed, it's checked without the thread pool locked
+    // before queuing a work item with a thread.
+    //
+    IceUtilInternal::Atomic _closed;
+
+    //
+    // The metrics observer and the counters it last recorded, only
+    // used with the thread pool locked.
+    //
+    ThreadPoolObserverIPtr _observer;
+    int _observedQueued;
+    int _observedStolen;
 };
 
 //
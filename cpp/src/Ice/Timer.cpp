@@ -4,12 +4,468 @@
 
 #include <IceUtil/Timer.h>
 #include <IceUtil/Exception.h>
+#include <IceUtil/Atomic.h>
 #include <Ice/ConsoleUtil.h>
 
 using namespace std;
 using namespace IceUtil;
 using namespace IceInternal;
 
+namespace IceUtilInternal
+{
+
+struct TimingWheelEntry
+{
+    TimingWheelEntry(TimingWheel* w = 0) : wheel(w), expiration(0), prev(this), next(this), taskNext(0)
+    {
+    }
+
+    TimingWheel* const wheel;
+    TimerTaskPtr task;
+    IceUtil::Time delay; // The delay of a repeated task, or zero.
+    IceUtil::Int64 expiration; // The expiration tick.
+    TimingWheelEntry* prev;
+    TimingWheelEntry* next;
+    TimingWheelEntry* taskNext; // The next entry of the task, for another timer.
+};
+
+//
+// Hashed hierarchical timing wheel. The time is divided into ticks of
+// the wheel resolution and each level of the wheel has 64 slots: the
+// slots of level 0 hold the entries expiring in the next 64 ticks, the
+// slots of level 1 the entries expiring in the next 4096 ticks, etc.
+// Entries are moved down to the lower level when the lower level wraps
+// around. The timing wheel isn't thread safe, it's protected by the timer
+// monitor.
+//
+// The entries of a task are linked from the task, so finding the entry
+// of a task doesn't require a lookup in the wheel. A task usually has a
+// single entry, unless it's scheduled with several timing wheel timers.
+//
+class TimingWheel : private IceUtil::noncopyable
+{
+public:
+
+    TimingWheel(const IceUtil::Time&);
+    ~TimingWheel();
+
+    bool schedule(const TimerTaskPtr&, const IceUtil::Time&, const IceUtil::Time&, bool, IceUtil::Time&);
+    bool cancel(const TimerTaskPtr&);
+
+    TimerTaskPtr expired(const IceUtil::Time&, IceUtil::Time&);
+    void reschedule(const IceUtil::Time&);
+
+    bool empty() const;
+    IceUtil::Time wakeUpTime() const;
+    void clear();
+
+private:
+
+    enum { Levels = 4, SlotBits = 6, Slots = 1 << SlotBits };
+
+    IceUtil::Int64 toTick(const IceUtil::Time&, bool) const;
+    IceUtil::Time toTime(IceUtil::Int64) const;
+    void add(TimingWheelEntry*);
+    void cascade(int, int);
+    void destroy(TimingWheelEntry*);
+
+    TimingWheelEntry* find(TimerTask*);
+    bool attach(TimingWheelEntry*);
+    void detach(TimingWheelEntry*);
+
+    static void link(TimingWheelEntry*, TimingWheelEntry*);
+    static void unlink(TimingWheelEntry*);
+
+    const IceUtil::Time _start;
+    const IceUtil::Int64 _resolution;
+    IceUtil::Int64 _tick; // The next tick to process.
+    size_t _size;
+    TimingWheelEntry _slots[Levels][Slots];
+    TimingWheelEntry _expired;
+    TimingWheelEntry* _running; // The entry of the repeated task being run.
+};
+
+}
+
+using namespace IceUtilInternal;
+
+namespace
+{
+
+//
+// Spin lock for the timing wheel entries of a task. It's only held while
+// the short list of entries of the task is updated or searched.
+//
+class TaskEntriesLock
+{
+public:
+
+    TaskEntriesLock(IceUtilInternal::Atomic& lock) : _lock(lock)
+    {
+        while(_lock.exchange(1) != 0)
+        {
+            ThreadControl::yield();
+        }
+    }
+
+    ~TaskEntriesLock()
+    {
+        _lock.exchange(0);
+    }
+
+private:
+
+    IceUtilInternal::Atomic& _lock;
+};
+
+}
+
+TimingWheel::TimingWheel(const IceUtil::Time& resolution) :
+    _start(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+    _resolution(resolution.toMicroSeconds()),
+    _tick(0),
+    _size(0),
+    _running(0)
+{
+    assert(_resolution > 0);
+}
+
+TimingWheel::~TimingWheel()
+{
+    clear();
+}
+
+bool
+TimingWheel::schedule(const TimerTaskPtr& task, const IceUtil::Time& now, const IceUtil::Time& delay, bool repeated,
+                      IceUtil::Time& time)
+{
+    if(_size == 0)
+    {
+        //
+        // Skip the ticks elapsed while the wheel was empty.
+        //
+        _tick = max(_tick, toTick(now, false));
+    }
+
+    TimingWheelEntry* entry = new TimingWheelEntry(this);
+    entry->task = task;
+    if(!attach(entry))
+    {
+        delete entry;
+        return false;
+    }
+    entry->delay = repeated ? delay : IceUtil::Time();
+    entry->expiration = toTick(now + delay, true);
+    add(entry);
+    time = toTime(max(entry->expiration, _tick));
+    return true;
+}
+
+bool
+TimingWheel::cancel(const TimerTaskPtr& task)
+{
+    TimingWheelEntry* entry = find(task.get());
+    if(!entry)
+    {
+        return false;
+    }
+
+    if(entry == _running)
+    {
+        _running = 0; // Don't reschedule the task once it's done running.
+    }
+    else
+    {
+        unlink(entry);
+        --_size;
+    }
+    detach(entry);
+    delete entry;
+    return true;
+}
+
+TimerTaskPtr
+TimingWheel::expired(const IceUtil::Time& now, IceUtil::Time& delay)
+{
+    const IceUtil::Int64 current = toTick(now, false);
+    if(_size == 0)
+    {
+        _tick = max(_tick, current);
+        return ICE_NULLPTR;
+    }
+
+    while(_expired.next == &_expired && _tick <= current)
+    {
+        //
+        // Cascade the entries from the upper levels when a level wraps around
+        // and move the entries of the tick slot to the expired list.
+        //
+        int index = static_cast<int>(_tick & (Slots - 1));
+        for(int level = 1; level < Levels && index == 0; ++level)
+        {
+            index = static_cast<int>((_tick >> (SlotBits * level)) & (Slots - 1));
+            cascade(level, index);
+        }
+
+        TimingWheelEntry* slot = &_slots[0][_tick & (Slots - 1)];
+        while(slot->next != slot)
+        {
+            TimingWheelEntry* entry = slot->next;
+            unlink(entry);
+            link(&_expired, entry);
+        }
+        ++_tick;
+    }
+
+    if(_expired.next == &_expired)
+    {
+        return ICE_NULLPTR;
+    }
+
+    TimingWheelEntry* entry = _expired.next;
+    unlink(entry);
+    --_size;
+
+    TimerTaskPtr task = entry->task;
+    delay = entry->delay;
+    if(delay == IceUtil::Time())
+    {
+        detach(entry);
+        delete entry;
+    }
+    else
+    {
+        _running = entry;
+    }
+    return task;
+}
+
+void
+TimingWheel::reschedule(const IceUtil::Time& now)
+{
+    if(_running)
+    {
+        if(_size == 0)
+        {
+            _tick = max(_tick, toTick(now, false));
+        }
+        _running->expiration = toTick(now + _running->delay, true);
+        add(_running);
+        _running = 0;
+    }
+}
+
+bool
+TimingWheel::empty() const
+{
+    return _size == 0;
+}
+
+IceUtil::Time
+TimingWheel::wakeUpTime() const
+{
+    //
+    // Returns the time of the next non-empty slot of the lowest level or the
+    // time at which the lowest level wraps around and the entries of the upper
+    // levels are cascaded, whichever comes first.
+    //
+    IceUtil::Int64 tick = _tick;
+    if((tick & (Slots - 1)) != 0)
+    {
+        while((tick & (Slots - 1)) != 0 && _slots[0][tick & (Slots - 1)].next == &_slots[0][tick & (Slots - 1)])
+        {
+            ++tick;
+        }
+    }
+    return toTime(tick);
+}
+
+void
+TimingWheel::clear()
+{
+    for(int level = 0; level < Levels; ++level)
+    {
+        for(int index = 0; index < Slots; ++index)
+        {
+            destroy(&_slots[level][index]);
+        }
+    }
+    destroy(&_expired);
+    if(_running)
+    {
+        detach(_running);
+        delete _running;
+        _running = 0;
+    }
+    _size = 0;
+}
+
+IceUtil::Int64
+TimingWheel::toTick(const IceUtil::Time& time, bool roundUp) const
+{
+    IceUtil::Int64 elapsed = (time - _start).toMicroSeconds();
+    if(elapsed <= 0)
+    {
+        return 0;
+    }
+    return roundUp ? (elapsed + _resolution - 1) / _resolution : elapsed / _resolution;
+}
+
+IceUtil::Time
+TimingWheel::toTime(IceUtil::Int64 tick) const
+{
+    return _start + IceUtil::Time::microSeconds(tick * _resolution);
+}
+
+void
+TimingWheel::add(TimingWheelEntry* entry)
+{
+    IceUtil::Int64 expiration = max(entry->expiration, _tick);
+    IceUtil::Int64 ticks = expiration - _tick;
+
+    int level = 0;
+    while(level < Levels - 1 && ticks >= (ICE_INT64(1) << (SlotBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    if(ticks >= (ICE_INT64(1) << (SlotBits * Levels)))
+    {
+        //
+        // The expiration is beyond the range of the wheel, the entry is added
+        // to the farthest slot and will be added again when cascaded.
+        //
+        expiration = _tick + (ICE_INT64(1) << (SlotBits * Levels)) - 1;
+    }
+
+    link(&_slots[level][(expiration >> (SlotBits * level)) & (Slots - 1)], entry);
+    ++_size;
+}
+
+void
+TimingWheel::cascade(int level, int index)
+{
+    TimingWheelEntry* slot = &_slots[level][index];
+    TimingWheelEntry list(this);
+    while(slot->next != slot)
+    {
+        TimingWheelEntry* entry = slot->next;
+        unlink(entry);
+        link(&list, entry);
+    }
+    while(list.next != &list)
+    {
+        TimingWheelEntry* entry = list.next;
+        unlink(entry);
+        --_size;
+        add(entry);
+    }
+}
+
+void
+TimingWheel::destroy(TimingWheelEntry* list)
+{
+    while(list->next != list)
+    {
+        TimingWheelEntry* entry = list->next;
+        unlink(entry);
+        detach(entry);
+        delete entry;
+    }
+}
+
+TimingWheelEntry*
+TimingWheel::find(TimerTask* task)
+{
+    TaskEntriesLock sync(task->_timingWheelLock);
+    for(TimingWheelEntry* entry = task->_timingWheelEntries; entry; entry = entry->taskNext)
+    {
+        if(entry->wheel == this)
+        {
+            return entry;
+        }
+    }
+    return 0;
+}
+
+bool
+TimingWheel::attach(TimingWheelEntry* entry)
+{
+    TimerTask* task = entry->task.get();
+    TaskEntriesLock sync(task->_timingWheelLock);
+    for(TimingWheelEntry* p = task->_timingWheelEntries; p; p = p->taskNext)
+    {
+        if(p->wheel == this)
+        {
+            return false; // Already scheduled with this timer.
+        }
+    }
+    entry->taskNext = task->_timingWheelEntries;
+    task->_timingWheelEntries = entry;
+    return true;
+}
+
+void
+TimingWheel::detach(TimingWheelEntry* entry)
+{
+    TimerTask* task = entry->task.get();
+    TaskEntriesLock sync(task->_timingWheelLock);
+    for(TimingWheelEntry** p = &task->_timingWheelEntries; *p; p = &(*p)->taskNext)
+    {
+        if(*p == entry)
+        {
+            *p = entry->taskNext;
+            break;
+        }
+    }
+    entry->taskNext = 0;
+}
+
+void
+TimingWheel::link(TimingWheelEntry* list, TimingWheelEntry* entry)
+{
+    entry->prev = list->prev;
+    entry->next = list;
+    list->prev->next = entry;
+    list->prev = entry;
+}
+
+void
+TimingWheel::unlink(TimingWheelEntry* entry)
+{
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry->prev = entry;
+    entry->next = entry;
+}
+
+TimerTask::TimerTask() :
+    _timingWheelEntries(0),
+    _timingWheelLock(0)
+{
+}
+
+TimerTask::TimerTask(const TimerTask&) :
+#ifndef ICE_CPP11_MAPPING
+    IceUtil::Shared(),
+#endif
+    _timingWheelEntries(0),
+    _timingWheelLock(0)
+{
+    //
+    // The copy isn't scheduled with the timers of the original task.
+    //
+}
+
+TimerTask&
+TimerTask::operator=(const TimerTask&)
+{
+    //
+    // The timing wheel entries are specific to each task, they aren't assigned.
+    //
+    return *this;
+}
+
 TimerTask::~TimerTask()
 {
     // Out of line to avoid weak vtable
@@ -17,7 +473,8 @@ TimerTask::~TimerTask()
 
 Timer::Timer() :
     Thread("IceUtil timer thread"),
-    _destroyed(false)
+    _destroyed(false),
+    _wheel(0)
 {
     __setNoDelete(true);
     start();
@@ -26,13 +483,55 @@ Timer::Timer() :
 
 Timer::Timer(int priority) :
     Thread("IceUtil timer thread"),
-    _destroyed(false)
+    _destroyed(false),
+    _wheel(0)
 {
     __setNoDelete(true);
     start(0, priority);
     __setNoDelete(false);
 }
 
+Timer::Timer(const IceUtil::Time& resolution) :
+    Thread("IceUtil timer thread"),
+    _destroyed(false),
+    _wheel(0)
+{
+    if(resolution <= IceUtil::Time())
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "invalid resolution");
+    }
+    _wheel = new TimingWheel(resolution);
+
+    __setNoDelete(true);
+    start();
+    __setNoDelete(false);
+}
+
+Timer::Timer(const IceUtil::Time& resolution, int priority) :
+    Thread("IceUtil timer thread"),
+    _destroyed(false),
+    _wheel(0)
+{
+    if(resolution <= IceUtil::Time())
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "invalid resolution");
+    }
+    _wheel = new TimingWheel(resolution);
+
+    __setNoDelete(true);
+    start(0, priority);
+    __setNoDelete(false);
+}
+
+Timer::~Timer()
+{
+    //
+    // The timer thread no longer uses the timing wheel once the timer
+    // is destroyed, even if it's still running the task calling destroy.
+    //
+    delete _wheel;
+}
+
 void
 Timer::destroy()
 {
@@ -46,6 +545,10 @@ Timer::destroy()
         _monitor.notify();
         _tasks.clear();
         _tokens.clear();
+        if(_wheel)
+        {
+            _wheel->clear();
+        }
     }
 
     if(getThreadControl() == ThreadControl())
@@ -74,6 +577,20 @@ Timer::schedule(const TimerTaskPtr& task, const IceUtil::Time& delay)
         throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
     }
 
+    if(_wheel)
+    {
+        if(!_wheel->schedule(task, now, delay, false, time))
+        {
+            throw IllegalArgumentException(__FILE__, __LINE__, "task is already scheduled");
+        }
+
+        if(_wakeUpTime == IceUtil::Time() || time < _wakeUpTime)
+        {
+            _monitor.notify();
+        }
+        return;
+    }
+
     bool inserted = _tasks.insert(make_pair(task, time)).second;
     if(!inserted)
     {
@@ -103,6 +620,21 @@ Timer::scheduleRepeated(const TimerTaskPtr& task, const IceUtil::Time& delay)
         throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
     }
 
+    if(_wheel)
+    {
+        IceUtil::Time time;
+        if(!_wheel->schedule(task, now, delay, true, time))
+        {
+            throw IllegalArgumentException(__FILE__, __LINE__, "task is already scheduled");
+        }
+
+        if(_wakeUpTime == IceUtil::Time() || time < _wakeUpTime)
+        {
+            _monitor.notify();
+        }
+        return;
+    }
+
     bool inserted = _tasks.insert(make_pair(task, token.scheduledTime)).second;
     if(!inserted)
     {
@@ -125,6 +657,11 @@ Timer::cancel(const TimerTaskPtr& task)
         return false;
     }
 
+    if(_wheel)
+    {
+        return _wheel->cancel(task);
+    }
+
     map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare>::iterator p = _tasks.find(task);
     if(p == _tasks.end())
     {
@@ -140,6 +677,12 @@ Timer::cancel(const TimerTaskPtr& task)
 void
 Timer::run()
 {
+    if(_wheel)
+    {
+        runWheel();
+        return;
+    }
+
     Token token(IceUtil::Time(), IceUtil::Time(), 0);
     while(true)
     {
@@ -222,26 +765,7 @@ Timer::run()
 
         if(token.task)
         {
-            try
-            {
-                runTimerTask(token.task);
-            }
-            catch(const IceUtil::Exception& e)
-            {
-                consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what();
-#ifdef __GNUC__
-                consoleErr << "\n" << e.ice_stackTrace();
-#endif
-                consoleErr << endl;
-            }
-            catch(const std::exception& e)
-            {
-                consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what() << endl;
-            }
-            catch(...)
-            {
-                consoleErr << "IceUtil::Timer::run(): uncaught exception" << endl;
-            }
+            runTask(token.task);
 
             if(token.delay == IceUtil::Time())
             {
@@ -256,6 +780,96 @@ Timer::run()
     }
 }
 
+void
+Timer::runWheel()
+{
+    TimingWheel* wheel = _wheel;
+    TimerTaskPtr task;
+    IceUtil::Time delay;
+    while(true)
+    {
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+
+            //
+            // If the task we just ran is a repeated task, schedule it again
+            // for execution if it wasn't canceled.
+            //
+            if(!_destroyed && delay != IceUtil::Time())
+            {
+                wheel->reschedule(IceUtil::Time::now(IceUtil::Time::Monotonic));
+            }
+
+            while(!_destroyed)
+            {
+                const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                task = wheel->expired(now, delay);
+                if(task)
+                {
+                    break;
+                }
+
+                //
+                // Sleep until the next tick with tasks to run or the next
+                // cascade of the upper levels of the wheel.
+                //
+                if(wheel->empty())
+                {
+                    _wakeUpTime = IceUtil::Time();
+                    _monitor.wait();
+                }
+                else
+                {
+                    _wakeUpTime = wheel->wakeUpTime();
+                    if(_wakeUpTime > now)
+                    {
+                        _monitor.timedWait(_wakeUpTime - now);
+                    }
+                }
+            }
+
+            if(_destroyed)
+            {
+                break;
+            }
+        }
+
+        runTask(task);
+
+        //
+        // Clear the task reference outside the synchronization block, see
+        // the comment in run() above. The timing wheel keeps a reference on
+        // repeated tasks.
+        //
+        task = ICE_NULLPTR;
+    }
+}
+
+void
+Timer::runTask(const TimerTaskPtr& task)
+{
+    try
+    {
+        runTimerTask(task);
+    }
+    catch(const IceUtil::Exception& e)
+    {
+        consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what();
+#ifdef __GNUC__
+        consoleErr << "\n" << e.ice_stackTrace();
+#endif
+        consoleErr << endl;
+    }
+    catch(const std::exception& e)
+    {
+        consoleErr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what() << endl;
+    }
+    catch(...)
+    {
+        consoleErr << "IceUtil::Timer::run(): uncaught exception" << endl;
+    }
+}
+
 void
 Timer::runTimerTask(const TimerTaskPtr& task)
 {
@@ -25,7 +25,9 @@ IceInternal::TraceLevels::TraceLevels(const PropertiesPtr& properties) :
     gc(0),
     gcCat("GC"),
     threadPool(0),
-    threadPoolCat("ThreadPool")
+    threadPoolCat("ThreadPool"),
+    acm(0),
+    acmCat("ACM")
 {
     const string keyBase = "Ice.Trace.";
     const_cast<int&>(network) = properties->getPropertyAsInt(keyBase + networkCat);
@@ -35,4 +37,5 @@ IceInternal::TraceLevels::TraceLevels(const PropertiesPtr& properties) :
     const_cast<int&>(slicing) = properties->getPropertyAsInt(keyBase + slicingCat);
     const_cast<int&>(gc) = properties->getPropertyAsInt(keyBase + gcCat);
     const_cast<int&>(threadPool) = properties->getPropertyAsInt(keyBase + threadPoolCat);
+    const_cast<int&>(acm) = properties->getPropertyAsInt(keyBase + acmCat);
 }
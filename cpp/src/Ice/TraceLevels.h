@@ -38,6 +38,9 @@ public:
 
     const int threadPool;
     const char* threadPoolCat;
+
+    const int acm;
+    const char* acmCat;
 };
 
 }
@@ -12,6 +12,7 @@
 #include <Ice/Logger.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Network.h>
+#include <Ice/SHA1.h>
 
 using namespace std;
 using namespace IceSSL;
@@ -19,19 +20,25 @@ using namespace IceSSL;
 IceUtil::Shared* IceSSL::upCast(IceSSL::TrustManager* p) { return p; }
 
 TrustManager::TrustManager(const Ice::CommunicatorPtr& communicator) :
-    _communicator(communicator)
+    _communicator(communicator),
+    _cacheSize(static_cast<size_t>(
+        max(0, communicator->getProperties()->getPropertyAsIntWithDefault("IceSSL.TrustOnly.CacheSize", 1024))))
 {
     Ice::PropertiesPtr properties = communicator->getProperties();
     _traceLevel = properties->getPropertyAsInt("IceSSL.Trace.Security");
+
+    list<DistinguishedName> rejectAll, rejectClient, rejectAllServer;
+    list<DistinguishedName> acceptAll, acceptClient, acceptAllServer;
+    map<string, list<DistinguishedName> > rejectServer, acceptServer;
     string key;
     try
     {
         key = "IceSSL.TrustOnly";
-        parse(properties->getProperty(key), _rejectAll, _acceptAll);
+        parse(properties->getProperty(key), rejectAll, acceptAll);
         key = "IceSSL.TrustOnly.Client";
-        parse(properties->getProperty(key), _rejectClient, _acceptClient);
+        parse(properties->getProperty(key), rejectClient, acceptClient);
         key = "IceSSL.TrustOnly.Server";
-        parse(properties->getProperty(key), _rejectAllServer, _acceptAllServer);
+        parse(properties->getProperty(key), rejectAllServer, acceptAllServer);
         Ice::PropertyDict dict = properties->getPropertiesForPrefix("IceSSL.TrustOnly.Server.");
         for(Ice::PropertyDict::const_iterator p = dict.begin(); p != dict.end(); ++p)
         {
@@ -41,11 +48,11 @@ TrustManager::TrustManager(const Ice::CommunicatorPtr& communicator) :
             parse(p->second, reject, accept);
             if(!reject.empty())
             {
-                _rejectServer[name] = reject;
+                rejectServer[name] = reject;
             }
             if(!accept.empty())
             {
-                _acceptServer[name] = accept;
+                acceptServer[name] = accept;
             }
         }
     }
@@ -54,71 +61,67 @@ TrustManager::TrustManager(const Ice::CommunicatorPtr& communicator) :
         throw Ice::PluginInitializationException(__FILE__, __LINE__, "IceSSL: invalid property " + key  + ":\n" +
                                                  ex.reason);
     }
-}
 
-bool
-TrustManager::verify(const ConnectionInfoPtr& info, const std::string& desc)
-{
-    list<list<DistinguishedName> > reject, accept;
-
-    if(_rejectAll.size() > 0)
+    //
+    // Compute the rules for outgoing connections, incoming connections and
+    // incoming connections for each adapter with adapter specific rules.
+    // The order of the rule lists is the order in which they are evaluated.
+    //
+    if(!rejectAll.empty())
     {
-        reject.push_back(_rejectAll);
+        _clientRules.reject.push_back(rejectAll);
+        _serverRules.reject.push_back(rejectAll);
     }
-    if(info->incoming)
+    if(!rejectClient.empty())
     {
-        if(_rejectAllServer.size() > 0)
-        {
-            reject.push_back(_rejectAllServer);
-        }
-        if(info->adapterName.size() > 0)
-        {
-            map<string, list<DistinguishedName> >::const_iterator p = _rejectServer.find(info->adapterName);
-            if(p != _rejectServer.end())
-            {
-                reject.push_back(p->second);
-            }
-        }
+        _clientRules.reject.push_back(rejectClient);
     }
-    else
+    if(!rejectAllServer.empty())
     {
-        if(_rejectClient.size() > 0)
-        {
-            reject.push_back(_rejectClient);
-        }
+        _serverRules.reject.push_back(rejectAllServer);
     }
 
-    if(_acceptAll.size() > 0)
+    if(!acceptAll.empty())
     {
-        accept.push_back(_acceptAll);
+        _clientRules.accept.push_back(acceptAll);
+        _serverRules.accept.push_back(acceptAll);
     }
-    if(info->incoming)
+    if(!acceptClient.empty())
     {
-        if(_acceptAllServer.size() > 0)
-        {
-            accept.push_back(_acceptAllServer);
-        }
-        if(info->adapterName.size() > 0)
+        _clientRules.accept.push_back(acceptClient);
+    }
+    if(!acceptAllServer.empty())
+    {
+        _serverRules.accept.push_back(acceptAllServer);
+    }
+
+    for(map<string, list<DistinguishedName> >::const_iterator p = rejectServer.begin(); p != rejectServer.end(); ++p)
+    {
+        if(_adapterRules.find(p->first) == _adapterRules.end())
         {
-            map<string, list<DistinguishedName> >::const_iterator p = _acceptServer.find(info->adapterName);
-            if(p != _acceptServer.end())
-            {
-                accept.push_back(p->second);
-            }
+            _adapterRules[p->first] = _serverRules;
         }
+        _adapterRules[p->first].reject.push_back(p->second);
     }
-    else
+    for(map<string, list<DistinguishedName> >::const_iterator p = acceptServer.begin(); p != acceptServer.end(); ++p)
     {
-        if(_acceptClient.size() > 0)
+        if(_adapterRules.find(p->first) == _adapterRules.end())
         {
-            accept.push_back(_acceptClient);
+            _adapterRules[p->first] = _serverRules;
         }
+        _adapterRules[p->first].accept.push_back(p->second);
     }
+}
+
+bool
+TrustManager::verify(const ConnectionInfoPtr& info, const std::string& desc)
+{
+    const Rules& r = rules(info);
 
     //
     // If there is nothing to match against, then we accept the cert.
     //
-    if(reject.empty() && accept.empty())
+    if(r.reject.empty() && r.accept.empty())
     {
         return true;
     }
@@ -126,79 +129,172 @@ TrustManager::verify(const ConnectionInfoPtr& info, const std::string& desc)
     //
     // If there is no certificate then we match false.
     //
-    if(info->certs.size() != 0)
+    if(info->certs.empty())
     {
-        DistinguishedName subject = info->certs[0]->getSubjectDN();
-        if(_traceLevel > 0)
+        return false;
+    }
+
+    //
+    // The trust decision only depends on the peer certificate and on the
+    // rules selected for the connection so we can re-use a previous decision
+    // and skip the parsing and matching of the certificate subject DN.
+    //
+    string key;
+    if(_cacheSize > 0)
+    {
+        key = cacheKey(info);
+        if(!key.empty())
         {
-            Ice::Trace trace(_communicator->getLogger(), "Security");
-            if(info->incoming)
+            IceUtil::Mutex::Lock sync(_cacheMutex);
+            map<string, bool>::const_iterator p = _cache.find(key);
+            if(p != _cache.end())
             {
-                trace << "trust manager evaluating client:\n" << "subject = " << string(subject) << '\n'
-                      << "adapter = " << info->adapterName << '\n';
+                if(_traceLevel > 0)
+                {
+                    Ice::Trace trace(_communicator->getLogger(), "Security");
+                    trace << "trust manager " << (p->second ? "accepting" : "rejecting") << ' '
+                          << (info->incoming ? "client" : "server") << " (cached decision)\n" << desc;
+                }
+                return p->second;
             }
-            else
+        }
+    }
+
+    bool result = evaluate(r, info, desc);
+
+    if(!key.empty())
+    {
+        IceUtil::Mutex::Lock sync(_cacheMutex);
+        if(_cache.insert(make_pair(key, result)).second)
+        {
+            _cacheKeys.push_back(key);
+            if(_cacheKeys.size() > _cacheSize)
             {
-                trace << "trust manager evaluating server:\n" << "subject = " << string(subject) << '\n';
+                _cache.erase(_cacheKeys.front());
+                _cacheKeys.pop_front();
             }
-            trace << desc;
         }
+    }
+    return result;
+}
 
-        //
-        // Fail if we match anything in the reject set.
-        //
-        for(list<list<DistinguishedName> >::const_iterator p = reject.begin(); p != reject.end(); ++p)
+const TrustManager::Rules&
+TrustManager::rules(const ConnectionInfoPtr& info) const
+{
+    if(!info->incoming)
+    {
+        return _clientRules;
+    }
+
+    if(!info->adapterName.empty())
+    {
+        map<string, Rules>::const_iterator p = _adapterRules.find(info->adapterName);
+        if(p != _adapterRules.end())
+        {
+            return p->second;
+        }
+    }
+    return _serverRules;
+}
+
+bool
+TrustManager::evaluate(const Rules& rules, const ConnectionInfoPtr& info, const string& desc) const
+{
+    DistinguishedName subject = info->certs[0]->getSubjectDN();
+    if(_traceLevel > 0)
+    {
+        Ice::Trace trace(_communicator->getLogger(), "Security");
+        if(info->incoming)
+        {
+            trace << "trust manager evaluating client:\n" << "subject = " << string(subject) << '\n'
+                  << "adapter = " << info->adapterName << '\n';
+        }
+        else
         {
-            if(_traceLevel > 1)
+            trace << "trust manager evaluating server:\n" << "subject = " << string(subject) << '\n';
+        }
+        trace << desc;
+    }
+
+    //
+    // Fail if we match anything in the reject set.
+    //
+    for(list<list<DistinguishedName> >::const_iterator p = rules.reject.begin(); p != rules.reject.end(); ++p)
+    {
+        if(_traceLevel > 1)
+        {
+            Ice::Trace trace(_communicator->getLogger(), "Security");
+            trace << "trust manager rejecting PDNs:\n";
+            for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
             {
-                Ice::Trace trace(_communicator->getLogger(), "Security");
-                trace << "trust manager rejecting PDNs:\n";
-                for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
+                if(r != p->begin())
                 {
-                    if(r != p->begin())
-                    {
-                        trace << ';';
-                    }
-                    trace << string(*r);
+                    trace << ';';
                 }
-            }
-            if(match(*p, subject))
-            {
-                return false;
+                trace << string(*r);
             }
         }
+        if(match(*p, subject))
+        {
+            return false;
+        }
+    }
 
-        //
-        // Succeed if we match anything in the accept set.
-        //
-        for(list<list<DistinguishedName> >::const_iterator p = accept.begin(); p != accept.end(); ++p)
+    //
+    // Succeed if we match anything in the accept set.
+    //
+    for(list<list<DistinguishedName> >::const_iterator p = rules.accept.begin(); p != rules.accept.end(); ++p)
+    {
+        if(_traceLevel > 1)
         {
-            if(_traceLevel > 1)
+            Ice::Trace trace(_communicator->getLogger(), "Security");
+            trace << "trust manager accepting PDNs:\n";
+            for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
             {
-                Ice::Trace trace(_communicator->getLogger(), "Security");
-                trace << "trust manager accepting PDNs:\n";
-                for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
+                if(r != p->begin())
                 {
-                    if(r != p->begin())
-                    {
-                        trace << ';';
-                    }
-                    trace << string(*r);
+                    trace << ';';
                 }
-            }
-            if(match(*p, subject))
-            {
-                return true;
+                trace << string(*r);
             }
         }
+        if(match(*p, subject))
+        {
+            return true;
+        }
+    }
 
-        //
-        // At this point we accept the connection if there are no explicit accept rules.
-        //
-        return accept.empty();
+    //
+    // At this point we accept the connection if there are no explicit accept rules.
+    //
+    return rules.accept.empty();
+}
+
+string
+TrustManager::cacheKey(const ConnectionInfoPtr& info) const
+{
+    string encoded;
+    try
+    {
+        encoded = info->certs[0]->encode();
+    }
+    catch(const CertificateEncodingException&)
+    {
+        return string();
     }
 
-    return false;
+    vector<unsigned char> digest;
+    IceInternal::sha1(reinterpret_cast<const unsigned char*>(encoded.data()), encoded.size(), digest);
+
+    string key;
+    key.reserve(digest.size() + info->adapterName.size() + 1);
+    key.push_back(info->incoming ? 'S' : 'C');
+    key.append(digest.begin(), digest.end());
+    if(info->incoming)
+    {
+        key.append(info->adapterName);
+    }
+    return key;
 }
 
 bool
@@ -9,7 +9,9 @@
 #include <IceSSL/TrustManagerF.h>
 #include <IceSSL/Plugin.h>
 #include <IceSSL/RFC2253.h>
+#include <IceUtil/Mutex.h>
 #include <list>
+#include <deque>
 
 namespace IceSSL
 {
@@ -24,21 +26,38 @@ public:
 
 private:
 
+    //
+    // The reject and accept rules that apply to a given connection, computed
+    // once from the IceSSL.TrustOnly properties rather than for each handshake.
+    //
+    struct Rules
+    {
+        std::list<std::list<DistinguishedName> > reject;
+        std::list<std::list<DistinguishedName> > accept;
+    };
+
+    const Rules& rules(const ConnectionInfoPtr&) const;
+    bool evaluate(const Rules&, const ConnectionInfoPtr&, const std::string&) const;
+    std::string cacheKey(const ConnectionInfoPtr&) const;
+
     bool match(const std::list< DistinguishedName> &, const DistinguishedName&) const;
     void parse(const std::string&, std::list<DistinguishedName>&, std::list<DistinguishedName>&) const;
 
     const Ice::CommunicatorPtr _communicator;
     int _traceLevel;
 
-    std::list<DistinguishedName> _rejectAll;
-    std::list<DistinguishedName> _rejectClient;
-    std::list<DistinguishedName> _rejectAllServer;
-    std::map<std::string, std::list<DistinguishedName> > _rejectServer;
+    Rules _clientRules;
+    Rules _serverRules;
+    std::map<std::string, Rules> _adapterRules;
 
-    std::list<DistinguishedName> _acceptAll;
-    std::list<DistinguishedName> _acceptClient;
-    std::list<DistinguishedName> _acceptAllServer;
-    std::map<std::string, std::list<DistinguishedName> > _acceptServer;
+    //
+    // Cache of the trust decisions, keyed by the peer certificate fingerprint,
+    // the connection direction and the adapter name.
+    //
+    const size_t _cacheSize;
+    std::map<std::string, bool> _cache;
+    std::deque<std::string> _cacheKeys;
+    IceUtil::Mutex _cacheMutex;
 };
 
 }
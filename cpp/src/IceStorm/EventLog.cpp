@@ -0,0 +1,496 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/EventLog.h>
+#include <IceUtil/FileUtil.h>
+#include <IceUtil/StringConverter.h>
+#include <Ice/Communicator.h>
+#include <Ice/InputStream.h>
+#include <Ice/OutputStream.h>
+#include <Ice/LocalException.h>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <sys/mman.h>
+#   include <dirent.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// A record is the record size (an int), the event offset (a long) and
+// the event members, encoded with the 1.1 encoding. The size is written
+// last, a zero size marks the end of the segment.
+//
+const size_t headerSize = 12;
+
+string
+segmentName(Ice::Long base)
+{
+    ostringstream os;
+    os << setfill('0') << setw(20) << base << ".log";
+    return os.str();
+}
+
+vector<string>
+segmentFiles(const string& path)
+{
+    vector<string> result;
+#ifdef _WIN32
+    struct _wfinddata_t data;
+    intptr_t h = _wfindfirst(IceUtil::stringToWstring(path + "/*.log").c_str(), &data);
+    if(h != -1)
+    {
+        do
+        {
+            result.push_back(IceUtil::wstringToString(data.name));
+        }
+        while(_wfindnext(h, &data) != -1);
+        _findclose(h);
+    }
+#else
+    DIR* dir = opendir(path.c_str());
+    if(!dir)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), path);
+    }
+    struct dirent* entry;
+    while((entry = readdir(dir)) != 0)
+    {
+        string name = entry->d_name;
+        if(name.size() > 4 && name.compare(name.size() - 4, 4, ".log") == 0)
+        {
+            result.push_back(name);
+        }
+    }
+    closedir(dir);
+#endif
+    sort(result.begin(), result.end());
+    return result;
+}
+
+void
+createDirectory(const string& path)
+{
+    if(!IceUtilInternal::directoryExists(path) && IceUtilInternal::mkdir(path, 0777) != 0)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), path);
+    }
+}
+
+}
+
+EventLog::EventLog(const Ice::CommunicatorPtr& communicator, const string& path, size_t segmentSize,
+                   size_t sizeMax, SyncPolicy syncPolicy) :
+    _communicator(communicator),
+    _path(path),
+    _segmentSize(max(segmentSize, static_cast<size_t>(4096))),
+    _sizeMax(sizeMax),
+    _syncPolicy(syncPolicy),
+    _size(0),
+    _next(0)
+{
+    createDirectory(_path);
+
+    try
+    {
+        vector<string> files = segmentFiles(_path);
+        for(vector<string>::const_iterator p = files.begin(); p != files.end(); ++p)
+        {
+            Segment segment;
+            segment.path = _path + "/" + *p;
+            istringstream is(p->substr(0, p->size() - 4)); // Not stringToInt64, the name has leading zeros.
+            if(!(is >> segment.base) || !is.eof())
+            {
+                continue;
+            }
+            open(segment, false);
+            if(segment.size < headerSize)
+            {
+                close(segment);
+                IceUtilInternal::unlink(segment.path);
+                continue;
+            }
+            recover(segment);
+            _segments.push_back(segment);
+            _size += segment.size;
+        }
+    }
+    catch(...)
+    {
+        for(deque<Segment>::iterator p = _segments.begin(); p != _segments.end(); ++p)
+        {
+            close(*p);
+        }
+        throw;
+    }
+}
+
+EventLog::~EventLog()
+{
+    for(deque<Segment>::iterator p = _segments.begin(); p != _segments.end(); ++p)
+    {
+        close(*p);
+    }
+}
+
+void
+EventLog::append(const EventDataSeq& events)
+{
+    Lock sync(*this);
+
+    size_t syncBegin = _segments.empty() ? 0 : _segments.back().end;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        const Ice::Long offset = _next;
+        ostringstream os;
+        os << offset;
+        (*p)->context[eventLogOffsetKey] = os.str();
+
+        //
+        // The event data is copied directly to the segment, only the
+        // record header and the context are marshaled to a stream.
+        //
+        Ice::OutputStream header(_communicator, Ice::Encoding_1_1);
+        header.write(static_cast<Ice::Int>(0));
+        header.write(offset);
+        header.write((*p)->op);
+        header.write((*p)->mode);
+        header.writeSize(static_cast<Ice::Int>((*p)->data.size()));
+        Ice::OutputStream context(_communicator, Ice::Encoding_1_1);
+        context.write((*p)->context);
+        const size_t size = header.b.size() + (*p)->data.size() + context.b.size();
+        header.rewrite(static_cast<Ice::Int>(size), 0);
+
+        //
+        // Start a new segment if the record doesn't fit in the current
+        // segment and remove the oldest segments if the log is too
+        // large.
+        //
+        if(_segments.empty() || _segments.back().end + size > _segments.back().size)
+        {
+            if(!_segments.empty() && _syncPolicy != SyncNone)
+            {
+                this->sync(_segments.back(), _syncPolicy == SyncAppend ? syncBegin : 0, _segments.back().end);
+            }
+            syncBegin = 0;
+
+            Segment segment;
+            segment.base = offset;
+            segment.path = _path + "/" + segmentName(offset);
+            segment.size = max(_segmentSize, size);
+            segment.end = 0;
+            open(segment, true);
+            _segments.push_back(segment);
+            _size += segment.size;
+
+            while(_size > _sizeMax && _segments.size() > 1)
+            {
+                Segment& oldest = _segments.front();
+                _size -= oldest.size;
+                close(oldest);
+                IceUtilInternal::unlink(oldest.path);
+                _segments.pop_front();
+            }
+        }
+
+        //
+        // Write the record size last, so that a partially written
+        // record is ignored on recovery.
+        //
+        Segment& segment = _segments.back();
+        Ice::Byte* record = segment.data + segment.end;
+        memcpy(record + 4, header.b.begin() + 4, header.b.size() - 4);
+        record += header.b.size();
+        if(!(*p)->data.empty())
+        {
+            memcpy(record, &(*p)->data[0], (*p)->data.size());
+            record += (*p)->data.size();
+        }
+        memcpy(record, context.b.begin(), context.b.size());
+        memcpy(segment.data + segment.end, header.b.begin(), 4);
+        segment.end += size;
+        ++_next;
+    }
+
+    if(_syncPolicy == SyncAppend && !_segments.empty() && _segments.back().end > syncBegin)
+    {
+        this->sync(_segments.back(), syncBegin, _segments.back().end);
+    }
+}
+
+EventDataSeq
+EventLog::read(Ice::Long& offset, size_t max) const
+{
+    Lock sync(*this);
+
+    EventDataSeq events;
+    if(!_segments.empty() && offset < _segments.front().base)
+    {
+        offset = _segments.front().base;
+    }
+
+    deque<Segment>::const_iterator p = _segments.end();
+    while(p != _segments.begin())
+    {
+        --p;
+        if(p->base <= offset)
+        {
+            break;
+        }
+    }
+    for(; p != _segments.end() && events.size() < max; ++p)
+    {
+        read(*p, offset, max, events);
+    }
+    return events;
+}
+
+Ice::Long
+EventLog::firstOffset() const
+{
+    Lock sync(*this);
+    return _segments.empty() ? _next : _segments.front().base;
+}
+
+Ice::Long
+EventLog::nextOffset() const
+{
+    Lock sync(*this);
+    return _next;
+}
+
+void
+EventLog::destroy()
+{
+    Lock sync(*this);
+
+    for(deque<Segment>::iterator p = _segments.begin(); p != _segments.end(); ++p)
+    {
+        close(*p);
+        IceUtilInternal::unlink(p->path);
+    }
+    _segments.clear();
+    _size = 0;
+    IceUtilInternal::rmdir(_path);
+}
+
+string
+EventLog::directory(const string& path, const string& topic)
+{
+    //
+    // The topic name is escaped to get a valid file name.
+    //
+    ostringstream os;
+    os << path << '/' << hex << uppercase << setfill('0');
+    for(string::const_iterator p = topic.begin(); p != topic.end(); ++p)
+    {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_')
+        {
+            os << *p;
+        }
+        else
+        {
+            os << '%' << setw(2) << static_cast<int>(c);
+        }
+    }
+    return os.str();
+}
+
+void
+EventLog::open(Segment& segment, bool create)
+{
+#ifdef _WIN32
+    segment.mapping = 0;
+    segment.file = CreateFileW(IceUtil::stringToWstring(segment.path).c_str(), GENERIC_READ | GENERIC_WRITE, 0, 0,
+                               create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if(segment.file == INVALID_HANDLE_VALUE)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), segment.path);
+    }
+    if(!create)
+    {
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(segment.file, &size))
+        {
+            int error = IceInternal::getSystemErrno();
+            CloseHandle(segment.file);
+            throw Ice::FileException(__FILE__, __LINE__, error, segment.path);
+        }
+        segment.size = static_cast<size_t>(size.QuadPart);
+    }
+
+    //
+    // Creating the mapping extends a new segment file to the segment
+    // size, the file is filled with zeros.
+    //
+    ULARGE_INTEGER size;
+    size.QuadPart = segment.size;
+    segment.mapping = CreateFileMappingW(segment.file, 0, PAGE_READWRITE, size.HighPart, size.LowPart, 0);
+    segment.data = segment.mapping ?
+        static_cast<Ice::Byte*>(MapViewOfFile(segment.mapping, FILE_MAP_ALL_ACCESS, 0, 0, segment.size)) : 0;
+    if(!segment.data)
+    {
+        int error = IceInternal::getSystemErrno();
+        if(segment.mapping)
+        {
+            CloseHandle(segment.mapping);
+        }
+        CloseHandle(segment.file);
+        throw Ice::FileException(__FILE__, __LINE__, error, segment.path);
+    }
+#else
+    segment.fd = IceUtilInternal::open(segment.path, create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR);
+    if(segment.fd < 0)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), segment.path);
+    }
+
+    int error = 0;
+    if(create)
+    {
+        //
+        // Extend the new segment file to the segment size, the file
+        // is filled with zeros.
+        //
+        if(ftruncate(segment.fd, static_cast<off_t>(segment.size)) != 0)
+        {
+            error = IceInternal::getSystemErrno();
+        }
+    }
+    else
+    {
+        IceUtilInternal::structstat buf;
+        if(fstat(segment.fd, &buf) != 0)
+        {
+            error = IceInternal::getSystemErrno();
+        }
+        segment.size = static_cast<size_t>(buf.st_size);
+    }
+
+    if(error == 0 && segment.size > 0)
+    {
+        void* data = mmap(0, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        if(data == MAP_FAILED)
+        {
+            error = IceInternal::getSystemErrno();
+        }
+        segment.data = static_cast<Ice::Byte*>(data);
+    }
+    else
+    {
+        segment.data = 0;
+    }
+
+    if(error != 0)
+    {
+        IceUtilInternal::close(segment.fd);
+        throw Ice::FileException(__FILE__, __LINE__, error, segment.path);
+    }
+#endif
+}
+
+void
+EventLog::close(Segment& segment)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(segment.data);
+    CloseHandle(segment.mapping);
+    CloseHandle(segment.file);
+#else
+    if(segment.data)
+    {
+        munmap(segment.data, segment.size);
+    }
+    IceUtilInternal::close(segment.fd);
+#endif
+}
+
+void
+EventLog::recover(Segment& segment)
+{
+    //
+    // Find the end of the segment, the record offsets must follow
+    // the segment base offset.
+    //
+    segment.end = 0;
+    Ice::Long expected = segment.base;
+    while(segment.end + headerSize <= segment.size)
+    {
+        Ice::InputStream in(_communicator, Ice::Encoding_1_1,
+                            make_pair(segment.data + segment.end, segment.data + segment.end + headerSize));
+        Ice::Int size;
+        Ice::Long offset;
+        in.read(size);
+        in.read(offset);
+        if(size < static_cast<Ice::Int>(headerSize) || segment.end + static_cast<size_t>(size) > segment.size ||
+           offset != expected)
+        {
+            break;
+        }
+        segment.end += static_cast<size_t>(size);
+        ++expected;
+    }
+
+    //
+    // Clear the remains of a partially written record.
+    //
+    memset(segment.data + segment.end, 0, segment.size - segment.end);
+    _next = max(_next, expected);
+}
+
+void
+EventLog::read(const Segment& segment, Ice::Long& offset, size_t max, EventDataSeq& events) const
+{
+    size_t pos = 0;
+    while(pos < segment.end && events.size() < max)
+    {
+        Ice::InputStream in(_communicator, Ice::Encoding_1_1,
+                            make_pair(segment.data + pos, segment.data + segment.end));
+        Ice::Int size;
+        Ice::Long eventOffset;
+        in.read(size);
+        in.read(eventOffset);
+        if(eventOffset >= offset)
+        {
+            EventDataPtr event = new EventData;
+            in.read(event->op);
+            in.read(event->mode);
+            in.read(event->data);
+            in.read(event->context);
+            events.push_back(event);
+            offset = eventOffset + 1;
+        }
+        pos += static_cast<size_t>(size);
+    }
+}
+
+void
+EventLog::sync(const Segment& segment, size_t begin, size_t end)
+{
+#ifdef _WIN32
+    if(!FlushViewOfFile(segment.data + begin, end - begin) || !FlushFileBuffers(segment.file))
+#else
+    //
+    // msync requires a page aligned address.
+    //
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    begin -= begin % pageSize;
+    if(msync(segment.data + begin, end - begin, MS_SYNC) != 0)
+#endif
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), segment.path);
+    }
+}
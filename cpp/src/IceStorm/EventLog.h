@@ -0,0 +1,101 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <IceStorm/IceStormInternal.h>
+#include <IceUtil/Mutex.h>
+#include <deque>
+
+namespace IceStorm
+{
+
+//
+// The context key set to the offset of the event in the topic event
+// log.
+//
+const std::string eventLogOffsetKey = "IceStorm.Offset";
+
+//
+// An append-only log of the events published on a topic. The log is
+// stored in a directory as a sequence of memory-mapped segment files,
+// the oldest segments are removed once the size of the log exceeds
+// the configured maximum size.
+//
+// Each event is assigned an offset, its position in the log. The
+// offset is set in the event context with the IceStorm.Offset key.
+//
+class EventLog : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    //
+    // When the appended events are written to disk, see the
+    // EventLog.Sync property.
+    //
+    enum SyncPolicy
+    {
+        SyncNone, // The OS writes the mapped segments back to the files.
+        SyncSegment, // Each segment is synced once it's full.
+        SyncAppend // The appended events are synced before append returns.
+    };
+
+    EventLog(const Ice::CommunicatorPtr&, const std::string&, size_t, size_t, SyncPolicy);
+    ~EventLog();
+
+    // Assign an offset to each event and append the events to the log.
+    void append(const EventDataSeq&);
+
+    // Read up to the given number of events from the given offset and
+    // set the offset to the offset of the next event. If the events for
+    // this offset were already removed, read from the oldest event.
+    EventDataSeq read(Ice::Long&, size_t) const;
+
+    Ice::Long firstOffset() const;
+    Ice::Long nextOffset() const;
+
+    // Close the log and remove its files.
+    void destroy();
+
+    static std::string directory(const std::string&, const std::string&);
+
+private:
+
+    struct Segment
+    {
+        Ice::Long base; // The offset of the first event of the segment.
+        std::string path;
+        size_t size;
+        size_t end;
+        Ice::Byte* data;
+#ifdef _WIN32
+        HANDLE file;
+        HANDLE mapping;
+#else
+        int fd;
+#endif
+    };
+
+    void open(Segment&, bool);
+    void close(Segment&);
+    void recover(Segment&);
+    void read(const Segment&, Ice::Long&, size_t, EventDataSeq&) const;
+    void sync(const Segment&, size_t, size_t);
+
+    const Ice::CommunicatorPtr _communicator;
+    const std::string _path;
+    const size_t _segmentSize;
+    const size_t _sizeMax;
+    const SyncPolicy _syncPolicy;
+
+    std::deque<Segment> _segments;
+    size_t _size;
+    Ice::Long _next;
+};
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+}
+
+#endif
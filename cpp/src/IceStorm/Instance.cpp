@@ -5,8 +5,11 @@
 #include <IceStorm/Instance.h>
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/Observers.h>
+#include <IceStorm/UpdateLog.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/InstrumentationI.h>
+#include <IceStorm/Subscriber.h>
+#include <IceStorm/Shards.h>
 #include <IceUtil/Timer.h>
 
 #include <Ice/InstrumentationI.h>
@@ -49,6 +52,14 @@ PersistentInstance::PersistentInstance(
     const Ice::ObjectAdapterPtr& nodeAdapter,
     const NodePrx& nodeProxy) :
     Instance(instanceName, name, communicator, publishAdapter, topicAdapter, nodeAdapter, nodeProxy),
+    _eventLogPath(communicator->getProperties()->getProperty(name + ".EventLog.Path")),
+    // default 16MB segments.
+    _eventLogSegmentSize(static_cast<size_t>(max(communicator->getProperties()->getPropertyAsIntWithDefault(
+                                                     name + ".EventLog.SegmentSize", 16 * 1024), 4)) * 1024),
+    // default 256MB per topic.
+    _eventLogSizeMax(static_cast<size_t>(max(communicator->getProperties()->getPropertyAsIntWithDefault(
+                                                 name + ".EventLog.SizeMax", 256), 1)) * 1024 * 1024),
+    _eventLogSync(EventLog::SyncNone),
     _dbLock(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name) + "/icedb.lock"),
     _dbEnv(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name), 2,
            IceDB::getMapSize(communicator->getProperties()->getPropertyAsInt(name + ".LMDB.MapSize")))
@@ -65,6 +76,38 @@ PersistentInstance::PersistentInstance(
         _subscriberMap = SubscriberMap(txn, "subscribers", dbContext, MDB_CREATE, compareSubscriberRecordKey);
 
         txn.commit();
+
+        //
+        // Each replica delivers the events it receives to all the
+        // subscribers so the replicas don't share a common event
+        // sequence, the event log is only supported without
+        // replication.
+        //
+        if(!_eventLogPath.empty() && nodeProxy)
+        {
+            Ice::Warning warn(communicator->getLogger());
+            warn << "the event log is not supported with replication, ignoring `" << name << ".EventLog.Path'";
+            const_cast<string&>(_eventLogPath) = "";
+        }
+
+        string sync = communicator->getProperties()->getProperty(name + ".EventLog.Sync");
+        if(sync == "None")
+        {
+            const_cast<EventLog::SyncPolicy&>(_eventLogSync) = EventLog::SyncNone;
+        }
+        else if(sync == "Segment")
+        {
+            const_cast<EventLog::SyncPolicy&>(_eventLogSync) = EventLog::SyncSegment;
+        }
+        else if(sync == "Append")
+        {
+            const_cast<EventLog::SyncPolicy&>(_eventLogSync) = EventLog::SyncAppend;
+        }
+        else if(!sync.empty())
+        {
+            Ice::Warning warn(communicator->getLogger());
+            warn << "invalid value `" << sync << "' for `" << name << ".EventLog.Sync'";
+        }
     }
     catch(...)
     {
@@ -108,7 +151,8 @@ Instance::Instance(
     _sendTimeout(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.Timeout", 60 * 1000)),
     _sendQueueSizeMax(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.QueueSizeMax", -1)),
     _sendQueueSizeMaxPolicy(RemoveSubscriber),
-    _topicReaper(new TopicReaper())
+    _topicReaper(new TopicReaper()),
+    _subscriberGroups(new SubscriberGroups())
 {
     try
     {
@@ -128,9 +172,19 @@ Instance::Instance(
                 const_cast<Ice::ObjectPrx&>(_publisherReplicaProxy) = communicator->stringToProxy("dummy:" + p);
             }
         }
+        //
+        // The update log is only used with replication.
+        //
+        _updateLog = new UpdateLog(nodeAdapter ? static_cast<size_t>(
+                                       max(properties->getPropertyAsIntWithDefault(name + ".Replication.LogSize",
+                                                                                   10000), 0)) : 0);
         _observers = new Observers(this);
+        _shards = new Shards(communicator, name);
         _batchFlusher = new IceUtil::Timer();
         _timer = new IceUtil::Timer();
+        _fanOutPool = new FanOutPool(communicator->getLogger(),
+                                     properties->getPropertyAsIntWithDefault(name + ".FanOut.Threads", 0),
+                                     properties->getPropertyAsIntWithDefault(name + ".FanOut.PartitionSize", 1024));
 
         string policy = properties->getProperty(name + ".Send.QueueSizeMaxPolicy");
         if(policy == "RemoveSubscriber")
@@ -223,6 +277,12 @@ Instance::observers() const
     return _observers;
 }
 
+UpdateLogPtr
+Instance::updateLog() const
+{
+    return _updateLog;
+}
+
 NodeIPtr
 Instance::node() const
 {
@@ -277,6 +337,24 @@ Instance::topicReaper() const
     return _topicReaper;
 }
 
+FanOutPoolPtr
+Instance::fanOutPool() const
+{
+    return _fanOutPool;
+}
+
+SubscriberGroupsPtr
+Instance::subscriberGroups() const
+{
+    return _subscriberGroups;
+}
+
+ShardsPtr
+Instance::shards() const
+{
+    return _shards;
+}
+
 IceUtil::Time
 Instance::discardInterval() const
 {
@@ -334,6 +412,11 @@ Instance::destroy()
         _batchFlusher->destroy();
     }
 
+    if(_fanOutPool)
+    {
+        _fanOutPool->destroy();
+    }
+
     // The node instance must be cleared as the node holds the
     // replica (TopicManager) which holds the instance causing a
     // cyclic reference.
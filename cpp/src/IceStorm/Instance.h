@@ -12,6 +12,7 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
+#include <IceStorm/EventLog.h>
 
 namespace IceUtil
 {
@@ -30,6 +31,9 @@ typedef IceUtil::Handle<Observers> ObserversPtr;
 class NodeI;
 typedef IceUtil::Handle<NodeI> NodeIPtr;
 
+class UpdateLog;
+typedef IceUtil::Handle<UpdateLog> UpdateLogPtr;
+
 }
 
 namespace IceStorm
@@ -38,6 +42,15 @@ namespace IceStorm
 class TraceLevels;
 typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 
+class FanOutPool;
+typedef IceUtil::Handle<FanOutPool> FanOutPoolPtr;
+
+class SubscriberGroups;
+typedef IceUtil::Handle<SubscriberGroups> SubscriberGroupsPtr;
+
+class Shards;
+typedef IceUtil::Handle<Shards> ShardsPtr;
+
 class TopicReaper : public IceUtil::Shared, private IceUtil::Mutex
 {
 public:
@@ -74,6 +87,7 @@ public:
     Ice::ObjectAdapterPtr topicAdapter() const;
     Ice::ObjectAdapterPtr nodeAdapter() const;
     IceStormElection::ObserversPtr observers() const;
+    IceStormElection::UpdateLogPtr updateLog() const;
     IceStormElection::NodeIPtr node() const;
     IceStormElection::NodePrx nodeProxy() const;
     TraceLevelsPtr traceLevels() const;
@@ -83,6 +97,9 @@ public:
     Ice::ObjectPrx publisherReplicaProxy() const;
     IceStorm::Instrumentation::TopicManagerObserverPtr observer() const;
     TopicReaperPtr topicReaper() const;
+    FanOutPoolPtr fanOutPool() const;
+    SubscriberGroupsPtr subscriberGroups() const;
+    ShardsPtr shards() const;
 
     IceUtil::Time discardInterval() const;
     IceUtil::Time flushInterval() const;
@@ -113,8 +130,12 @@ private:
     const TopicReaperPtr _topicReaper;
     IceStormElection::NodeIPtr _node;
     IceStormElection::ObserversPtr _observers;
+    IceStormElection::UpdateLogPtr _updateLog;
     IceUtil::TimerPtr _batchFlusher;
     IceUtil::TimerPtr _timer;
+    FanOutPoolPtr _fanOutPool;
+    const SubscriberGroupsPtr _subscriberGroups;
+    ShardsPtr _shards;
     IceStorm::Instrumentation::TopicManagerObserverPtr _observer;
 
 };
@@ -135,10 +156,19 @@ public:
     LLUMap lluMap() const { return _lluMap; }
     SubscriberMap subscriberMap() const { return _subscriberMap; }
 
+    std::string eventLogPath() const { return _eventLogPath; }
+    size_t eventLogSegmentSize() const { return _eventLogSegmentSize; }
+    size_t eventLogSizeMax() const { return _eventLogSizeMax; }
+    EventLog::SyncPolicy eventLogSync() const { return _eventLogSync; }
+
     virtual void destroy();
 
 private:
 
+    const std::string _eventLogPath;
+    const size_t _eventLogSegmentSize;
+    const size_t _eventLogSizeMax;
+    const EventLog::SyncPolicy _eventLogSync;
     IceUtilInternal::FileLock _dbLock;
     IceDB::Env _dbEnv;
     LLUMap _lluMap;
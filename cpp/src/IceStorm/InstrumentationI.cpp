@@ -234,6 +234,35 @@ TopicObserverI::forwarded()
 namespace
 {
 
+struct FannedOutUpdate
+{
+    FannedOutUpdate(Ice::Long durationP) : duration(durationP)
+    {
+    }
+
+    void operator()(const TopicMetricsPtr& v)
+    {
+        v->totalFanOutTime = (v->totalFanOutTime ? *v->totalFanOutTime : 0) + duration;
+        if(!v->maxFanOutTime || *v->maxFanOutTime < duration)
+        {
+            v->maxFanOutTime = duration;
+        }
+    }
+
+    Ice::Long duration;
+};
+
+}
+
+void
+TopicObserverI::fannedOut(Ice::Int, Ice::Long duration)
+{
+    forEach(FannedOutUpdate(duration));
+}
+
+namespace
+{
+
 struct QueuedUpdate
 {
     QueuedUpdate(int countP) : count(countP)
@@ -20,6 +20,7 @@ public:
 
     virtual void published();
     virtual void forwarded();
+    virtual void fannedOut(Ice::Int, Ice::Long);
 };
 
 class SubscriberObserverI : public IceStorm::Instrumentation::SubscriberObserver,
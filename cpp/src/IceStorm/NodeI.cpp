@@ -5,6 +5,7 @@
 #include <Ice/Ice.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Observers.h>
+#include <IceStorm/UpdateLog.h>
 #include <IceStorm/TraceLevels.h>
 
 using namespace IceStorm;
@@ -154,6 +155,7 @@ NodeI::NodeI(const InstancePtr& instance,
     _timer(instance->timer()),
     _traceLevels(instance->traceLevels()),
     _observers(instance->observers()),
+    _updateLog(instance->updateLog()),
     _replica(replica),
     _replicaProxy(replicaProxy),
     _id(id),
@@ -857,6 +859,10 @@ NodeI::ready(int j, const string& gn, const Ice::ObjectPrx& coordinator, int max
         }
         _generation = generation;
 
+        // The coordinator initialized all its slaves, this generation
+        // can't be started by another master.
+        _updateLog->confirm(generation);
+
         // Activate the replica here since the replica is now ready
         // for duty.
         setState(NodeStateNormal);
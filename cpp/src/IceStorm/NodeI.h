@@ -62,6 +62,7 @@ private:
     const IceUtil::TimerPtr _timer;
     const IceStorm::TraceLevelsPtr _traceLevels;
     const IceStormElection::ObserversPtr _observers;
+    const IceStormElection::UpdateLogPtr _updateLog;
     const ReplicaPtr _replica; // The replica.
     const Ice::ObjectPrx _replicaProxy; // A proxy to the individual replica.
 
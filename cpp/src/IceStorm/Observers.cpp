@@ -5,6 +5,7 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/TraceLevels.h>
+#include <IceStorm/UpdateLog.h>
 
 using namespace std;
 using namespace IceStorm;
@@ -12,6 +13,7 @@ using namespace IceStormElection;
 
 Observers::Observers(const InstancePtr& instance) :
     _traceLevels(instance->traceLevels()),
+    _updateLog(instance->updateLog()),
     _majority(0)
 {
 }
@@ -73,15 +75,26 @@ Observers::getReapedSlaves(std::vector<int>& d)
 }
 
 void
-Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const TopicContentSeq& content)
+Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const ReplicaPtr& replica)
 {
     {
         IceUtil::Mutex::Lock sync(_reapedMutex);
         _reaped.clear();
     }
 
-    Lock sync(*this);
-    _observers.clear();
+    {
+        Lock sync(*this);
+        _observers.clear();
+    }
+
+    //
+    // The slaves whose last log update is in the update log only get
+    // the updates that follow it. The topic content is only retrieved
+    // if a slave needs it, the observers mutex isn't locked since the
+    // topics call on the observers with their mutex locked.
+    //
+    TopicContentSeq content;
+    bool hasContent = false;
 
     vector<ObserverInfo> observers;
 
@@ -93,7 +106,28 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
 
             ReplicaObserverPrx observer = ReplicaObserverPrx::uncheckedCast(p->observer);
 
-            Ice::AsyncResultPtr result = observer->begin_init(llu, content);
+            Ice::AsyncResultPtr result;
+            UpdateSeq updates;
+            if(_updateLog->get(p->llu, updates))
+            {
+                if(_traceLevels->replication > 0)
+                {
+                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                    out << "init " << p->id << " with " << updates.size() << " updates since llu "
+                        << p->llu.generation << "/" << p->llu.iteration;
+                }
+                result = observer->begin_initUpdates(llu, p->llu, updates);
+            }
+            else
+            {
+                if(!hasContent)
+                {
+                    LogUpdate tmp;
+                    replica->getContent(tmp, content);
+                    hasContent = true;
+                }
+                result = observer->begin_init(llu, content);
+            }
             observers.push_back(ObserverInfo(p->id, observer, result));
         }
         catch(const Ice::Exception& ex)
@@ -111,7 +145,36 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
     {
         try
         {
-            p->observer->end_init(p->result);
+            if(p->result->getOperation() == "initUpdates")
+            {
+                //
+                // If the slave can't apply the updates, it's initialized
+                // with the topic content instead.
+                //
+                try
+                {
+                    p->observer->end_initUpdates(p->result);
+                }
+                catch(const ObserverInconsistencyException& ex)
+                {
+                    if(_traceLevels->replication > 0)
+                    {
+                        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                        out << "initUpdates on " << p->id << " failed: " << ex.reason;
+                    }
+                    if(!hasContent)
+                    {
+                        LogUpdate tmp;
+                        replica->getContent(tmp, content);
+                        hasContent = true;
+                    }
+                    p->observer->init(llu, content);
+                }
+            }
+            else
+            {
+                p->observer->end_init(p->result);
+            }
             p->result = 0;
         }
         catch(const Ice::Exception& ex)
@@ -125,12 +188,19 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
         }
     }
 
+    Lock sync(*this);
     _observers.swap(observers);
 }
 
 void
 Observers::createTopic(const LogUpdate& llu, const string& name)
 {
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeCreateTopic;
+    update.topic = name;
+    _updateLog->add(update);
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -142,6 +212,12 @@ Observers::createTopic(const LogUpdate& llu, const string& name)
 void
 Observers::destroyTopic(const LogUpdate& llu, const string& id)
 {
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeDestroyTopic;
+    update.topic = id;
+    _updateLog->add(update);
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -153,6 +229,13 @@ Observers::destroyTopic(const LogUpdate& llu, const string& id)
 void
 Observers::addSubscriber(const LogUpdate& llu, const string& name, const SubscriberRecord& rec)
 {
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeAddSubscriber;
+    update.topic = name;
+    update.record = rec;
+    _updateLog->add(update);
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -164,6 +247,13 @@ Observers::addSubscriber(const LogUpdate& llu, const string& name, const Subscri
 void
 Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id)
 {
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeRemoveSubscriber;
+    update.topic = name;
+    update.subscribers = id;
+    _updateLog->add(update);
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -25,6 +25,9 @@ typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 namespace IceStormElection
 {
 
+class UpdateLog;
+typedef IceUtil::Handle<UpdateLog> UpdateLogPtr;
+
 class Observers : public IceUtil::Shared, public IceUtil::Mutex
 {
 public:
@@ -36,7 +39,7 @@ public:
     bool check();
     void clear();
 
-    void init(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, const TopicContentSeq&);
+    void init(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, const ReplicaPtr&);
     void createTopic(const LogUpdate&, const std::string&);
     void destroyTopic(const LogUpdate&, const std::string&);
     void addSubscriber(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecord&);
@@ -48,6 +51,7 @@ private:
     void wait(const std::string&);
 
     const IceStorm::TraceLevelsPtr _traceLevels;
+    const UpdateLogPtr _updateLog;
     unsigned int _majority;
     struct ObserverInfo
     {
@@ -34,6 +34,7 @@ class Replica : public virtual IceUtil::Shared
 public:
 
     virtual LogUpdate getLastLogUpdate() const = 0;
+    virtual void getContent(LogUpdate&, TopicContentSeq&) = 0;
     virtual void sync(const Ice::ObjectPrx&) = 0;
     virtual void initMaster(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&) = 0;
     virtual Ice::ObjectPrx getObserver() const = 0;
@@ -477,6 +477,9 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Election.MasterTimeout",
         "Election.ElectionTimeout",
         "Election.ResponseTimeout",
+        "Replication.LogSize",
+        "Shard.Name",
+        "Shards.*",
         "Publish.AdapterId",
         "Publish.Endpoints",
         "Publish.Locator",
@@ -524,6 +527,12 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Send.QueueSizeMax",
         "Send.QueueSizeMaxPolicy",
         "Discard.Interval",
+        "FanOut.Threads",
+        "FanOut.PartitionSize",
+        "EventLog.Path",
+        "EventLog.SegmentSize",
+        "EventLog.SizeMax",
+        "EventLog.Sync",
         "LMDB.Path",
         "LMDB.MapSize"
     };
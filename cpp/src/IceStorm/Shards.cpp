@@ -0,0 +1,133 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/Shards.h>
+#include <Ice/Ice.h>
+#include <set>
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// The number of points of each shard on the hash ring.
+//
+const int pointsPerShard = 100;
+
+//
+// The hash of the ring must be the same for all the shards, the
+// 32-bit FNV-1a hash is used.
+//
+unsigned int
+ringHash(const string& s)
+{
+    unsigned int h = 2166136261U;
+    for(string::const_iterator p = s.begin(); p != s.end(); ++p)
+    {
+        h ^= static_cast<unsigned char>(*p);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+}
+
+Shards::Shards(const Ice::CommunicatorPtr& communicator, const string& service)
+{
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    const string prefix = service + ".Shards.";
+    Ice::PropertyDict shards = properties->getPropertiesForPrefix(prefix);
+    if(shards.empty())
+    {
+        return;
+    }
+
+    const_cast<string&>(_name) = properties->getProperty(service + ".Shard.Name");
+    if(_name.empty())
+    {
+        Ice::Warning warn(communicator->getLogger());
+        warn << "`" << service << ".Shard.Name' is not set, ignoring the `" << prefix << "*' properties";
+        return;
+    }
+
+    Ice::Context ctx;
+    ctx[shardContextKey] = _name;
+
+    set<string> names;
+    names.insert(_name);
+    for(Ice::PropertyDict::const_iterator p = shards.begin(); p != shards.end(); ++p)
+    {
+        // Skip the proxy properties, for example
+        // <service>.Shards.<name>.LocatorCacheTimeout.
+        string name = p->first.substr(prefix.size());
+        if(name.find('.') != string::npos)
+        {
+            continue;
+        }
+
+        names.insert(name);
+        if(name != _name)
+        {
+            Ice::ObjectPrx proxy = communicator->propertyToProxy(p->first);
+            if(!proxy)
+            {
+                Ice::Warning warn(communicator->getLogger());
+                warn << "invalid proxy for `" << p->first << "', ignoring the `" << prefix << "*' properties";
+                _managers.clear();
+                return;
+            }
+            _managers[name] = TopicManagerPrx::uncheckedCast(proxy->ice_context(ctx));
+        }
+    }
+
+    for(set<string>::const_iterator p = names.begin(); p != names.end(); ++p)
+    {
+        for(int i = 0; i < pointsPerShard; ++i)
+        {
+            ostringstream os;
+            os << *p << '#' << i;
+            _ring[ringHash(os.str())] = *p;
+        }
+    }
+}
+
+TopicManagerPrx
+Shards::owner(const string& topic, const Ice::Current& current) const
+{
+    if(_ring.empty() || current.ctx.find(shardContextKey) != current.ctx.end())
+    {
+        return 0;
+    }
+
+    map<unsigned int, string>::const_iterator p = _ring.lower_bound(ringHash(topic));
+    if(p == _ring.end())
+    {
+        p = _ring.begin();
+    }
+    if(p->second == _name)
+    {
+        return 0;
+    }
+
+    map<string, TopicManagerPrx>::const_iterator q = _managers.find(p->second);
+    assert(q != _managers.end());
+    return q->second;
+}
+
+void
+Shards::retrieveAll(TopicDict& all, const Ice::Current& current) const
+{
+    if(_ring.empty() || current.ctx.find(shardContextKey) != current.ctx.end())
+    {
+        return;
+    }
+
+    for(map<string, TopicManagerPrx>::const_iterator p = _managers.begin(); p != _managers.end(); ++p)
+    {
+        TopicDict topics = p->second->retrieveAll();
+        all.insert(topics.begin(), topics.end());
+    }
+}
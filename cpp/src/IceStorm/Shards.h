@@ -0,0 +1,59 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef SHARDS_H
+#define SHARDS_H
+
+#include <IceStorm/IceStorm.h>
+#include <map>
+
+namespace IceStorm
+{
+
+//
+// The context key set by a topic manager that forwards a request to
+// the topic manager of another shard.
+//
+const std::string shardContextKey = "IceStorm.Shard";
+
+//
+// The topic shards. Each topic is owned by a single shard, an IceStorm
+// instance or replica group, chosen by consistent hashing of the topic
+// name: each shard is placed at several points of a hash ring and a
+// topic is owned by the shard of the first point that follows the
+// hash of its name. Adding or removing a shard only moves the topics
+// of the points that precede the points of this shard.
+//
+// The shards are configured with <service>.Shard.Name, the name of
+// this shard, and with a <service>.Shards.<name> topic manager proxy
+// for each of the other shards. The topic manager forwards the
+// creation and retrieval of the topics owned by another shard to the
+// topic manager of this shard.
+//
+class Shards : public IceUtil::Shared
+{
+public:
+
+    Shards(const Ice::CommunicatorPtr&, const std::string&);
+
+    // Get the topic manager of the shard that owns the given topic,
+    // returns a null proxy if this shard owns the topic or if the
+    // request was forwarded by another shard.
+    TopicManagerPrx owner(const std::string&, const Ice::Current&) const;
+
+    // Add the topics of the other shards, unless the request was
+    // forwarded by another shard.
+    void retrieveAll(TopicDict&, const Ice::Current&) const;
+
+private:
+
+    const std::string _name;
+    std::map<std::string, TopicManagerPrx> _managers;
+    std::map<unsigned int, std::string> _ring;
+};
+typedef IceUtil::Handle<Shards> ShardsPtr;
+
+} // End namespace IceStorm
+
+#endif
@@ -8,6 +8,7 @@
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/OutputStream.h>
 #include <IceUtil/StringUtil.h>
 #include <iterator>
 
@@ -44,22 +45,10 @@ public:
         // Use cached reads.
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
 
-        EventDataPtr event = new EventData(
-            current.operation,
-            current.mode,
-            Ice::ByteSeq(),
-            current.ctx);
-
-        //
-        // COMPILERBUG: gcc 4.0.1 doesn't like this.
-        //
-        //event->data.swap(Ice::ByteSeq(inParams.first, inParams.second));
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event->data.swap(data);
-
         EventDataSeq e;
-        e.push_back(event);
+        e.push_back(IceStormInternal::createEvent(inParams, current));
         _subscriber->queue(false, e);
+        _instance->subscriberGroups()->flush();
         return true;
     }
 
@@ -164,6 +153,20 @@ private:
     const TopicLinkPrx _obj;
 };
 
+class SubscriberDemux : public Subscriber
+{
+public:
+
+    SubscriberDemux(const InstancePtr&, const SubscriberRecord&, const Ice::ObjectPrx&, int, const Ice::ObjectPrx&);
+
+    virtual void flush();
+    virtual void destroy();
+
+private:
+
+    const SubscriberGroupPtr _group;
+};
+
 class FlushTimerTask : public IceUtil::TimerTask
 {
 public:
@@ -228,6 +231,7 @@ SubscriberBatch::doFlush()
 
     EventDataSeq v;
     v.swap(_events);
+    _conflated.clear();
     assert(!v.empty());
 
     if(_observer)
@@ -337,6 +341,7 @@ SubscriberOneway::flush()
         //
         EventDataPtr e = _events.front();
         _events.erase(_events.begin());
+        ++_eventsOffset;
         if(_observer)
         {
             _observer->outstanding(1);
@@ -432,6 +437,7 @@ SubscriberTwoway::flush()
         //
         EventDataPtr e = _events.front();
         _events.erase(_events.begin());
+        ++_eventsOffset;
         ++_outstanding;
         if(_observer)
         {
@@ -451,6 +457,55 @@ SubscriberTwoway::flush()
     }
 }
 
+SubscriberDemux::SubscriberDemux(
+    const InstancePtr& instance,
+    const SubscriberRecord& rec,
+    const Ice::ObjectPrx& proxy,
+    int retryCount,
+    const Ice::ObjectPrx& demux) :
+    Subscriber(instance, rec, proxy, retryCount, 1),
+    _group(instance->subscriberGroups()->add(demux))
+{
+}
+
+void
+SubscriberDemux::flush()
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
+    //
+    // The events are handed over to the group, the next events are
+    // queued once the group delivered them.
+    //
+    if(_state != SubscriberStateOnline || _events.empty() || _outstanding > 0)
+    {
+        return;
+    }
+
+    EventDataSeq v;
+    v.swap(_events);
+    _conflated.clear();
+
+    ++_outstanding;
+    if(_observer)
+    {
+        _outstandingCount = static_cast<Ice::Int>(v.size());
+        _observer->outstanding(_outstandingCount);
+    }
+
+    if(_group->queue(this, v))
+    {
+        _instance->subscriberGroups()->schedule(_group);
+    }
+}
+
+void
+SubscriberDemux::destroy()
+{
+    Subscriber::destroy();
+    _instance->subscriberGroups()->remove(_group);
+}
+
 namespace
 {
 
@@ -474,6 +529,7 @@ SubscriberLink::flush()
 
     EventDataSeq v;
     v.swap(_events);
+    _conflated.clear();
 
     EventDataSeq::iterator p = v.begin();
     while(p != v.end())
@@ -598,7 +654,85 @@ Subscriber::create(
                 newObj = newObj->ice_connectionCached(connectionCached > 0);
             }
 
-            if(reliability == "ordered")
+            Ice::ObjectPrx demux;
+            p = rec.theQoS.find("demultiplexer");
+            if(p != rec.theQoS.end())
+            {
+                try
+                {
+                    demux = instance->communicator()->stringToProxy(p->second);
+                }
+                catch(const Ice::LocalException&)
+                {
+                }
+                if(!demux)
+                {
+                    throw BadQoS("invalid demultiplexer proxy: " + p->second);
+                }
+                if(demux->ice_isBatchOneway() || demux->ice_isBatchDatagram())
+                {
+                    throw BadQoS("the demultiplexer proxy can't be a batch proxy");
+                }
+                if(reliability == "ordered")
+                {
+                    throw BadQoS("ordered reliability doesn't support a demultiplexer");
+                }
+                try
+                {
+                    demux = demux->ice_timeout(instance->sendTimeout());
+                }
+                catch(const Ice::FixedProxyException&)
+                {
+                }
+            }
+
+            p = rec.theQoS.find("multicast");
+            if(p != rec.theQoS.end())
+            {
+                if(demux)
+                {
+                    throw BadQoS("the multicast and demultiplexer QoS can't be used together");
+                }
+                if(reliability == "ordered")
+                {
+                    throw BadQoS("ordered reliability doesn't support multicast");
+                }
+                Ice::ObjectPrx group;
+                try
+                {
+                    group = instance->communicator()->stringToProxy("group:" + p->second);
+                }
+                catch(const Ice::LocalException&)
+                {
+                }
+                if(!group)
+                {
+                    throw BadQoS("invalid multicast endpoint: " + p->second);
+                }
+                Ice::EndpointSeq endpoints = group->ice_getEndpoints();
+                for(Ice::EndpointSeq::const_iterator q = endpoints.begin(); q != endpoints.end(); ++q)
+                {
+                    if((*q)->getInfo()->type() != Ice::UDPEndpointType)
+                    {
+                        throw BadQoS("the multicast endpoint must be a UDP endpoint: " + p->second);
+                    }
+                }
+
+                //
+                // The subscribers of the topic that join the same
+                // multicast group share a datagram demultiplexer with the
+                // identity of the topic: each event is sent once to the
+                // group and dispatched by the demultiplexer of each
+                // subscriber process that joined the group.
+                //
+                demux = group->ice_identity(IceStormInternal::nameToIdentity(instance, rec.topicName))->ice_datagram();
+            }
+
+            if(demux)
+            {
+                subscriber = new SubscriberDemux(instance, rec, proxy, retryCount, demux);
+            }
+            else if(reliability == "ordered")
             {
                 if(!newObj->ice_isTwoway())
                 {
@@ -631,6 +765,100 @@ Subscriber::create(
     }
 }
 
+EventFilterPtr
+EventFilter::create(const QoS& qos)
+{
+    EventFilterPtr filter;
+    for(QoS::const_iterator p = qos.begin(); p != qos.end(); ++p)
+    {
+        if(p->first.compare(0, 7, "filter.") != 0)
+        {
+            continue;
+        }
+
+        if(!filter)
+        {
+            filter = new EventFilter();
+        }
+
+        if(p->first == "filter.operations")
+        {
+            vector<string> operations;
+            IceUtilInternal::splitString(p->second, ", \t", operations);
+            if(operations.empty())
+            {
+                throw BadQoS("invalid filter.operations: no operations");
+            }
+            for(vector<string>::const_iterator q = operations.begin(); q != operations.end(); ++q)
+            {
+                Pattern pattern(*q);
+                if(pattern.prefix)
+                {
+                    filter->_operationPrefixes.push_back(pattern);
+                }
+                else
+                {
+                    filter->_operations.insert(pattern.value);
+                }
+            }
+        }
+        else if(p->first.compare(0, 15, "filter.context.") == 0 && p->first.size() > 15)
+        {
+            filter->_context.push_back(make_pair(p->first.substr(15), Pattern(p->second)));
+        }
+        else
+        {
+            throw BadQoS("invalid filter: " + p->first);
+        }
+    }
+    return filter;
+}
+
+bool
+EventFilter::match(const EventDataPtr& event) const
+{
+    if(!_operations.empty() || !_operationPrefixes.empty())
+    {
+        if(_operations.find(event->op) == _operations.end())
+        {
+            vector<Pattern>::const_iterator p = _operationPrefixes.begin();
+            while(p != _operationPrefixes.end() && !p->match(event->op))
+            {
+                ++p;
+            }
+            if(p == _operationPrefixes.end())
+            {
+                return false;
+            }
+        }
+    }
+
+    for(vector<pair<string, Pattern> >::const_iterator p = _context.begin(); p != _context.end(); ++p)
+    {
+        Ice::Context::const_iterator q = event->context.find(p->first);
+        if(q == event->context.end() || !p->second.match(q->second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+EventFilter::Pattern::Pattern(const string& v) :
+    value(v), prefix(!v.empty() && v[v.size() - 1] == '*')
+{
+    if(prefix)
+    {
+        value.resize(value.size() - 1);
+    }
+}
+
+bool
+EventFilter::Pattern::match(const string& s) const
+{
+    return prefix ? s.compare(0, value.size(), value) == 0 : s == value;
+}
+
 Ice::ObjectPrx
 Subscriber::proxy() const
 {
@@ -650,8 +878,25 @@ Subscriber::record() const
 }
 
 bool
-Subscriber::queue(bool forwarded, const EventDataSeq& events)
+Subscriber::queue(bool forwarded, const EventDataSeq& allEvents)
 {
+    //
+    // The filter is immutable, the events are filtered before locking
+    // the subscriber.
+    //
+    EventDataSeq filtered;
+    if(_filter)
+    {
+        for(EventDataSeq::const_iterator p = allEvents.begin(); p != allEvents.end(); ++p)
+        {
+            if(_filter->match(*p))
+            {
+                filtered.push_back(*p);
+            }
+        }
+    }
+    const EventDataSeq& events = _filter ? filtered : allEvents;
+
     IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
 
     // If this is a link subscriber if the set of events were
@@ -662,6 +907,12 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
         return true;
     }
 
+    // If all the events were filtered out, there's nothing to queue.
+    if(_filter && events.empty())
+    {
+        return _state != SubscriberStateError;
+    }
+
     switch(_state)
     {
     case SubscriberStateOffline:
@@ -680,8 +931,28 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
 
     case SubscriberStateOnline:
     {
+        Ice::Int conflated = 0;
         for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
         {
+            //
+            // An event with a conflation key replaces the pending event
+            // with the same key, if any.
+            //
+            const string* key = 0;
+            if(!_conflationKey.empty())
+            {
+                Ice::Context::const_iterator q = (*p)->context.find(_conflationKey);
+                if(q != (*p)->context.end())
+                {
+                    key = &q->second;
+                    if(conflate(*key, *p))
+                    {
+                        ++conflated;
+                        continue;
+                    }
+                }
+            }
+
             if(static_cast<int>(_events.size()) == _instance->sendQueueSizeMax())
             {
                 if(_instance->sendQueueSizeMaxPolicy() == Instance::RemoveSubscriber)
@@ -692,14 +963,39 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
                 else // DropEvents
                 {
                     _events.pop_front();
+                    ++_eventsOffset;
                 }
             }
             _events.push_back(*p);
+
+            if(key)
+            {
+                _conflated[*key] = _eventsOffset + static_cast<Ice::Long>(_events.size()) - 1;
+            }
+        }
+
+        //
+        // Remove the conflation keys of the events no longer pending.
+        //
+        if(_conflated.size() > 2 * _events.size() + 1024)
+        {
+            map<string, Ice::Long>::iterator q = _conflated.begin();
+            while(q != _conflated.end())
+            {
+                if(q->second < _eventsOffset)
+                {
+                    _conflated.erase(q++);
+                }
+                else
+                {
+                    ++q;
+                }
+            }
         }
 
         if(_observer)
         {
-            _observer->queued(static_cast<Ice::Int>(events.size()));
+            _observer->queued(static_cast<Ice::Int>(events.size()) - conflated);
         }
         flush();
         break;
@@ -744,6 +1040,20 @@ Subscriber::errored() const
     return _state >= SubscriberStateError;
 }
 
+bool
+Subscriber::waitForQueued(size_t size)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    while(_events.size() > size && _state == SubscriberStateOnline && !_shutdown)
+    {
+        //
+        // The monitor is only notified on shutdown, poll the queue.
+        //
+        _lock.timedWait(IceUtil::Time::milliSeconds(10));
+    }
+    return _state == SubscriberStateOnline && !_shutdown;
+}
+
 void
 Subscriber::destroy()
 {
@@ -855,12 +1165,14 @@ Subscriber::error(bool dec, const Ice::Exception& e)
         _next = now + _instance->discardInterval();
         ++_currentRetry;
         _events.clear();
+        _conflated.clear();
         setState(SubscriberStateOffline);
     }
     // Errored out.
     else if(_state < SubscriberStateError)
     {
         _events.clear();
+        _conflated.clear();
         setState(SubscriberStateError);
 
         TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -889,35 +1201,41 @@ Subscriber::completed(const Ice::AsyncResultPtr& result)
     try
     {
         result->throwLocalException();
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        error(true, ex);
+        return;
+    }
+    delivered();
+}
 
-        IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+void
+Subscriber::delivered()
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
 
-        // Decrement the _outstanding count.
-        --_outstanding;
-        assert(_outstanding >= 0 && _outstanding < _maxOutstanding);
-        if(_observer)
-        {
-            _observer->delivered(_outstandingCount);
-        }
+    // Decrement the _outstanding count.
+    --_outstanding;
+    assert(_outstanding >= 0 && _outstanding < _maxOutstanding);
+    if(_observer)
+    {
+        _observer->delivered(_outstandingCount);
+    }
 
-        //
-        // A successful response means we're no longer retrying, we're
-        // back active.
-        //
-        _currentRetry = 0;
+    //
+    // A successful response means we're no longer retrying, we're
+    // back active.
+    //
+    _currentRetry = 0;
 
-        if(_events.empty() && _outstanding == 0 && _shutdown)
-        {
-            _lock.notify();
-        }
-        else
-        {
-            flush();
-        }
+    if(_events.empty() && _outstanding == 0 && _shutdown)
+    {
+        _lock.notify();
     }
-    catch(const Ice::LocalException& ex)
+    else
     {
-        error(true, ex);
+        flush();
     }
 }
 
@@ -963,12 +1281,20 @@ Subscriber::Subscriber(
     _maxOutstanding(maxOutstanding),
     _proxy(proxy),
     _proxyReplica(proxy),
+    _filter(EventFilter::create(rec.theQoS)),
     _shutdown(false),
     _state(SubscriberStateOnline),
     _outstanding(0),
     _outstandingCount(1),
+    _eventsOffset(0),
     _currentRetry(0)
 {
+    QoS::const_iterator p = rec.theQoS.find("conflationKey");
+    if(p != rec.theQoS.end())
+    {
+        const_cast<string&>(_conflationKey) = p->second;
+    }
+
     if(_proxy && _instance->publisherReplicaProxy())
     {
         const_cast<Ice::ObjectPrx&>(_proxyReplica) =
@@ -1010,6 +1336,30 @@ stateToString(Subscriber::SubscriberState state)
 
 }
 
+bool
+Subscriber::conflate(const string& key, const EventDataPtr& event)
+{
+    //
+    // The recorded position is checked against the current queue since
+    // the pending event might have been sent or dropped since.
+    //
+    map<string, Ice::Long>::const_iterator p = _conflated.find(key);
+    if(p == _conflated.end() || p->second < _eventsOffset ||
+       p->second - _eventsOffset >= static_cast<Ice::Long>(_events.size()))
+    {
+        return false;
+    }
+
+    EventDataPtr& pending = _events[static_cast<size_t>(p->second - _eventsOffset)];
+    Ice::Context::const_iterator q = pending->context.find(_conflationKey);
+    if(q == pending->context.end() || q->second != key)
+    {
+        return false;
+    }
+    pending = event;
+    return true;
+}
+
 void
 Subscriber::setState(Subscriber::SubscriberState state)
 {
@@ -1037,6 +1387,578 @@ Subscriber::setState(Subscriber::SubscriberState state)
     }
 }
 
+namespace
+{
+
+void
+queueEvents(bool forwarded, const EventDataSeq& events, vector<SubscriberPtr>::const_iterator p,
+            vector<SubscriberPtr>::const_iterator end, Ice::IdentitySeq& reap)
+{
+    for(; p != end; ++p)
+    {
+        if(!(*p)->queue(forwarded, events) && (*p)->reap())
+        {
+            reap.push_back((*p)->id());
+        }
+    }
+}
+
+}
+
+//
+// The partitions of a publish call. The events and the subscribers are
+// owned by the publishing thread which waits for all the partitions to
+// be queued before returning.
+//
+class FanOutPool::Batch : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    Batch(bool forwardedP, const EventDataSeq& eventsP, int pendingP) :
+        forwarded(forwardedP), events(eventsP), pending(pendingP)
+    {
+    }
+
+    const bool forwarded;
+    const EventDataSeq& events;
+    int pending;
+    Ice::IdentitySeq reap;
+};
+
+class FanOutPool::Worker : public IceUtil::Thread
+{
+public:
+
+    Worker(const FanOutPoolPtr& pool) : IceUtil::Thread("IceStorm fan-out thread"), _pool(pool)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _pool->run();
+    }
+
+private:
+
+    const FanOutPoolPtr _pool;
+};
+
+FanOutPool::FanOutPool(const Ice::LoggerPtr& logger, int threads, int partitionSize) :
+    _logger(logger),
+    _threads(static_cast<size_t>(max(threads, 0))),
+    _partitionSize(static_cast<size_t>(max(partitionSize, 1))),
+    _destroyed(false)
+{
+    __setNoDelete(true);
+    try
+    {
+        for(size_t i = 0; i < _threads; ++i)
+        {
+            IceUtil::ThreadPtr worker = new Worker(this);
+            worker->start();
+            _workers.push_back(worker);
+        }
+    }
+    catch(...)
+    {
+        destroy();
+        __setNoDelete(false);
+        throw;
+    }
+    __setNoDelete(false);
+}
+
+void
+FanOutPool::queue(bool forwarded, const EventDataSeq& events, const vector<SubscriberPtr>& subscribers,
+                  Ice::IdentitySeq& reap)
+{
+    const size_t partitions = min((subscribers.size() + _partitionSize - 1) / _partitionSize, _threads + 1);
+    if(partitions <= 1)
+    {
+        queueEvents(forwarded, events, subscribers.begin(), subscribers.end(), reap);
+        return;
+    }
+
+    BatchPtr batch = new Batch(forwarded, events, static_cast<int>(partitions));
+    {
+        Lock sync(*this);
+        if(_destroyed)
+        {
+            sync.release();
+            queueEvents(forwarded, events, subscribers.begin(), subscribers.end(), reap);
+            return;
+        }
+
+        for(size_t i = 1; i < partitions; ++i)
+        {
+            Partition partition;
+            partition.batch = batch;
+            partition.begin = subscribers.begin() + subscribers.size() * i / partitions;
+            partition.end = subscribers.begin() + subscribers.size() * (i + 1) / partitions;
+            _partitions.push_back(partition);
+            notify();
+        }
+    }
+
+    //
+    // Queue the first partition and the partitions not yet picked up
+    // by a worker thread from this thread, then wait for the workers
+    // to queue the remaining partitions.
+    //
+    Partition partition;
+    partition.batch = batch;
+    partition.begin = subscribers.begin();
+    partition.end = subscribers.begin() + subscribers.size() / partitions;
+    while(true)
+    {
+        queue(partition);
+
+        Lock sync(*this);
+        deque<Partition>::iterator p = _partitions.begin();
+        while(p != _partitions.end() && p->batch.get() != batch.get())
+        {
+            ++p;
+        }
+        if(p == _partitions.end())
+        {
+            break;
+        }
+        partition = *p;
+        _partitions.erase(p);
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*batch);
+    while(batch->pending > 0)
+    {
+        batch->wait();
+    }
+    reap.insert(reap.end(), batch->reap.begin(), batch->reap.end());
+}
+
+void
+FanOutPool::destroy()
+{
+    vector<IceUtil::ThreadPtr> workers;
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        notifyAll();
+        workers.swap(_workers);
+    }
+
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = workers.begin(); p != workers.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+}
+
+void
+FanOutPool::run()
+{
+    while(true)
+    {
+        Partition partition;
+        {
+            Lock sync(*this);
+            while(_partitions.empty() && !_destroyed)
+            {
+                wait();
+            }
+
+            //
+            // Partitions queued before the destruction are still
+            // processed, the publishing threads are waiting for them.
+            //
+            if(_partitions.empty())
+            {
+                return;
+            }
+            partition = _partitions.front();
+            _partitions.pop_front();
+        }
+        queue(partition);
+    }
+}
+
+void
+FanOutPool::queue(const Partition& partition)
+{
+    Ice::IdentitySeq reap;
+    try
+    {
+        queueEvents(partition.batch->forwarded, partition.batch->events, partition.begin, partition.end, reap);
+    }
+    catch(const std::exception& ex)
+    {
+        Ice::Warning out(_logger);
+        out << "unexpected exception while queuing events:\n" << ex;
+    }
+    catch(...)
+    {
+        Ice::Warning out(_logger);
+        out << "unexpected exception while queuing events";
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*partition.batch);
+    partition.batch->reap.insert(partition.batch->reap.end(), reap.begin(), reap.end());
+    if(--partition.batch->pending == 0)
+    {
+        partition.batch->notifyAll();
+    }
+}
+
+//
+// A round is the set of deliver requests sent for the events queued to
+// the group. Each member is notified once all the requests completed,
+// or as soon as a request for its events failed.
+//
+class SubscriberGroup::Round : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    //
+    // The round starts with a pending reference released by the sender
+    // once all the requests of the round are sent.
+    //
+    Round(const SubscriberGroupPtr& group, const vector<SubscriberPtr>& members) :
+        _group(group),
+        _members(members),
+        _pending(1)
+    {
+    }
+
+    void
+    add()
+    {
+        Lock sync(*this);
+        ++_pending;
+    }
+
+    void
+    finished(const vector<SubscriberPtr>& subscribers, const Ice::Exception* ex)
+    {
+        vector<SubscriberPtr> failed;
+        bool done;
+        {
+            Lock sync(*this);
+            if(ex)
+            {
+                for(vector<SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+                {
+                    if(_failed.insert(p->get()).second)
+                    {
+                        failed.push_back(*p);
+                    }
+                }
+            }
+            done = --_pending == 0;
+        }
+
+        for(vector<SubscriberPtr>::const_iterator p = failed.begin(); p != failed.end(); ++p)
+        {
+            (*p)->error(true, *ex);
+        }
+
+        if(done)
+        {
+            for(vector<SubscriberPtr>::const_iterator p = _members.begin(); p != _members.end(); ++p)
+            {
+                if(_failed.find(p->get()) == _failed.end())
+                {
+                    (*p)->delivered();
+                }
+            }
+            _group->sent();
+        }
+    }
+
+private:
+
+    const SubscriberGroupPtr _group;
+    const vector<SubscriberPtr> _members;
+    size_t _pending;
+    set<Subscriber*> _failed;
+};
+
+class SubscriberGroup::DeliverCallback : public IceUtil::Shared
+{
+public:
+
+    DeliverCallback(const RoundPtr& round, const vector<SubscriberPtr>& subscribers) :
+        _round(round),
+        _subscribers(subscribers)
+    {
+        _round->add();
+    }
+
+    void
+    completed(const Ice::AsyncResultPtr& result)
+    {
+        //
+        // A oneway request completes once sent, the completion is only
+        // called for a oneway request if sending failed.
+        //
+        try
+        {
+            vector<Ice::Byte> outParams;
+            if(!result->getProxy()->end_ice_invoke(outParams, result))
+            {
+                throw Ice::UnknownUserException(__FILE__, __LINE__, "deliver failed with a user exception");
+            }
+        }
+        catch(const Ice::Exception& ex)
+        {
+            _round->finished(_subscribers, &ex);
+            return;
+        }
+        if(result->getProxy()->ice_isTwoway())
+        {
+            _round->finished(_subscribers, 0);
+        }
+    }
+
+    void
+    sent(const Ice::AsyncResultPtr& result)
+    {
+        if(!result->getProxy()->ice_isTwoway())
+        {
+            _round->finished(_subscribers, 0);
+        }
+    }
+
+    void
+    exception(const Ice::Exception& ex)
+    {
+        _round->finished(_subscribers, &ex);
+    }
+
+private:
+
+    const RoundPtr _round;
+    const vector<SubscriberPtr> _subscribers;
+};
+
+SubscriberGroup::SubscriberGroup(const Ice::ObjectPrx& obj) :
+    _obj(obj),
+    _maxSize(0),
+    _sending(false)
+{
+    if(_obj->ice_isDatagram())
+    {
+        //
+        // A datagram can't be larger than the UDP send buffer or the
+        // maximum UDP payload with IPv6. The request header takes at
+        // most 64 bytes in addition to the identity.
+        //
+        size_t max = 65535 - 48;
+        Ice::Int sndSize = _obj->ice_getCommunicator()->getProperties()->getPropertyAsInt("Ice.UDP.SndSize");
+        if(sndSize > 0 && static_cast<size_t>(sndSize) < max)
+        {
+            max = static_cast<size_t>(sndSize);
+        }
+        const Ice::Identity id = _obj->ice_getIdentity();
+        size_t header = 64 + id.name.size() + id.category.size();
+        _maxSize = max > header ? max - header : 1;
+    }
+}
+
+Ice::ObjectPrx
+SubscriberGroup::proxy() const
+{
+    return _obj;
+}
+
+bool
+SubscriberGroup::queue(const SubscriberPtr& subscriber, const EventDataSeq& events)
+{
+    Lock sync(*this);
+
+    bool schedule = _entries.empty() && !_sending;
+    _members.push_back(subscriber);
+
+    //
+    // An event queued by several members is sent once. The events of a
+    // member are only merged with the entries following its previous
+    // event to preserve the order of its events.
+    //
+    size_t last = 0;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        map<EventData*, size_t>::iterator q = _index.find(p->get());
+        if(q != _index.end() && q->second >= last)
+        {
+            _entries[q->second].subscribers.push_back(subscriber);
+            last = q->second;
+        }
+        else
+        {
+            Entry entry;
+            entry.event = *p;
+            entry.subscribers.push_back(subscriber);
+            last = _entries.size();
+            _entries.push_back(entry);
+            _index[p->get()] = last;
+        }
+    }
+    return schedule;
+}
+
+void
+SubscriberGroup::send()
+{
+    vector<Entry> entries;
+    vector<SubscriberPtr> members;
+    {
+        Lock sync(*this);
+        if(_sending || _entries.empty())
+        {
+            return;
+        }
+        _sending = true;
+        entries.swap(_entries);
+        members.swap(_members);
+        _index.clear();
+    }
+
+    //
+    // Send a deliver request for each run of consecutive events with the
+    // same recipients. The requests are sent without the group locked,
+    // the callbacks might be called from this thread.
+    //
+    vector<vector<Entry>::const_iterator> runs;
+    for(vector<Entry>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        if(runs.empty() || runs.back()->subscribers != p->subscribers)
+        {
+            runs.push_back(p);
+        }
+    }
+    runs.push_back(entries.end());
+
+    RoundPtr round = new Round(this, members);
+    for(size_t i = 0; i < runs.size() - 1; ++i)
+    {
+        deliver(round, runs[i]->subscribers, runs[i], runs[i + 1]);
+    }
+    round->finished(vector<SubscriberPtr>(), 0);
+}
+
+void
+SubscriberGroup::deliver(const RoundPtr& round, const vector<SubscriberPtr>& subscribers,
+                         vector<Entry>::const_iterator first, vector<Entry>::const_iterator last)
+{
+    //
+    // The request parameters are sent from the stream buffer, the event
+    // data is only copied once into the stream.
+    //
+    Ice::OutputStream out(_obj->ice_getCommunicator(), _obj->ice_getEncodingVersion());
+    out.startEncapsulation();
+    out.writeSize(static_cast<Ice::Int>(subscribers.size()));
+    for(vector<SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        out.write((*p)->id());
+    }
+    out.writeSize(static_cast<Ice::Int>(last - first));
+    for(vector<Entry>::const_iterator p = first; p != last; ++p)
+    {
+        out.write(p->event->op);
+        out.write(p->event->mode);
+        out.write(p->event->data);
+        out.write(p->event->context);
+    }
+    out.endEncapsulation();
+
+    //
+    // Split the events of a datagram request that doesn't fit in a
+    // datagram, a single event too large for a datagram fails like with
+    // a datagram subscriber.
+    //
+    if(_maxSize > 0 && out.b.size() > _maxSize && last - first > 1)
+    {
+        vector<Entry>::const_iterator middle = first + (last - first) / 2;
+        deliver(round, subscribers, first, middle);
+        deliver(round, subscribers, middle, last);
+        return;
+    }
+
+    IceUtil::Handle<DeliverCallback> cb = new DeliverCallback(round, subscribers);
+    try
+    {
+        _obj->begin_ice_invoke("deliver", Ice::Normal, out.finished(),
+                               Ice::newCallback(cb, &DeliverCallback::completed, &DeliverCallback::sent));
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cb->exception(ex);
+    }
+}
+
+void
+SubscriberGroup::sent()
+{
+    {
+        Lock sync(*this);
+        _sending = false;
+    }
+
+    //
+    // Send the events queued by the members while the previous events
+    // were being delivered.
+    //
+    send();
+}
+
+SubscriberGroupPtr
+SubscriberGroups::add(const Ice::ObjectPrx& obj)
+{
+    Lock sync(*this);
+    pair<SubscriberGroupPtr, int>& group = _groups[obj->ice_toString()];
+    if(!group.first)
+    {
+        group.first = new SubscriberGroup(obj);
+    }
+    ++group.second;
+    return group.first;
+}
+
+void
+SubscriberGroups::remove(const SubscriberGroupPtr& group)
+{
+    Lock sync(*this);
+    map<string, pair<SubscriberGroupPtr, int> >::iterator p = _groups.find(group->proxy()->ice_toString());
+    if(p != _groups.end() && p->second.first.get() == group.get() && --p->second.second == 0)
+    {
+        _groups.erase(p);
+    }
+}
+
+void
+SubscriberGroups::schedule(const SubscriberGroupPtr& group)
+{
+    Lock sync(*this);
+    _scheduled.push_back(group);
+}
+
+void
+SubscriberGroups::flush()
+{
+    vector<SubscriberGroupPtr> scheduled;
+    {
+        Lock sync(*this);
+        if(_scheduled.empty())
+        {
+            return;
+        }
+        scheduled.swap(_scheduled);
+    }
+
+    for(vector<SubscriberGroupPtr>::const_iterator p = scheduled.begin(); p != scheduled.end(); ++p)
+    {
+        (*p)->send();
+    }
+}
+
 bool
 IceStorm::operator==(const SubscriberPtr& subscriber, const Ice::Identity& id)
 {
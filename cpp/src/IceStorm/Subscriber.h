@@ -10,6 +10,10 @@
 #include <IceStorm/Instrumentation.h>
 #include <Ice/ObserverHelper.h>
 #include <IceUtil/RecMutex.h>
+#include <IceUtil/Thread.h>
+#include <deque>
+#include <map>
+#include <set>
 
 namespace IceStorm
 {
@@ -20,6 +24,49 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class EventFilter;
+typedef IceUtil::Handle<EventFilter> EventFilterPtr;
+
+class SubscriberGroup;
+typedef IceUtil::Handle<SubscriberGroup> SubscriberGroupPtr;
+
+//
+// The events filter of a subscriber, compiled from the filter QoS
+// entries:
+//
+// - filter.operations: a comma separated list of operation names.
+// - filter.context.<key>: the value of the <key> context entry.
+//
+// A name or value ending with `*' matches any string starting with
+// this prefix. An event is accepted if its operation matches one of
+// the operations and its context matches all the context entries.
+//
+class EventFilter : public IceUtil::Shared
+{
+public:
+
+    // Returns null if the QoS doesn't define a filter.
+    static EventFilterPtr create(const QoS&);
+
+    bool match(const EventDataPtr&) const;
+
+private:
+
+    struct Pattern
+    {
+        Pattern(const std::string&);
+
+        bool match(const std::string&) const;
+
+        std::string value;
+        bool prefix;
+    };
+
+    std::set<std::string> _operations;
+    std::vector<Pattern> _operationPrefixes;
+    std::vector<std::pair<std::string, Pattern> > _context;
+};
+
 class Subscriber : public IceUtil::Shared
 {
 public:
@@ -36,10 +83,15 @@ public:
     void resetIfReaped();
     bool errored() const;
 
-    void destroy();
+    // Wait for the queue to shrink to the given size, returns false if
+    // the subscriber is no longer online.
+    bool waitForQueued(size_t);
+
+    virtual void destroy();
 
     // To be called by the AMI callbacks only.
     void completed(const Ice::AsyncResultPtr&);
+    void delivered();
     void error(bool, const Ice::Exception&);
 
     void shutdown();
@@ -59,6 +111,7 @@ public:
 protected:
 
     void setState(SubscriberState);
+    bool conflate(const std::string&, const EventDataPtr&);
 
     Subscriber(const InstancePtr&, const IceStorm::SubscriberRecord&, const Ice::ObjectPrx&, int, int);
 
@@ -69,6 +122,8 @@ protected:
     const int _maxOutstanding; // The maximum number of oustanding events.
     const Ice::ObjectPrx _proxy; // The per subscriber object proxy, if any.
     const Ice::ObjectPrx _proxyReplica; // The replicated per subscriber object proxy, if any.
+    const EventFilterPtr _filter; // The events filter, if any.
+    const std::string _conflationKey; // The context key of conflated events, if any.
 
     IceUtil::Monitor<IceUtil::RecMutex> _lock;
 
@@ -79,6 +134,8 @@ protected:
     int _outstanding; // The current number of outstanding responses.
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
     EventDataSeq _events; // The queue of events to send.
+    Ice::Long _eventsOffset; // The number of events removed from the front of the queue.
+    std::map<std::string, Ice::Long> _conflated; // The queue position of the pending event of each conflation key.
 
     // The next time to try sending a new event if we're offline.
     IceUtil::Time _next;
@@ -87,6 +144,124 @@ protected:
     IceInternal::ObserverHelperT<IceStorm::Instrumentation::SubscriberObserver> _observer;
 };
 
+//
+// Queues events to the subscribers of a topic. Large subscriber sets
+// are split in partitions which are queued in parallel by the pool
+// threads and the publishing thread.
+//
+class FanOutPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    FanOutPool(const Ice::LoggerPtr&, int, int);
+
+    // Queue the events to each subscriber, the ids of the subscribers
+    // that must be reaped are added to the given sequence.
+    void queue(bool, const EventDataSeq&, const std::vector<SubscriberPtr>&, Ice::IdentitySeq&);
+
+    void destroy();
+
+private:
+
+    class Batch;
+    typedef IceUtil::Handle<Batch> BatchPtr;
+
+    struct Partition
+    {
+        BatchPtr batch;
+        std::vector<SubscriberPtr>::const_iterator begin;
+        std::vector<SubscriberPtr>::const_iterator end;
+    };
+
+    class Worker;
+    friend class Worker;
+
+    void run();
+    void queue(const Partition&);
+
+    const Ice::LoggerPtr _logger;
+    const size_t _threads;
+    const size_t _partitionSize;
+
+    std::vector<IceUtil::ThreadPtr> _workers;
+    std::deque<Partition> _partitions;
+    bool _destroyed;
+};
+typedef IceUtil::Handle<FanOutPool> FanOutPoolPtr;
+
+//
+// The subscribers sharing a demultiplexer, see the demultiplexer and
+// multicast QoS. The events queued by the members of the group are sent
+// with a single IceStorm::Demultiplexer::deliver request for each run of
+// events with the same recipients. The requests to a datagram
+// demultiplexer, such as a multicast group, are split to fit in a
+// datagram.
+//
+class SubscriberGroup : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    SubscriberGroup(const Ice::ObjectPrx&);
+
+    Ice::ObjectPrx proxy() const;
+
+    // Queue the events of a member, returns true if the group must be
+    // scheduled for sending.
+    bool queue(const SubscriberPtr&, const EventDataSeq&);
+
+    // Send the queued events unless a previous send is outstanding.
+    void send();
+
+private:
+
+    struct Entry
+    {
+        EventDataPtr event;
+        std::vector<SubscriberPtr> subscribers;
+    };
+
+    class Round;
+    typedef IceUtil::Handle<Round> RoundPtr;
+    class DeliverCallback;
+    friend class Round;
+
+    void deliver(const RoundPtr&, const std::vector<SubscriberPtr>&, std::vector<Entry>::const_iterator,
+                 std::vector<Entry>::const_iterator);
+    void sent();
+
+    const Ice::ObjectPrx _obj;
+    size_t _maxSize; // The maximum size of the request parameters of a datagram demultiplexer.
+
+    std::vector<Entry> _entries;
+    std::map<EventData*, size_t> _index;
+    std::vector<SubscriberPtr> _members;
+    bool _sending;
+};
+
+//
+// The subscriber groups of the service, indexed by demultiplexer proxy.
+//
+class SubscriberGroups : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    SubscriberGroupPtr add(const Ice::ObjectPrx&);
+    void remove(const SubscriberGroupPtr&);
+
+    // Schedule the group to be sent on the next flush.
+    void schedule(const SubscriberGroupPtr&);
+
+    // Send the events queued to the scheduled groups, called once the
+    // events of a publish request are queued.
+    void flush();
+
+private:
+
+    std::map<std::string, std::pair<SubscriberGroupPtr, int> > _groups;
+    std::vector<SubscriberGroupPtr> _scheduled;
+};
+typedef IceUtil::Handle<SubscriberGroups> SubscriberGroupsPtr;
+
 bool operator==(const IceStorm::SubscriberPtr&, const Ice::Identity&);
 bool operator==(const IceStorm::Subscriber&, const IceStorm::Subscriber&);
 bool operator!=(const IceStorm::Subscriber&, const IceStorm::Subscriber&);
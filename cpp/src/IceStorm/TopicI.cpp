@@ -10,6 +10,7 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/InputUtil.h>
 #include <algorithm>
 
 using namespace std;
@@ -46,17 +47,8 @@ public:
                const Ice::Current& current)
     {
         // The publish call does a cached read.
-        EventDataPtr event = new EventData(current.operation, current.mode, Ice::ByteSeq(), current.ctx);
-
-        //
-        // COMPILERBUG: gcc 4.0.1 doesn't like this.
-        //
-        //event->data.swap(Ice::ByteSeq(inParams.first, inParams.second));
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event->data.swap(data);
-
         EventDataSeq v;
-        v.push_back(event);
+        v.push_back(IceStormInternal::createEvent(inParams, current));
         _topic->publish(false, v);
 
         return true;
@@ -380,6 +372,15 @@ TopicImpl::TopicImpl(
             linkid.name = _name + ".link";
         }
 
+        if(!_instance->eventLogPath().empty())
+        {
+            _eventLog = new EventLog(_instance->communicator(),
+                                     EventLog::directory(_instance->eventLogPath(), _name),
+                                     _instance->eventLogSegmentSize(),
+                                     _instance->eventLogSizeMax(),
+                                     _instance->eventLogSync());
+        }
+
         _publisherPrx = _instance->publishAdapter()->add(new PublisherI(this, instance), pubid);
         _linkPrx = TopicLinkPrx::uncheckedCast(
             _instance->publishAdapter()->add(new TopicLinkI(this, instance), linkid));
@@ -502,6 +503,24 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     }
     Ice::Identity id = obj->ice_getIdentity();
 
+    //
+    // Subscribers can request the events from the event log starting
+    // at the given offset.
+    //
+    Ice::Long replayFrom = -1;
+    QoS::const_iterator q = qos.find("replayFrom");
+    if(q != qos.end())
+    {
+        if(!_eventLog)
+        {
+            throw BadQoS("the event log is not enabled for topic `" + _name + "'");
+        }
+        if(!IceUtilInternal::stringToInt64(q->second, replayFrom) || replayFrom < 0)
+        {
+            throw BadQoS("invalid replayFrom value `" + q->second + "'");
+        }
+    }
+
     TraceLevelsPtr traceLevels = _instance->traceLevels();
 
     IceUtil::Mutex::Lock sync(_subscribersMutex);
@@ -536,7 +555,7 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     record.cost = 0;
 
     vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    if(p != _subscribers.end() || find(_replaying.begin(), _replaying.end(), record.id) != _replaying.end())
     {
         throw AlreadySubscribed();
     }
@@ -564,13 +583,97 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
         throw; // will become UnknownException in caller
     }
 
-    _subscribers.push_back(subscriber);
-
     _instance->observers()->addSubscriber(llu, _name, record);
 
+    if(replayFrom < 0)
+    {
+        _subscribers.push_back(subscriber);
+        return subscriber->proxy();
+    }
+
+    if(traceLevels->topic > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+        out << _name << ": replaying events from offset " << replayFrom << " to "
+            << _instance->communicator()->identityToString(id);
+    }
+
+    //
+    // The subscriber doesn't receive the published events until the
+    // replay caught up with the event log.
+    //
+    _replaying.push_back(subscriber);
+    sync.release();
+    replay(subscriber, replayFrom);
     return subscriber->proxy();
 }
 
+void
+TopicImpl::replay(const SubscriberPtr& subscriber, Ice::Long offset)
+{
+    //
+    // The events are replayed in pages without holding the subscribers
+    // mutex, the next page is read once the subscriber sent most of the
+    // previous page. The last page is queued with the subscribers mutex
+    // locked, the subscriber then receives the published events.
+    //
+    size_t pageSize = 1000;
+    if(_instance->sendQueueSizeMax() > 0)
+    {
+        pageSize = min(pageSize, static_cast<size_t>(_instance->sendQueueSizeMax()));
+    }
+
+    while(true)
+    {
+        {
+            IceUtil::Mutex::Lock sync(_subscribersMutex);
+            vector<SubscriberPtr>::iterator p = find(_replaying.begin(), _replaying.end(), subscriber->id());
+            if(p == _replaying.end())
+            {
+                return; // Unsubscribed or destroyed.
+            }
+
+            if(_eventLog->nextOffset() - offset <= static_cast<Ice::Long>(pageSize))
+            {
+                EventDataSeq events = _eventLog->read(offset, pageSize);
+                if(!events.empty())
+                {
+                    subscriber->queue(false, events);
+                    _instance->subscriberGroups()->flush();
+                }
+                _replaying.erase(p);
+                _subscribers.push_back(subscriber);
+
+                TraceLevelsPtr traceLevels = _instance->traceLevels();
+                if(traceLevels->topic > 0)
+                {
+                    Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+                    out << _name << ": replayed events to offset " << offset << " to "
+                        << _instance->communicator()->identityToString(subscriber->id());
+                }
+                return;
+            }
+        }
+
+        if(!subscriber->waitForQueued(pageSize / 2))
+        {
+            //
+            // The subscriber is offline or errored, it doesn't receive
+            // the events until it's back online.
+            //
+            offset = max(offset, _eventLog->nextOffset());
+            continue;
+        }
+
+        EventDataSeq events = _eventLog->read(offset, pageSize);
+        if(!events.empty())
+        {
+            subscriber->queue(false, events);
+            _instance->subscriberGroups()->flush();
+        }
+    }
+}
+
 void
 TopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber)
 {
@@ -749,6 +852,10 @@ TopicImpl::shutdown()
     {
         (*p)->shutdown();
     }
+    for(vector<SubscriberPtr>::const_iterator p = _replaying.begin(); p != _replaying.end(); ++p)
+    {
+        (*p)->shutdown();
+    }
 
     _observer.detach();
 }
@@ -784,6 +891,10 @@ TopicImpl::getSubscribers() const
     {
         subscribers.push_back((*p)->id());
     }
+    for(vector<SubscriberPtr>::const_iterator p = _replaying.begin(); p != _replaying.end(); ++p)
+    {
+        subscribers.push_back((*p)->id());
+    }
     return subscribers;
 }
 
@@ -964,6 +1075,7 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         // in parallel.
         //
         vector<SubscriberPtr> copy;
+        IceStorm::Instrumentation::TopicObserverPtr observer;
         {
             IceUtil::Mutex::Lock sync(_subscribersMutex);
             if(_observer)
@@ -976,22 +1088,49 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
                 {
                     _observer->published();
                 }
+                observer = _observer.get();
             }
             copy = _subscribers;
+
+            //
+            // The events are appended to the event log with the
+            // subscribers mutex locked to ensure that subscribers
+            // replaying the log don't miss events.
+            //
+            if(_eventLog)
+            {
+                try
+                {
+                    _eventLog->append(events);
+                }
+                catch(const Ice::Exception& ex)
+                {
+                    Ice::Error error(_instance->traceLevels()->logger);
+                    error << _name << ": failed to append events to the event log:\n" << ex;
+                }
+            }
         }
 
         //
         // Queue each event, gathering a list of those subscribers that
-        // must be reaped.
+        // must be reaped. Large subscriber lists are queued in parallel
+        // by the fan-out pool.
         //
-        for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
+        if(observer)
         {
-            if(!(*p)->queue(forwarded, events) && (*p)->reap())
-            {
-                reap.push_back((*p)->id());
-            }
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            _instance->fanOutPool()->queue(forwarded, events, copy, reap);
+            observer->fannedOut(static_cast<Ice::Int>(copy.size()),
+                                (IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMicroSeconds());
+        }
+        else
+        {
+            _instance->fanOutPool()->queue(forwarded, events, copy, reap);
         }
 
+        // Send the events queued to the subscriber groups.
+        _instance->subscriberGroups()->flush();
+
         // If there are no subscribers in error then we're done.
         if(reap.empty())
         {
@@ -1247,9 +1386,19 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         (*p)->destroy();
     }
     _subscribers.clear();
+    for(vector<SubscriberPtr>::const_iterator p = _replaying.begin(); p != _replaying.end(); ++p)
+    {
+        (*p)->destroy();
+    }
+    _replaying.clear();
 
     _instance->topicAdapter()->remove(_id);
 
+    if(_eventLog)
+    {
+        _eventLog->destroy();
+    }
+
     _servant = 0;
 
     return llu;
@@ -1310,6 +1459,12 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
                 (*p)->destroy();
                 _subscribers.erase(p);
             }
+            p = find(_replaying.begin(), _replaying.end(), *id);
+            if(p != _replaying.end())
+            {
+                (*p)->destroy();
+                _replaying.erase(p);
+            }
         }
 
         _instance->observers()->removeSubscriber(llu, _name, ids);
@@ -8,6 +8,7 @@
 #include <IceStorm/IceStormInternal.h>
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
+#include <IceStorm/EventLog.h>
 #include <IceStorm/Util.h>
 #include <Ice/ObserverHelper.h>
 #include <list>
@@ -66,6 +67,7 @@ private:
 
     IceStormElection::LogUpdate destroyInternal(const IceStormElection::LogUpdate&, bool);
     void removeSubscribers(const Ice::IdentitySeq&);
+    void replay(const SubscriberPtr&, Ice::Long);
 
     //
     // Immutable members.
@@ -94,8 +96,14 @@ private:
     //
     std::vector<SubscriberPtr> _subscribers;
 
+    // The subscribers replaying the event log, they are moved to the
+    // subscribers once they caught up with the published events.
+    std::vector<SubscriberPtr> _replaying;
+
     bool _destroyed; // Has this Topic been destroyed?
 
+    EventLogPtr _eventLog; // The event log, if enabled.
+
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
 };
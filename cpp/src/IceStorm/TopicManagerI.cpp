@@ -8,6 +8,8 @@
 #include <IceStorm/Instance.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Observers.h>
+#include <IceStorm/UpdateLog.h>
+#include <IceStorm/Shards.h>
 #include <IceStorm/Subscriber.h>
 #include <IceStorm/Util.h>
 #include <Ice/SliceChecksums.h>
@@ -38,8 +40,14 @@ public:
     {
     }
 
-    virtual TopicPrx create(const string& id, const Ice::Current&)
+    virtual TopicPrx create(const string& id, const Ice::Current& current)
     {
+        TopicManagerPrx shard = _instance->shards()->owner(id, current);
+        if(shard)
+        {
+            return shard->create(id);
+        }
+
         while(true)
         {
             Ice::Long generation;
@@ -69,18 +77,29 @@ public:
         }
     }
 
-    virtual TopicPrx retrieve(const string& id, const Ice::Current&) const
+    virtual TopicPrx retrieve(const string& id, const Ice::Current& current) const
     {
+        TopicManagerPrx shard = _instance->shards()->owner(id, current);
+        if(shard)
+        {
+            return shard->retrieve(id);
+        }
+
         // Use cached reads.
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
         return _impl->retrieve(id);
     }
 
-    virtual TopicDict retrieveAll(const Ice::Current&) const
+    virtual TopicDict retrieveAll(const Ice::Current& current) const
     {
-        // Use cached reads.
-        CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
-        return _impl->retrieveAll();
+        TopicDict all;
+        {
+            // Use cached reads.
+            CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
+            all = _impl->retrieveAll();
+        }
+        _instance->shards()->retrieveAll(all, current);
+        return all;
     }
 
     virtual Ice::SliceChecksumDict getSliceChecksums(const Ice::Current&) const
@@ -134,6 +153,17 @@ public:
         _impl->observerInit(llu, content);
     }
 
+    virtual void initUpdates(const LogUpdate& llu, const LogUpdate& from, const UpdateSeq& updates,
+                             const Ice::Current&)
+    {
+        NodeIPtr node = _instance->node();
+        if(node)
+        {
+            node->checkObserverInit(llu.generation);
+        }
+        _impl->observerInitUpdates(llu, from, updates);
+    }
+
     virtual void createTopic(const LogUpdate& llu, const string& name, const Ice::Current&)
     {
         try
@@ -220,6 +250,11 @@ public:
         _impl->getContent(llu, content);
     }
 
+    virtual bool getUpdates(const LogUpdate& from, LogUpdate& llu, UpdateSeq& updates, const Ice::Current&)
+    {
+        return _impl->getUpdates(from, llu, updates);
+    }
+
 private:
 
     const TopicManagerImplPtr _impl;
@@ -260,8 +295,12 @@ TopicManagerImpl::TopicManagerImpl(const PersistentInstancePtr& instance) :
             IceDB::ReadWriteTxn txn(_instance->dbEnv());
 
             // Ensure that the llu counter is present in the log.
-            LogUpdate empty = {0, 0};
-            _instance->lluMap().put(txn, lluDbKey, empty);
+            LogUpdate llu = {0, 0};
+            if(!_lluMap.get(txn, lluDbKey, llu))
+            {
+                _lluMap.put(txn, lluDbKey, llu);
+            }
+            _instance->updateLog()->reset(llu);
 
             // Recreate each of the topics.
             SubscriberRecordKey k;
@@ -491,6 +530,67 @@ TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& cont
             r->second->update(q->records);
         }
     }
+    _instance->updateLog()->reset(llu);
+
+    // Clear the set of observers.
+    _instance->observers()->clear();
+}
+
+void
+TopicManagerImpl::observerInitUpdates(const LogUpdate& llu, const LogUpdate& from, const UpdateSeq& updates)
+{
+    Lock sync(*this);
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topicMgr > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicMgrCat);
+        out << "init with " << updates.size() << " updates since llu " << from.generation << "/" << from.iteration;
+    }
+
+    // The updates must follow our last log update, see UpdateLog for
+    // the log updates with an iteration of 0.
+    LogUpdate last = getLastLogUpdate();
+    if(from != last || (from.iteration == 0 && !_instance->updateLog()->contains(from)))
+    {
+        ostringstream os;
+        os << "cannot apply the updates since llu " << from.generation << "/" << from.iteration << " to llu "
+           << last.generation << "/" << last.iteration;
+        throw ObserverInconsistencyException(os.str());
+    }
+
+    for(UpdateSeq::const_iterator p = updates.begin(); p != updates.end(); ++p)
+    {
+        switch(p->type)
+        {
+        case UpdateTypeCreateTopic:
+            observerCreateTopic(p->llu, p->topic);
+            break;
+        case UpdateTypeDestroyTopic:
+            observerDestroyTopic(p->llu, p->topic);
+            break;
+        case UpdateTypeAddSubscriber:
+            observerAddSubscriber(p->llu, p->topic, p->record);
+            break;
+        case UpdateTypeRemoveSubscriber:
+            observerRemoveSubscriber(p->llu, p->topic, p->subscribers);
+            break;
+        }
+    }
+
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+        _lluMap.put(txn, lluDbKey, llu);
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+    _instance->updateLog()->setLastLogUpdate(llu);
+
     // Clear the set of observers.
     _instance->observers()->clear();
 }
@@ -528,6 +628,12 @@ TopicManagerImpl::observerCreateTopic(const LogUpdate& llu, const string& name)
     }
 
     installTopic(name, id, true);
+
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeCreateTopic;
+    update.topic = name;
+    _instance->updateLog()->add(update);
 }
 
 void
@@ -543,6 +649,12 @@ TopicManagerImpl::observerDestroyTopic(const LogUpdate& llu, const string& name)
     q->second->observerDestroyTopic(llu);
 
     _topics.erase(q);
+
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeDestroyTopic;
+    update.topic = name;
+    _instance->updateLog()->add(update);
 }
 
 void
@@ -561,6 +673,13 @@ TopicManagerImpl::observerAddSubscriber(const LogUpdate& llu, const string& name
         topic = q->second;
     }
     topic->observerAddSubscriber(llu, record);
+
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeAddSubscriber;
+    update.topic = name;
+    update.record = record;
+    _instance->updateLog()->add(update);
 }
 
 void
@@ -579,6 +698,13 @@ TopicManagerImpl::observerRemoveSubscriber(const LogUpdate& llu, const string& n
         topic = q->second;
     }
     topic->observerRemoveSubscriber(llu, id);
+
+    Update update;
+    update.llu = llu;
+    update.type = UpdateTypeRemoveSubscriber;
+    update.topic = name;
+    update.subscribers = id;
+    _instance->updateLog()->add(update);
 }
 
 void
@@ -608,6 +734,14 @@ TopicManagerImpl::getContent(LogUpdate& llu, TopicContentSeq& content)
     }
 }
 
+bool
+TopicManagerImpl::getUpdates(const LogUpdate& from, LogUpdate& llu, UpdateSeq& updates)
+{
+    Lock sync(*this);
+    llu = getLastLogUpdate();
+    return _instance->updateLog()->get(from, updates);
+}
+
 LogUpdate
 TopicManagerImpl::getLastLogUpdate() const
 {
@@ -631,6 +765,32 @@ TopicManagerImpl::sync(const Ice::ObjectPrx& master)
 {
     TopicManagerSyncPrx sync = TopicManagerSyncPrx::uncheckedCast(master);
 
+    // First try to only retrieve the updates that follow our last log
+    // update.
+    LogUpdate from = getLastLogUpdate();
+    if(from.iteration > 0 || _instance->updateLog()->contains(from))
+    {
+        LogUpdate llu;
+        UpdateSeq updates;
+        if(sync->getUpdates(from, llu, updates))
+        {
+            try
+            {
+                observerInitUpdates(llu, from, updates);
+                return;
+            }
+            catch(const ObserverInconsistencyException& ex)
+            {
+                TraceLevelsPtr traceLevels = _instance->traceLevels();
+                if(traceLevels->topicMgr > 0)
+                {
+                    Ice::Trace out(traceLevels->logger, traceLevels->topicMgrCat);
+                    out << "sync with updates failed: " << ex.reason;
+                }
+            }
+        }
+    }
+
     LogUpdate llu;
     TopicContentSeq content;
     sync->getContent(llu, content);
@@ -645,8 +805,6 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
 
     reap();
 
-    TopicContentSeq content;
-
     // Update the database llu. This prevents the following case:
     //
     // Three replicas 1, 2, 3. 3 is the master. It accepts a change
@@ -660,16 +818,8 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
     //
     try
     {
-        content.clear();
-
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
 
-        for(map<string, TopicImplPtr>::const_iterator p = _topics.begin(); p != _topics.end(); ++p)
-        {
-            TopicContent rec = p->second->getContent();
-            content.push_back(rec);
-        }
-
         _lluMap.put(txn, lluDbKey, llu);
 
         txn.commit();
@@ -679,9 +829,12 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
         logError(_instance->communicator(), ex);
         throw; // will become UnknownException in caller
     }
+    _instance->updateLog()->setLastLogUpdate(llu);
 
-    // Now initialize the observers.
-    _instance->observers()->init(slaves, llu, content);
+    // Now initialize the observers. Once they are all initialized,
+    // this generation can't be started by another master.
+    _instance->observers()->init(slaves, llu, this);
+    _instance->updateLog()->confirm(llu.generation);
 }
 
 Ice::ObjectPrx
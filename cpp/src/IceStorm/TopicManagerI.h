@@ -44,6 +44,8 @@ public:
 
     // Observer methods.
     void observerInit(const IceStormElection::LogUpdate&, const IceStormElection::TopicContentSeq&);
+    void observerInitUpdates(const IceStormElection::LogUpdate&, const IceStormElection::LogUpdate&,
+                             const IceStormElection::UpdateSeq&);
     void observerCreateTopic(const IceStormElection::LogUpdate&, const std::string&);
     void observerDestroyTopic(const IceStormElection::LogUpdate&, const std::string&);
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const std::string&,
@@ -51,9 +53,10 @@ public:
     void observerRemoveSubscriber(const IceStormElection::LogUpdate&, const std::string&, const Ice::IdentitySeq&);
 
     // Sync methods.
-    void getContent(IceStormElection::LogUpdate&, IceStormElection::TopicContentSeq&);
+    bool getUpdates(const IceStormElection::LogUpdate&, IceStormElection::LogUpdate&, IceStormElection::UpdateSeq&);
 
     // Replica methods.
+    virtual void getContent(IceStormElection::LogUpdate&, IceStormElection::TopicContentSeq&);
     virtual IceStormElection::LogUpdate getLastLogUpdate() const;
     virtual void sync(const Ice::ObjectPrx&);
     virtual void initMaster(const std::set<IceStormElection::GroupNodeInfo>&, const IceStormElection::LogUpdate&);
@@ -37,22 +37,8 @@ public:
                Ice::ByteSeq&,
                const Ice::Current& current)
     {
-        // Use cached reads.
-        EventDataPtr event = new EventData(
-            current.operation,
-            current.mode,
-            Ice::ByteSeq(),
-            current.ctx);
-
-        //
-        // COMPILERBUG: gcc 4.0.1 doesn't like this.
-        //
-        //event->data.swap(Ice::ByteSeq(inParams.first, inParams.second));
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event->data.swap(data);
-
         EventDataSeq v;
-        v.push_back(event);
+        v.push_back(IceStormInternal::createEvent(inParams, current));
         _impl->publish(false, v);
 
         return true;
@@ -543,13 +529,10 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
     // must be reaped.
     //
     vector<Ice::Identity> e;
-    for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
-    {
-        if(!(*p)->queue(forwarded, events) && (*p)->reap())
-        {
-            e.push_back((*p)->id());
-        }
-    }
+    _instance->fanOutPool()->queue(forwarded, events, copy, e);
+
+    // Send the events queued to the subscriber groups.
+    _instance->subscriberGroups()->flush();
 
     //
     // Run through the error list removing those subscribers that are
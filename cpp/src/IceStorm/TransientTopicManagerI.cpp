@@ -7,6 +7,7 @@
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/Subscriber.h>
+#include <IceStorm/Shards.h>
 
 #include <Ice/Ice.h>
 
@@ -27,8 +28,14 @@ TransientTopicManagerImpl::~TransientTopicManagerImpl()
 }
 
 TopicPrx
-TransientTopicManagerImpl::create(const string& name, const Ice::Current&)
+TransientTopicManagerImpl::create(const string& name, const Ice::Current& current)
 {
+    TopicManagerPrx shard = _instance->shards()->owner(name, current);
+    if(shard)
+    {
+        return shard->create(name);
+    }
+
     Lock sync(*this);
 
     reap();
@@ -65,8 +72,14 @@ TransientTopicManagerImpl::create(const string& name, const Ice::Current&)
 }
 
 TopicPrx
-TransientTopicManagerImpl::retrieve(const string& name, const Ice::Current&) const
+TransientTopicManagerImpl::retrieve(const string& name, const Ice::Current& current) const
 {
+    TopicManagerPrx shard = _instance->shards()->owner(name, current);
+    if(shard)
+    {
+        return shard->retrieve(name);
+    }
+
     Lock sync(*this);
 
     TransientTopicManagerImpl* This = const_cast<TransientTopicManagerImpl*>(this);
@@ -85,25 +98,27 @@ TransientTopicManagerImpl::retrieve(const string& name, const Ice::Current&) con
 }
 
 TopicDict
-TransientTopicManagerImpl::retrieveAll(const Ice::Current&) const
+TransientTopicManagerImpl::retrieveAll(const Ice::Current& current) const
 {
-    Lock sync(*this);
-
-    TransientTopicManagerImpl* This = const_cast<TransientTopicManagerImpl*>(this);
-    This->reap();
-
     TopicDict all;
-    for(map<string, TransientTopicImplPtr>::const_iterator p = _topics.begin(); p != _topics.end(); ++p)
     {
-        //
-        // Here we cannot just reconstruct the identity since the
-        // identity could be either "<instanceName>/topic.<topicname>"
-        // name, or if created with pre-3.2 IceStorm "/<topicname>".
-        //
-        all.insert(TopicDict::value_type(
-                       p->first, TopicPrx::uncheckedCast(_instance->topicAdapter()->createProxy(p->second->id()))));
-    }
+        Lock sync(*this);
 
+        TransientTopicManagerImpl* This = const_cast<TransientTopicManagerImpl*>(this);
+        This->reap();
+
+        for(map<string, TransientTopicImplPtr>::const_iterator p = _topics.begin(); p != _topics.end(); ++p)
+        {
+            //
+            // Here we cannot just reconstruct the identity since the
+            // identity could be either "<instanceName>/topic.<topicname>"
+            // name, or if created with pre-3.2 IceStorm "/<topicname>".
+            //
+            all.insert(TopicDict::value_type(
+                           p->first, TopicPrx::uncheckedCast(_instance->topicAdapter()->createProxy(p->second->id()))));
+        }
+    }
+    _instance->shards()->retrieveAll(all, current);
     return all;
 }
 Ice::SliceChecksumDict
@@ -0,0 +1,113 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/UpdateLog.h>
+
+using namespace std;
+using namespace IceStormElection;
+
+UpdateLog::UpdateLog(size_t max) :
+    _max(max)
+{
+    _base.generation = 0;
+    _base.iteration = 0;
+    _last = _base;
+}
+
+void
+UpdateLog::reset(const LogUpdate& llu)
+{
+    Lock sync(*this);
+    _base = llu;
+    _last = llu;
+    _updates.clear();
+    _generations.clear();
+}
+
+void
+UpdateLog::add(const Update& update)
+{
+    if(_max == 0)
+    {
+        return;
+    }
+
+    Lock sync(*this);
+
+    //
+    // The updates are not necessarily added in order since the master
+    // replicates concurrent updates concurrently.
+    //
+    if(update.llu <= _base)
+    {
+        return;
+    }
+    _updates[update.llu] = update;
+    if(_last < update.llu)
+    {
+        _last = update.llu;
+    }
+
+    while(_updates.size() > _max)
+    {
+        _base = _updates.begin()->first;
+        _updates.erase(_updates.begin());
+    }
+    _generations.erase(_generations.begin(), _generations.lower_bound(_base.generation));
+}
+
+void
+UpdateLog::setLastLogUpdate(const LogUpdate& llu)
+{
+    Lock sync(*this);
+    _last = llu;
+}
+
+void
+UpdateLog::confirm(Ice::Long generation)
+{
+    Lock sync(*this);
+    if(_last.generation == generation && _last.iteration == 0)
+    {
+        _generations.insert(generation);
+    }
+}
+
+bool
+UpdateLog::contains(const LogUpdate& llu) const
+{
+    Lock sync(*this);
+    return containsNoSync(llu);
+}
+
+bool
+UpdateLog::get(const LogUpdate& from, UpdateSeq& updates) const
+{
+    Lock sync(*this);
+    if(!containsNoSync(from))
+    {
+        return false;
+    }
+
+    updates.clear();
+    for(map<LogUpdate, Update>::const_iterator p = _updates.upper_bound(from); p != _updates.end(); ++p)
+    {
+        updates.push_back(p->second);
+    }
+    return true;
+}
+
+bool
+UpdateLog::containsNoSync(const LogUpdate& llu) const
+{
+    if(_max == 0 || llu < _base || _last < llu)
+    {
+        return false;
+    }
+    if(llu.iteration == 0)
+    {
+        return _generations.find(llu.generation) != _generations.end();
+    }
+    return llu == _base || _updates.find(llu) != _updates.end();
+}
@@ -0,0 +1,72 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef UPDATE_LOG_H
+#define UPDATE_LOG_H
+
+#include <IceStorm/Election.h>
+#include <IceUtil/Mutex.h>
+#include <map>
+#include <set>
+
+namespace IceStormElection
+{
+
+//
+// The log of the last updates applied to the database of a replica,
+// ordered by their log update. A replica whose last log update is in
+// the log of the master is initialized with the updates that follow
+// it rather than with the whole topic content.
+//
+// A log update with an iteration of 0 labels the database state of a
+// new master at the start of its generation. If the master fails to
+// initialize all its slaves, another master might start the same
+// generation from a different state. Such a log update is therefore
+// only used once the master of the generation initialized all its
+// slaves.
+//
+class UpdateLog : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    // The log keeps at most the given number of updates, 0 disables
+    // the log.
+    UpdateLog(size_t);
+
+    // The database state was replaced, the log restarts at the given
+    // log update.
+    void reset(const LogUpdate&);
+
+    // Add an update applied to the database.
+    void add(const Update&);
+
+    // The database state is now labelled with the given log update.
+    void setLastLogUpdate(const LogUpdate&);
+
+    // The master of the given generation initialized all its slaves.
+    void confirm(Ice::Long);
+
+    // Check whether the updates that follow the given log update are
+    // in the log.
+    bool contains(const LogUpdate&) const;
+
+    // Get the updates that follow the given log update, returns false
+    // if they are not in the log.
+    bool get(const LogUpdate&, UpdateSeq&) const;
+
+private:
+
+    bool containsNoSync(const LogUpdate&) const;
+
+    const size_t _max;
+    LogUpdate _base; // The first log update of the log.
+    LogUpdate _last; // The last log update of the log.
+    std::map<LogUpdate, Update> _updates;
+    std::set<Ice::Long> _generations; // The confirmed generations.
+};
+typedef IceUtil::Handle<UpdateLog> UpdateLogPtr;
+
+}
+
+#endif // UPDATE_LOG_H
@@ -65,6 +65,20 @@ IceStormInternal::describeEndpoints(const Ice::ObjectPrx& proxy)
     return os.str();
 }
 
+EventDataPtr
+IceStormInternal::createEvent(const pair<const Ice::Byte*, const Ice::Byte*>& inParams, const Ice::Current& current)
+{
+    EventDataPtr event = new EventData;
+    event->op = current.operation;
+    event->mode = current.mode;
+    event->data.assign(inParams.first, inParams.second);
+    if(!current.ctx.empty())
+    {
+        event->context = current.ctx;
+    }
+    return event;
+}
+
 int
 IceStormInternal::compareSubscriberRecordKey(const MDB_val* v1, const MDB_val* v2)
 {
@@ -7,6 +7,7 @@
 
 #include <Ice/Ice.h>
 #include <IceDB/IceDB.h>
+#include <IceStorm/IceStormInternal.h>
 #include <IceStorm/LLURecord.h>
 #include <IceStorm/SubscriberRecord.h>
 
@@ -39,6 +40,14 @@ nameToIdentity(const IceStorm::InstancePtr&, const std::string&);
 std::string
 describeEndpoints(const Ice::ObjectPrx&);
 
+//
+// Create the event for a request received by a publisher object. The
+// encoded parameters are copied once, the event is shared by all the
+// subscribers.
+//
+IceStorm::EventDataPtr
+createEvent(const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&);
+
 int
 compareSubscriberRecordKey(const MDB_val* v1, const MDB_val* v2);
 
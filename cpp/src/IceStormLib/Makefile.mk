@@ -6,6 +6,7 @@ $(project)_libraries    := IceStorm
 
 IceStorm_targetdir      := $(libdir)
 IceStorm_dependencies   := Ice
+IceStorm_cppflags       := -DICESTORM_API_EXPORTS
 IceStorm_sliceflags     := --include-dir IceStorm
 
 projects += $(project)
@@ -0,0 +1,62 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceStorm/SubscriberDemultiplexer.h>
+#include <Ice/ObjectAdapter.h>
+#include <Ice/LocalException.h>
+
+using namespace std;
+using namespace IceStorm;
+
+SubscriberDemultiplexer::SubscriberDemultiplexer(const Ice::ObjectAdapterPtr& adapter) :
+    _adapter(adapter)
+{
+}
+
+void
+#ifdef ICE_CPP11_MAPPING
+SubscriberDemultiplexer::deliver(Ice::IdentitySeq subscribers, DemultiplexedEventSeq events, const Ice::Current&)
+#else
+SubscriberDemultiplexer::deliver(const Ice::IdentitySeq& subscribers, const DemultiplexedEventSeq& events,
+                                 const Ice::Current&)
+#endif
+{
+    vector<Ice::ObjectPrxPtr> proxies;
+    proxies.reserve(subscribers.size());
+    for(Ice::IdentitySeq::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        //
+        // The demultiplexer of a multicast group receives the events of
+        // the subscribers of all the processes that joined the group,
+        // the subscribers of other processes are skipped.
+        //
+        if(_adapter->find(*p) || _adapter->findDefaultServant(p->category) || _adapter->findDefaultServant("") ||
+           _adapter->findServantLocator(p->category) || _adapter->findServantLocator(""))
+        {
+            proxies.push_back(_adapter->createProxy(*p)->ice_oneway());
+        }
+    }
+
+    //
+    // The events are dispatched to the subscribers with collocated
+    // oneway invocations, this doesn't wait for the subscribers to
+    // process the events. Like with oneway subscribers, a subscriber
+    // failing to process an event doesn't prevent the delivery to the
+    // other subscribers.
+    //
+    vector<Ice::Byte> outParams;
+    for(DemultiplexedEventSeq::const_iterator e = events.begin(); e != events.end(); ++e)
+    {
+        for(vector<Ice::ObjectPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            try
+            {
+                (*p)->ice_invoke(e->op, e->mode, e->data, outParams, e->context);
+            }
+            catch(const Ice::LocalException&)
+            {
+            }
+        }
+    }
+}
@@ -290,6 +290,260 @@ throwUserExceptionLambda(IceUtilInternal::Output& C, ExceptionList throws, const
     }
 }
 
+//
+// Computes a minimal perfect hash of the operation names with the hash
+// and displace algorithm: the names are hashed into buckets and, from
+// the largest bucket to the smallest, each bucket gets the first
+// displacement that hashes its names to free slots. The seed of the
+// base hash is only changed if two names have the same base hash.
+//
+void
+writeOperationTable(Output& C, const string& flatName, const string& namesName, const StringList& names)
+{
+    const unsigned int size = static_cast<unsigned int>(names.size());
+    const unsigned int buckets = (size + 1) / 2;
+
+    unsigned int seed = 0;
+    vector<int> displacements;
+    vector<int> slots;
+    while(true)
+    {
+        vector<unsigned int> hashes;
+        for(StringList::const_iterator p = names.begin(); p != names.end(); ++p)
+        {
+            hashes.push_back(operationHash(*p, seed));
+        }
+
+        vector<vector<int> > bucketNames(buckets);
+        for(unsigned int i = 0; i < size; ++i)
+        {
+            bucketNames[operationHashMix(hashes[i], 0) % buckets].push_back(static_cast<int>(i));
+        }
+
+        vector<pair<size_t, unsigned int> > order;
+        for(unsigned int i = 0; i < buckets; ++i)
+        {
+            order.push_back(make_pair(bucketNames[i].size(), i));
+        }
+        sort(order.begin(), order.end(), greater<pair<size_t, unsigned int> >());
+
+        displacements.assign(buckets, 0);
+        slots.assign(size, -1);
+        bool found = true;
+        for(vector<pair<size_t, unsigned int> >::const_iterator p = order.begin(); p != order.end() && found; ++p)
+        {
+            const vector<int>& bucket = bucketNames[p->second];
+            if(bucket.empty())
+            {
+                break;
+            }
+
+            found = false;
+            for(unsigned int d = 1; d < 100000 && !found; ++d)
+            {
+                vector<unsigned int> bucketSlots;
+                for(vector<int>::const_iterator q = bucket.begin(); q != bucket.end(); ++q)
+                {
+                    unsigned int slot = operationHashMix(hashes[static_cast<size_t>(*q)], d) % size;
+                    if(slots[slot] != -1 || find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end())
+                    {
+                        break;
+                    }
+                    bucketSlots.push_back(slot);
+                }
+
+                if(bucketSlots.size() == bucket.size())
+                {
+                    for(size_t i = 0; i < bucket.size(); ++i)
+                    {
+                        slots[bucketSlots[i]] = bucket[i];
+                    }
+                    displacements[p->second] = static_cast<int>(d);
+                    found = true;
+                }
+            }
+        }
+
+        if(found)
+        {
+            break;
+        }
+        ++seed;
+    }
+
+    C << nl << "const int " << flatName << "_displacements[] =";
+    C << sb;
+    for(vector<int>::const_iterator p = displacements.begin(); p != displacements.end();)
+    {
+        C << nl << *p;
+        if(++p != displacements.end())
+        {
+            C << ',';
+        }
+    }
+    C << eb << ';';
+    C << sp << nl << "const int " << flatName << "_slots[] =";
+    C << sb;
+    for(vector<int>::const_iterator p = slots.begin(); p != slots.end();)
+    {
+        C << nl << *p;
+        if(++p != slots.end())
+        {
+            C << ',';
+        }
+    }
+    C << eb << ';';
+    C << sp << nl << "const ::IceInternal::OperationTable " << flatName << "_table =";
+    C << sb;
+    C << nl << namesName << ", " << size << ", " << seed << "U, " << flatName << "_displacements, " << buckets
+      << ", " << flatName << "_slots";
+    C << eb << ';';
+}
+
+//
+// Returns true if the proxy operation calls a collocated servant
+// directly, without marshaling the parameters. Operations with class
+// parameters or with parameter mapping metadata are always marshaled.
+//
+bool
+isCollocatedDirect(const OperationPtr& p)
+{
+    ClassDefPtr cl = ClassDefPtr::dynamicCast(p->container());
+    if(cl->isLocal() || (!cl->hasMetaData("cpp:collocated-direct") && !p->hasMetaData("cpp:collocated-direct")))
+    {
+        return false;
+    }
+
+    if(cl->hasMetaData("amd") || p->hasMetaData("amd") || p->hasMarshaledResult() ||
+       p->sendsClasses(true) || p->returnsClasses(true))
+    {
+        return false;
+    }
+
+    StringList metaData = p->getMetaData();
+    for(StringList::const_iterator q = metaData.begin(); q != metaData.end(); ++q)
+    {
+        if(*q != "cpp:collocated-direct" && *q != "cpp:const" &&
+           (q->find("cpp:") == 0 || q->find("cpp98:") == 0 || q->find("cpp11:") == 0))
+        {
+            return false;
+        }
+    }
+
+    ParamDeclList paramList = p->parameters();
+    for(ParamDeclList::const_iterator q = paramList.begin(); q != paramList.end(); ++q)
+    {
+        if(!(*q)->getMetaData().empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+writeCollocatedDirect(Output& out, const OperationPtr& p, const string& opName, const string& mode,
+                      const string& contextParam, const string& servant, const string& scope, int typeCtx)
+{
+    ExceptionList throws = p->throws();
+    throws.sort();
+    throws.unique();
+    throws.sort(Slice::DerivedToBaseCompare());
+
+    ParamDeclList inParams = p->inParameters();
+    ParamDeclList outParams = p->outParameters();
+    TypePtr ret = p->returnType();
+
+    out << sb;
+    out << nl << "::IceInternal::Direct iceDirect(this, " << opName << ", " << mode << ", " << contextParam << ");";
+    out << nl << servant << "* iceServant = iceDirect.servant< " << servant << ">();";
+    out << nl << "if(iceServant)";
+    out << sb;
+
+    //
+    // Check the MessageSizeMax limit with a lower bound of the size of
+    // the in parameters, optional parameters are not included.
+    //
+    string size;
+    for(ParamDeclList::const_iterator q = inParams.begin(); q != inParams.end(); ++q)
+    {
+        if(!(*q)->optional())
+        {
+            size += (size.empty() ? "" : " + ") + string("::IceInternal::directSize(") + fixKwd((*q)->name()) + ")";
+        }
+    }
+    out << nl << "iceDirect.checkMessageSize(" << (size.empty() ? "0" : size) << ");";
+
+    //
+    // The servant gets its own default initialized out parameters, the
+    // out parameters of the caller are only assigned once the servant
+    // returns. This way an in parameter bound to the same variable as
+    // an out parameter isn't modified by the servant and the out
+    // parameters are not modified if the servant throws.
+    //
+    for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+    {
+        string typeS = typeToString((*q)->type(), (*q)->optional(), scope, (*q)->getMetaData(), typeCtx);
+        out << nl << typeS << " iceP_" << (*q)->name() << " = " << typeS << "();";
+    }
+
+    out << nl << "try";
+    out << sb;
+    out << nl;
+    if(ret)
+    {
+        if(outParams.empty())
+        {
+            out << "return ";
+        }
+        else
+        {
+            out << typeToString(ret, p->returnIsOptional(), scope, p->getMetaData(), typeCtx) << " iceRet = ";
+        }
+    }
+    out << "iceServant->" << fixKwd(p->name()) << spar;
+    ParamDeclList paramList = p->parameters();
+    for(ParamDeclList::const_iterator q = paramList.begin(); q != paramList.end(); ++q)
+    {
+        out << ((*q)->isOutParam() ? "iceP_" + (*q)->name() : fixKwd((*q)->name()));
+    }
+    out << "iceDirect.current()" << epar << ';';
+    for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+    {
+        out << nl << fixKwd((*q)->name()) << " = ";
+        if(typeCtx & TypeContextCpp11)
+        {
+            out << "::std::move(iceP_" << (*q)->name() << ");";
+        }
+        else
+        {
+            out << "iceP_" << (*q)->name() << ';';
+        }
+    }
+    if(ret && !outParams.empty())
+    {
+        out << nl << "return iceRet;";
+    }
+    else if(!ret)
+    {
+        out << nl << "return;";
+    }
+    out << eb;
+    for(ExceptionList::const_iterator q = throws.begin(); q != throws.end(); ++q)
+    {
+        out << nl << "catch(const " << getUnqualified(fixKwd((*q)->scoped()), scope) << "&)";
+        out << sb;
+        out << nl << "throw;";
+        out << eb;
+    }
+    out << nl << "catch(...)";
+    out << sb;
+    out << nl << "iceDirect.handleException();";
+    out << eb;
+    out << eb;
+    out << eb;
+}
+
 string
 resultStructName(const string& name, const string& scope = "", bool marshaledResult = false)
 {
@@ -901,6 +1155,10 @@ Slice::Gen::generate(const UnitPtr& p)
         {
             H << "\n#include <Ice/IncomingAsync.h>";
         }
+        if(p->hasContentsWithMetaData("cpp:collocated-direct"))
+        {
+            H << "\n#include <Ice/Direct.h>";
+        }
         C << "\n#include <Ice/LocalException.h>";
         C << "\n#include <Ice/ValueFactory.h>";
         C << "\n#include <Ice/OutgoingAsync.h>";
@@ -2439,16 +2697,43 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
         postParams.push_back(contextDoc);
         writeOpDocSummary(H, p, comment, OpDocAllParams, true, StringList(), postParams, comment->returns());
     }
-    H << nl << deprecateSymbol << _dllMemberExport << retS << ' ' << fixKwd(name) << spar << paramsDecl
-      << contextDecl << epar;
-    H << sb << nl;
-    if(ret)
+    if(isCollocatedDirect(p))
     {
-        H << "return ";
+        //
+        // The servant class is not yet defined, the synchronous
+        // invocation with the direct collocated call is implemented
+        // in the source file.
+        //
+        H << nl << deprecateSymbol << _dllMemberExport << retS << ' ' << fixKwd(name) << spar << paramsDecl
+          << contextDecl << epar << ';';
+
+        C << sp << nl << retS << nl << "IceProxy" << scoped << spar << paramsDecl
+          << "const ::Ice::Context& " + contextParam << epar;
+        C << sb;
+        writeCollocatedDirect(C, p, flatName, operationModeToString(p->sendMode()), contextParam,
+                              fixKwd(cl->scoped()), "", _useWstring);
+        C << nl;
+        if(ret)
+        {
+            C << "return ";
+        }
+        C << "end_" << name << spar << outParamNamesAMI << "_iceI_begin_" + name << spar << argsAMI;
+        C << contextParam << "::IceInternal::dummyCallback" << "0" << "true" << epar << epar << ';';
+        C << eb;
+    }
+    else
+    {
+        H << nl << deprecateSymbol << _dllMemberExport << retS << ' ' << fixKwd(name) << spar << paramsDecl
+          << contextDecl << epar;
+        H << sb << nl;
+        if(ret)
+        {
+            H << "return ";
+        }
+        H << "end_" << name << spar << outParamNamesAMI << "_iceI_begin_" + name << spar << argsAMI;
+        H << contextParam << "::IceInternal::dummyCallback" << "0" << "true" << epar << epar << ';';
+        H << eb;
     }
-    H << "end_" << name << spar << outParamNamesAMI << "_iceI_begin_" + name << spar << argsAMI;
-    H << contextParam << "::IceInternal::dummyCallback" << "0" << "true" << epar << epar << ';';
-    H << eb;
 
     H << sp;
     if(comment)
@@ -3200,6 +3485,9 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
                 }
             }
             C << eb << ';';
+            string tableName = "iceC" + p->flattenedScope() + p->name();
+            C << sp;
+            writeOperationTable(C, tableName, flatName, allOpNames);
             C << sp << nl << "}";
             C << sp;
             C << nl << "/// \\cond INTERNAL";
@@ -3208,16 +3496,14 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
               << getUnqualified("::Ice::Current&", scope) << " current)";
             C << sb;
 
-            C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-              << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-              << ", current.operation);";
-            C << nl << "if(r.first == r.second)";
+            C << nl << "int pos = ::IceInternal::findOperation(" << tableName << "_table, current.operation);";
+            C << nl << "if(pos < 0)";
             C << sb;
             C << nl << "throw " << getUnqualified("::Ice::OperationNotExistException", scope)
               << "(__FILE__, __LINE__, current.id, " << "current.facet, current.operation);";
             C << eb;
             C << sp;
-            C << nl << "switch(r.first - " << flatName << ')';
+            C << nl << "switch(pos)";
             C << sb;
             int i = 0;
             for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
@@ -3292,15 +3578,13 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
                   << "::ice_operationAttributes(const ::std::string& opName) const";
                 C << sb;
 
-                C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-                  << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-                  << ", opName);";
-                C << nl << "if(r.first == r.second)";
+                C << nl << "int pos = ::IceInternal::findOperation(" << tableName << "_table, opName);";
+                C << nl << "if(pos < 0)";
                 C << sb;
                 C << nl << "return -1;";
                 C << eb;
 
-                C << nl << "return " << opAttrFlatName << "[r.first - " << flatName << "];";
+                C << nl << "return " << opAttrFlatName << "[pos];";
                 C << eb;
             }
         }
@@ -5630,7 +5914,7 @@ Slice::Gen::MetaDataVisitor::validate(const SyntaxTreeBasePtr& cont, const Strin
             cpp11 = true;
         }
 
-        if(operation && (s == "cpp:const" || s == "cpp:noexcept"))
+        if(operation && (s == "cpp:const" || s == "cpp:noexcept" || s == "cpp:collocated-direct"))
         {
             continue;
         }
@@ -5676,6 +5960,7 @@ Slice::Gen::MetaDataVisitor::validate(const SyntaxTreeBasePtr& cont, const Strin
             {
                 ClassDefPtr cl = ClassDefPtr::dynamicCast(cont);
                 if(cl && ((!cpp11 && ss == "virtual") ||
+                          (!cl->isLocal() && s == "cpp:collocated-direct") ||
                           (cl->isLocal() && ss.find("type:") == 0) ||
                           (!cpp11 && cl->isLocal() && ss == "comparable")))
                 {
@@ -6155,6 +6440,13 @@ Slice::Gen::Cpp11DeclVisitor::visitClassDefStart(const ClassDefPtr& p)
             }
         }
         C << eb << ';';
+
+        if(!allOps.empty())
+        {
+            C << sp;
+            writeOperationTable(C, "iceC" + p->flattenedScope() + p->name(),
+                                "iceC" + p->flattenedScope() + p->name() + "_ops", allOpNames);
+        }
     }
 
     return true;
@@ -6955,6 +7247,13 @@ Slice::Gen::Cpp11ProxyVisitor::visitOperation(const OperationPtr& p)
     }
     H << nl << deprecateSymbol << retS << ' ' << fixKwd(name) << spar << paramsDecl << contextDecl << epar;
     H << sb;
+    if(isCollocatedDirect(p))
+    {
+        writeCollocatedDirect(H, p, "\"" + name + "\"",
+                              getUnqualified(operationModeToString(p->sendMode(), true), clScope), contextParam,
+                              getUnqualified(fixKwd(cl->scoped() + (cl->isInterface() ? "" : "Disp")), clScope),
+                              clScope, _useWstring | TypeContextCpp11);
+    }
     H << nl;
     if(futureOutParams.size() == 1)
     {
@@ -8036,7 +8335,7 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
         allOpNames.sort();
         allOpNames.unique();
 
-        string flatName = "iceC" + p->flattenedScope() + p->name() + "_ops";
+        string flatName = "iceC" + p->flattenedScope() + p->name();
 
         H << sp;
         H << nl << "/// \\cond INTERNAL";
@@ -8051,16 +8350,14 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
           << getUnqualified("::Ice::Current&", scope) << " current)";
         C << sb;
 
-        C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-          << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-          << ", current.operation);";
-        C << nl << "if(r.first == r.second)";
+        C << nl << "int pos = ::IceInternal::findOperation(" << flatName << "_table, current.operation);";
+        C << nl << "if(pos < 0)";
         C << sb;
         C << nl << "throw " << getUnqualified("::Ice::OperationNotExistException", scope)
           << "(__FILE__, __LINE__, current.id, current.facet, current.operation);";
         C << eb;
         C << sp;
-        C << nl << "switch(r.first - " << flatName << ')';
+        C << nl << "switch(pos)";
         C << sb;
         int i = 0;
         for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
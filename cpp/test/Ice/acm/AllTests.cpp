@@ -113,6 +113,17 @@ private:
 };
 ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
 
+class BusyTimerTask : public IceUtil::TimerTask
+{
+public:
+
+    virtual void
+    runTimerTask()
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+    }
+};
+
 class TestCase :
 #ifdef ICE_CPP11_MAPPING
                  public enable_shared_from_this<TestCase>,
@@ -760,6 +771,53 @@ allTests(Test::TestHelper* helper)
         (*p)->destroy();
     }
 
+    cout << "testing connection monitor destruction... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = com->createObjectAdapter(-1, -1, -1);
+
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ACM.Client.Timeout", "1");
+        initData.properties->setProperty("Ice.ACM.Client.Close", "0"); // CloseOff
+        initData.properties->setProperty("Ice.ACM.Client.Heartbeat", "0"); // HeartbeatOff
+        for(int i = 0; i < 3; ++i)
+        {
+            Ice::CommunicatorPtr comm = Ice::initialize(initData);
+            TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+                comm->stringToProxy(adapter->getTestIntf()->ice_toString()));
+
+            //
+            // The connection is parked once monitored since there's nothing to
+            // monitor with CloseOff and HeartbeatOff. The next invocation adds
+            // it back to a bucket. Closing the connection removes it from the
+            // monitor but leaves its bucket entry, which must not keep the
+            // monitor timer task scheduled once the communicator is destroyed.
+            //
+            proxy->ice_ping();
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(700));
+            proxy->ice_ping();
+            Ice::ConnectionPtr connection = proxy->ice_getConnection();
+            connection->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            proxy = ICE_NULLPTR;
+
+            //
+            // Keep the timer thread busy while the communicator is destroyed, the
+            // monitor timer task can't clear the bucket before the timer is destroyed.
+            // The destroyed monitor must no longer reference the connection.
+            //
+            IceInternal::getInstanceTimer(comm)->schedule(ICE_MAKE_SHARED(BusyTimerTask), IceUtil::Time());
+            comm->destroy();
+#ifdef ICE_CPP11_MAPPING
+            test(connection.use_count() == 1);
+#else
+            test(connection->__getRef() == 1);
+#endif
+        }
+
+        adapter->deactivate();
+    }
+    cout << "ok" << endl;
+
     cout << "shutting down... " << flush;
     com->shutdown();
     cout << "ok" << endl;
@@ -4,6 +4,7 @@
 
 #include <IceUtil/Random.h>
 #include <Ice/Ice.h>
+#include <Ice/Metrics.h>
 #include <TestHelper.h>
 #include <Test.h>
 #include <set>
@@ -822,6 +823,176 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing parallel connection establishment... " << flush;
+    {
+        const char* delays[] = { "0", "50" };
+        for(int i = 0; i < 2; ++i)
+        {
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.ConnectAttemptDelay", delays[i]);
+            Ice::CommunicatorPtr comm = Ice::initialize(initData);
+
+            vector<RemoteObjectAdapterPrxPtr> adapters;
+            adapters.push_back(com->createObjectAdapter("Adapter81", "default"));
+            adapters.push_back(com->createObjectAdapter("Adapter82", "default"));
+            adapters.push_back(com->createObjectAdapter("Adapter83", "default"));
+            TestIntfPrxPtr obj = createTestIntfPrx(adapters);
+            com->deactivateObjectAdapter(adapters[0]);
+
+            //
+            // The connection is established to one of the live adapters.
+            //
+            TestIntfPrxPtr test1 = ICE_UNCHECKED_CAST(TestIntfPrx,
+                comm->stringToProxy(communicator->proxyToString(obj))->ice_endpointSelection(
+                    Ice::ICE_ENUM(EndpointSelectionType, Ordered)));
+            string name = test1->getAdapterName();
+            test(name == "Adapter82" || name == "Adapter83");
+
+            TestIntfPrxPtr test2 = ICE_UNCHECKED_CAST(TestIntfPrx, comm->stringToProxy(communicator->proxyToString(obj)));
+            test(test2->getAdapterName() == name);
+            test(test1->ice_getConnection() == test2->ice_getConnection());
+
+            com->deactivateObjectAdapter(adapters[1]);
+            com->deactivateObjectAdapter(adapters[2]);
+            try
+            {
+                test2->ice_connectionId("other")->ice_ping();
+                test(false);
+            }
+            catch(const Ice::ConnectFailedException&)
+            {
+            }
+            catch(const Ice::ConnectTimeoutException&)
+            {
+            }
+            comm->destroy();
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing parallel connection establishment with a hanging endpoint... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ConnectAttemptDelay", "50");
+        initData.properties->setProperty("Ice.Override.ConnectTimeout", "30000");
+        initData.properties->setProperty("Ice.Admin.Enabled", "1");
+        initData.properties->setProperty("Ice.Admin.DelayCreation", "1");
+        initData.properties->setProperty("IceMX.Metrics.View.Map.ConnectionEstablishment.GroupBy", "id");
+        Ice::CommunicatorPtr comm = Ice::initialize(initData);
+        IceMX::MetricsAdminPtr metrics = ICE_DYNAMIC_CAST(IceMX::MetricsAdmin, comm->findAdminFacet("Metrics"));
+        test(metrics);
+
+        //
+        // The adapter isn't activated, it listens but doesn't accept connections:
+        // the connection attempts to its endpoint hang until the connect timeout.
+        //
+        Ice::ObjectAdapterPtr hang = communicator->createObjectAdapterWithEndpoints("Hang", "default");
+        RemoteObjectAdapterPrxPtr adapter = com->createObjectAdapter("Adapter84", "default");
+        TestIntfPrxPtr obj = adapter->getTestIntf();
+        Ice::EndpointSeq endpoints = hang->getEndpoints();
+        Ice::EndpointSeq live = obj->ice_getEndpoints();
+        endpoints.insert(endpoints.end(), live.begin(), live.end());
+
+        //
+        // The attempt to the live adapter is started after the delay rather than
+        // after the connect timeout of the hanging attempt.
+        //
+        TestIntfPrxPtr test1 = ICE_UNCHECKED_CAST(TestIntfPrx,
+            comm->stringToProxy(communicator->proxyToString(obj->ice_endpoints(endpoints)))->ice_endpointSelection(
+                Ice::ICE_ENUM(EndpointSelectionType, Ordered)));
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        test(test1->getAdapterName() == "Adapter84");
+        test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(10));
+
+        //
+        // The hanging attempt is canceled once the connection to the live adapter
+        // is established instead of staying pending until the connect timeout.
+        //
+        Ice::Long total = 0;
+        Ice::Int current = 1;
+        for(int i = 0; i < 100 && current > 0; ++i)
+        {
+            Ice::Long timestamp;
+            IceMX::MetricsView view = metrics->getMetricsView("View", timestamp, Ice::emptyCurrent);
+            IceMX::MetricsMap map = view["ConnectionEstablishment"];
+            total = 0;
+            current = 0;
+            for(IceMX::MetricsMap::const_iterator p = map.begin(); p != map.end(); ++p)
+            {
+                total += (*p)->total;
+                current += (*p)->current;
+            }
+            if(current > 0)
+            {
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+            }
+        }
+        test(total == 2 && current == 0);
+
+        hang->destroy();
+        com->deactivateObjectAdapter(adapter);
+        comm->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection pool... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ConnectionPoolSize", "3");
+        Ice::CommunicatorPtr comm = Ice::initialize(initData);
+
+        RemoteObjectAdapterPrxPtr adapter = com->createObjectAdapter("Adapter91", "default");
+        TestIntfPrxPtr obj = ICE_UNCHECKED_CAST(TestIntfPrx,
+            comm->stringToProxy(communicator->proxyToString(adapter->getTestIntf())));
+        test(obj->getAdapterName() == "Adapter91");
+
+        //
+        // Concurrent invocations are spread over up to 3 connections.
+        //
+        set<string> connections;
+        for(int i = 0; i < 100 && connections.size() < 3; ++i)
+        {
+#ifdef ICE_CPP11_MAPPING
+            vector<future<string>> results;
+            for(int j = 0; j < 20; ++j)
+            {
+                results.push_back(obj->getConnectionInfoAsync());
+            }
+            for(vector<future<string>>::iterator p = results.begin(); p != results.end(); ++p)
+            {
+                connections.insert(p->get());
+            }
+#else
+            vector<Ice::AsyncResultPtr> results;
+            for(int j = 0; j < 20; ++j)
+            {
+                results.push_back(obj->begin_getConnectionInfo());
+            }
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                connections.insert(obj->end_getConnectionInfo(*p));
+            }
+#endif
+        }
+        test(connections.size() == 3);
+
+        //
+        // Invocations are retried on another connection if a pooled connection is closed.
+        //
+        for(int i = 0; i < 3; ++i)
+        {
+            obj->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            test(obj->getAdapterName() == "Adapter91");
+        }
+
+        com->deactivateObjectAdapter(adapter);
+        comm->destroy();
+    }
+    cout << "ok" << endl;
+
     if(!communicator->getProperties()->getProperty("Ice.Plugin.IceSSL").empty() &&
        communicator->getProperties()->getProperty("Ice.Default.Protocol") == "ssl")
     {
@@ -102,3 +102,9 @@ TestI::getAdapterName(const Ice::Current& current)
 {
     return current.adapter->getName();
 }
+
+std::string
+TestI::getConnectionInfo(const Ice::Current& current)
+{
+    return current.con->toString();
+}
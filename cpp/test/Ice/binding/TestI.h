@@ -50,6 +50,7 @@ class TestI : public Test::TestIntf
 public:
 
     virtual std::string getAdapterName(const Ice::Current&);
+    virtual std::string getConnectionInfo(const Ice::Current&);
 };
 
 #endif
@@ -1023,6 +1023,36 @@ allTests(Test::TestHelper* helper)
         }
         cout << "ok" << endl;
     }
+    else if(!thrower->ice_getConnection())
+    {
+        cout << "testing memory limit marshal exception with collocated calls... " << flush;
+
+        //
+        // The collocated adapter MessageSizeMax is 10KB, it's enforced
+        // for direct calls and for the regular collocated invocations
+        // (with an invocation timeout).
+        //
+        ThrowerPrxPtr thrower2 = thrower->ice_invocationTimeout(10000);
+        try
+        {
+            thrower->throwMemoryLimitException(Ice::ByteSeq(20 * 1024)); // 20KB
+            test(false);
+        }
+        catch(const Ice::MemoryLimitException&)
+        {
+        }
+        try
+        {
+            thrower2->throwMemoryLimitException(Ice::ByteSeq(20 * 1024)); // 20KB
+            test(false);
+        }
+        catch(const Ice::MemoryLimitException&)
+        {
+        }
+        thrower->throwMemoryLimitException(Ice::ByteSeq(1024));
+        thrower2->throwMemoryLimitException(Ice::ByteSeq(1024));
+        cout << "ok" << endl;
+    }
 
     cout << "catching object not exist exception... " << flush;
 
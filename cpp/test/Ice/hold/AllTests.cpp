@@ -327,6 +327,236 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing dispatch limits... " << flush;
+    {
+        //
+        // With a connection limit of one dispatch, requests from the
+        // same connection are dispatched in order.
+        //
+        HoldPrxPtr holdLimited = ICE_UNCHECKED_CAST(HoldPrx, communicator->stringToProxy("hold:" +
+                                                                                         helper->getTestEndpoint(2)));
+        ConditionPtr cond = new Condition(true);
+        int value = 0;
+        holdLimited->set(value, 0);
+#ifdef ICE_CPP11_MAPPING
+        shared_ptr<promise<void>> completed;
+        while(value < 1000 && cond->value())
+        {
+            completed = make_shared<promise<void>>();
+            auto sent = make_shared<promise<bool>>();
+            auto expected = value;
+            holdLimited->setAsync(
+                value + 1,
+                static_cast<Ice::Int>(IceUtilInternal::random(5)),
+                [cond, expected, completed](int val)
+                {
+                    if(val != expected)
+                    {
+                        cond->set(false);
+                    }
+                    completed->set_value();
+                },
+                [completed](exception_ptr)
+                {
+                    completed->set_value();
+                },
+                [sent](bool sentSynchronously)
+                {
+                    sent->set_value(sentSynchronously);
+                });
+            ++value;
+            if(value % 100 == 0)
+            {
+                sent->get_future().get();
+                holdLimited->ice_oneway()->putOnHold(0);
+            }
+        }
+        completed->get_future().get();
+#else
+        Ice::AsyncResultPtr result;
+        while(value < 1000 && cond->value())
+        {
+            result = holdLimited->begin_set(value + 1,
+                                            static_cast<Ice::Int>(IceUtilInternal::random(5)),
+                                            newCallback_Hold_set(new SetCB(cond, value),
+                                                                 &SetCB::response,
+                                                                 &SetCB::exception));
+            ++value;
+            if(value % 100 == 0)
+            {
+                result->waitForSent();
+                holdLimited->ice_oneway()->putOnHold(0);
+            }
+        }
+        result->waitForCompleted();
+#endif
+        test(cond->value());
+
+        //
+        // The adapter limit is shared by all the connections, ensure
+        // suspended connections resume reading.
+        //
+        HoldPrxPtr holdAdapterLimited = ICE_UNCHECKED_CAST(HoldPrx, communicator->stringToProxy(
+                                                               "hold:" + helper->getTestEndpoint(3)));
+        vector<HoldPrxPtr> proxies;
+        for(int i = 0; i < 4; ++i)
+        {
+            ostringstream os;
+            os << "c" << i;
+            proxies.push_back(holdAdapterLimited->ice_connectionId(os.str()));
+        }
+#ifdef ICE_CPP11_MAPPING
+        vector<future<int>> results;
+        for(int i = 0; i < 400; ++i)
+        {
+            Ice::Int delay = static_cast<Ice::Int>(IceUtilInternal::random(3));
+            results.push_back(proxies[i % proxies.size()]->setAsync(i, delay));
+        }
+        for(vector<future<int>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            p->get();
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 400; ++i)
+        {
+            Ice::Int delay = static_cast<Ice::Int>(IceUtilInternal::random(3));
+            results.push_back(proxies[i % proxies.size()]->begin_set(i, delay));
+        }
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            proxies[i % proxies.size()]->end_set(results[i]);
+        }
+#endif
+        for(vector<HoldPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            (*p)->ice_ping();
+        }
+
+        //
+        // Many requests are outstanding on the connections, no more
+        // than 2 of them are dispatched at once.
+        //
+        results.clear();
+#ifdef ICE_CPP11_MAPPING
+        for(int i = 0; i < 40; ++i)
+        {
+            results.push_back(proxies[i % proxies.size()]->setAsync(i, 5));
+        }
+        int outstanding = 0;
+        for(vector<future<int>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            if(p->wait_for(chrono::seconds(0)) != future_status::ready)
+            {
+                ++outstanding;
+            }
+        }
+        test(outstanding > 2);
+        for(vector<future<int>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            p->get();
+        }
+#else
+        for(int i = 0; i < 40; ++i)
+        {
+            results.push_back(proxies[i % proxies.size()]->begin_set(i, 5));
+        }
+        int outstanding = 0;
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            if(!(*p)->isCompleted())
+            {
+                ++outstanding;
+            }
+        }
+        test(outstanding > 2);
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            proxies[i % proxies.size()]->end_set(results[i]);
+        }
+#endif
+        int maxConcurrency = holdAdapterLimited->getMaxConcurrency();
+        test(maxConcurrency >= 1 && maxConcurrency <= 2);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing priority lanes... " << flush;
+    {
+        //
+        // A single thread dispatches normal priority requests, the
+        // other thread is reserved for high priority requests.
+        //
+        HoldPrxPtr holdLanes = ICE_UNCHECKED_CAST(HoldPrx, communicator->stringToProxy("hold:" +
+                                                                                       helper->getTestEndpoint(4)));
+        Ice::Context ctx;
+        ctx["_priority"] = "high";
+        HoldPrxPtr holdHigh = holdLanes->ice_context(ctx)->ice_connectionId("high");
+        holdHigh->ice_ping();
+
+        //
+        // Block the thread dispatching normal priority requests, the
+        // following normal priority requests are queued until it's
+        // unblocked while high priority requests are dispatched.
+        //
+        HoldPrxPtr holdBlocked = holdLanes->ice_connectionId("blocked");
+#ifdef ICE_CPP11_MAPPING
+        auto blocked = holdBlocked->blockAsync();
+#else
+        Ice::AsyncResultPtr blocked = holdBlocked->begin_block();
+#endif
+        while(!holdHigh->isBlocked())
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+
+#ifdef ICE_CPP11_MAPPING
+        vector<future<int>> results;
+        for(int i = 0; i < 3; ++i)
+        {
+            ostringstream os;
+            os << "c" << i;
+            results.push_back(holdLanes->ice_connectionId(os.str())->setAsync(i, 0));
+        }
+        holdHigh->set(10, 0);
+        for(vector<future<int>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(p->wait_for(chrono::seconds(0)) != future_status::ready);
+        }
+        test(blocked.wait_for(chrono::seconds(0)) != future_status::ready);
+
+        holdHigh->unblock();
+        blocked.get();
+        for(vector<future<int>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            p->get();
+        }
+#else
+        vector<HoldPrx> proxies;
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 3; ++i)
+        {
+            ostringstream os;
+            os << "c" << i;
+            proxies.push_back(holdLanes->ice_connectionId(os.str()));
+            results.push_back(proxies.back()->begin_set(i, 0));
+        }
+        holdHigh->set(10, 0);
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(!(*p)->isCompleted());
+        }
+        test(!blocked->isCompleted());
+
+        holdHigh->unblock();
+        holdBlocked->end_block(blocked);
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            proxies[i]->end_set(results[i]);
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
     cout << "changing state to hold and shutting down server... " << flush;
     hold->shutdown();
     cout << "ok" << endl;
@@ -37,8 +37,39 @@ Server::run(int argc, char** argv)
     Ice::ObjectAdapterPtr adapter2 = communicator->createObjectAdapter("TestAdapter2");
     adapter2->add(ICE_MAKE_SHARED(HoldI, timer, adapter2), Ice::stringToIdentity("hold"));
 
+    communicator->getProperties()->setProperty("TestAdapter3.Endpoints", getTestEndpoint(2));
+    communicator->getProperties()->setProperty("TestAdapter3.ThreadPool.Size", "5");
+    communicator->getProperties()->setProperty("TestAdapter3.ThreadPool.SizeMax", "5");
+    communicator->getProperties()->setProperty("TestAdapter3.ThreadPool.SizeWarn", "0");
+    communicator->getProperties()->setProperty("TestAdapter3.ThreadPool.Serialize", "0");
+    communicator->getProperties()->setProperty("TestAdapter3.Connection.MaxDispatches", "1");
+    Ice::ObjectAdapterPtr adapter3 = communicator->createObjectAdapter("TestAdapter3");
+    adapter3->add(ICE_MAKE_SHARED(HoldI, timer, adapter3), Ice::stringToIdentity("hold"));
+
+    communicator->getProperties()->setProperty("TestAdapter4.Endpoints", getTestEndpoint(3));
+    communicator->getProperties()->setProperty("TestAdapter4.ThreadPool.Size", "5");
+    communicator->getProperties()->setProperty("TestAdapter4.ThreadPool.SizeMax", "5");
+    communicator->getProperties()->setProperty("TestAdapter4.ThreadPool.SizeWarn", "0");
+    communicator->getProperties()->setProperty("TestAdapter4.ThreadPool.Serialize", "0");
+    communicator->getProperties()->setProperty("TestAdapter4.MaxDispatches", "2");
+    Ice::ObjectAdapterPtr adapter4 = communicator->createObjectAdapter("TestAdapter4");
+    adapter4->add(ICE_MAKE_SHARED(HoldI, timer, adapter4), Ice::stringToIdentity("hold"));
+
+    communicator->getProperties()->setProperty("TestAdapter5.Endpoints", getTestEndpoint(4));
+    communicator->getProperties()->setProperty("TestAdapter5.ThreadPool.Size", "2");
+    communicator->getProperties()->setProperty("TestAdapter5.ThreadPool.SizeMax", "2");
+    communicator->getProperties()->setProperty("TestAdapter5.ThreadPool.SizeWarn", "0");
+    communicator->getProperties()->setProperty("TestAdapter5.ThreadPool.Serialize", "0");
+    communicator->getProperties()->setProperty("TestAdapter5.ThreadPool.ReservedThreads", "1");
+    communicator->getProperties()->setProperty("TestAdapter5.PriorityOperations", "shutdown");
+    Ice::ObjectAdapterPtr adapter5 = communicator->createObjectAdapter("TestAdapter5");
+    adapter5->add(ICE_MAKE_SHARED(HoldI, timer, adapter5), Ice::stringToIdentity("hold"));
+
     adapter1->activate();
     adapter2->activate();
+    adapter3->activate();
+    adapter4->activate();
+    adapter5->activate();
 
     serverReady();
 
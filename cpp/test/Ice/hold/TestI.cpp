@@ -8,7 +8,7 @@
 #include <TestHelper.h>
 
 HoldI::HoldI(const IceUtil::TimerPtr& timer, const Ice::ObjectAdapterPtr& adapter) :
-    _last(0), _timer(timer), _adapter(adapter)
+    _last(0), _concurrency(0), _maxConcurrency(0), _blocked(false), _timer(timer), _adapter(adapter)
 {
 }
 
@@ -82,14 +82,56 @@ HoldI::waitForHold(const Ice::Current& current)
 Ice::Int
 HoldI::set(Ice::Int value, Ice::Int delay, const Ice::Current&)
 {
+    {
+        Lock sync(*this);
+        if(++_concurrency > _maxConcurrency)
+        {
+            _maxConcurrency = _concurrency;
+        }
+    }
+
     IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(delay));
 
     Lock sync(*this);
+    --_concurrency;
     Ice::Int tmp = _last;
     _last = value;
     return tmp;
 }
 
+Ice::Int
+HoldI::getMaxConcurrency(const Ice::Current&)
+{
+    Lock sync(*this);
+    return _maxConcurrency;
+}
+
+void
+HoldI::block(const Ice::Current&)
+{
+    Lock sync(*this);
+    _blocked = true;
+    while(_blocked)
+    {
+        wait();
+    }
+}
+
+bool
+HoldI::isBlocked(const Ice::Current&)
+{
+    Lock sync(*this);
+    return _blocked;
+}
+
+void
+HoldI::unblock(const Ice::Current&)
+{
+    Lock sync(*this);
+    _blocked = false;
+    notifyAll();
+}
+
 void
 HoldI::setOneway(Ice::Int value, Ice::Int expected, const Ice::Current&)
 {
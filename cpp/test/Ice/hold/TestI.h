@@ -7,7 +7,7 @@
 
 #include <Test.h>
 
-class HoldI : public Test::Hold, public IceUtil::Mutex, public IceUtil::TimerTask
+class HoldI : public Test::Hold, public IceUtil::Monitor<IceUtil::Mutex>, public IceUtil::TimerTask
 #ifdef ICE_CPP11_MAPPING
     , public std::enable_shared_from_this<HoldI>
 #endif
@@ -19,6 +19,10 @@ public:
     virtual void putOnHold(Ice::Int, const Ice::Current&);
     virtual void waitForHold(const Ice::Current&);
     virtual Ice::Int set(Ice::Int, Ice::Int, const Ice::Current&);
+    virtual Ice::Int getMaxConcurrency(const Ice::Current&);
+    virtual void block(const Ice::Current&);
+    virtual bool isBlocked(const Ice::Current&);
+    virtual void unblock(const Ice::Current&);
     virtual void setOneway(Ice::Int, Ice::Int, const Ice::Current&);
     virtual void shutdown(const Ice::Current&);
 
@@ -27,6 +31,9 @@ public:
 private:
 
     int _last;
+    int _concurrency;
+    int _maxConcurrency;
+    bool _blocked;
     const IceUtil::TimerPtr _timer;
     const Ice::ObjectAdapterPtr _adapter;
 };
@@ -54,6 +54,158 @@ public:
 };
 typedef IceUtil::Handle<AMICallback> AMICallbackPtr;
 
+//
+// A locator which forwards the lookups to the test locator, counts
+// them and holds the adapter lookup replies on demand.
+//
+class ControlledLocatorI : public Ice::Locator, private IceUtil::Mutex
+{
+public:
+
+    ControlledLocatorI(const Ice::LocatorPrxPtr& locator) : _locator(locator), _hold(false), _requestCount(0)
+    {
+    }
+
+#ifdef ICE_CPP11_MAPPING
+    virtual void
+    findObjectByIdAsync(Ice::Identity id,
+                        function<void(const shared_ptr<Ice::ObjectPrx>&)> response,
+                        function<void(exception_ptr)>,
+                        const Ice::Current&) const
+    {
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            ++_requestCount;
+        }
+        response(_locator->findObjectById(id));
+    }
+
+    virtual void
+    findAdapterByIdAsync(string id,
+                         function<void(const shared_ptr<Ice::ObjectPrx>&)> response,
+                         function<void(exception_ptr)>,
+                         const Ice::Current&) const
+    {
+        shared_ptr<Ice::ObjectPrx> proxy = _locator->findAdapterById(id);
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            ++_requestCount;
+            if(_hold)
+            {
+                _held.push_back([response, proxy]() { response(proxy); });
+                return;
+            }
+        }
+        response(proxy);
+    }
+#else
+    virtual void
+    findObjectById_async(const Ice::AMD_Locator_findObjectByIdPtr& response, const Ice::Identity& id,
+                         const Ice::Current&) const
+    {
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            ++_requestCount;
+        }
+        response->ice_response(_locator->findObjectById(id));
+    }
+
+    virtual void
+    findAdapterById_async(const Ice::AMD_Locator_findAdapterByIdPtr& response, const string& id,
+                          const Ice::Current&) const
+    {
+        Ice::ObjectPrx proxy = _locator->findAdapterById(id);
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            ++_requestCount;
+            if(_hold)
+            {
+                _held.push_back(make_pair(response, proxy));
+                return;
+            }
+        }
+        response->ice_response(proxy);
+    }
+#endif
+
+    virtual Ice::LocatorRegistryPrxPtr
+    getRegistry(const Ice::Current&) const
+    {
+        return ICE_NULLPTR;
+    }
+
+    int
+    getRequestCount() const
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        return _requestCount;
+    }
+
+    void
+    hold()
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        _hold = true;
+    }
+
+    void
+    release()
+    {
+#ifdef ICE_CPP11_MAPPING
+        vector<function<void()>> held;
+#else
+        vector<pair<Ice::AMD_Locator_findAdapterByIdPtr, Ice::ObjectPrx> > held;
+#endif
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            _hold = false;
+            held.swap(_held);
+        }
+#ifdef ICE_CPP11_MAPPING
+        for(vector<function<void()>>::const_iterator p = held.begin(); p != held.end(); ++p)
+        {
+            (*p)();
+        }
+#else
+        for(vector<pair<Ice::AMD_Locator_findAdapterByIdPtr, Ice::ObjectPrx> >::const_iterator p = held.begin();
+            p != held.end(); ++p)
+        {
+            p->first->ice_response(p->second);
+        }
+#endif
+    }
+
+private:
+
+    const Ice::LocatorPrxPtr _locator;
+    bool _hold;
+    mutable int _requestCount;
+#ifdef ICE_CPP11_MAPPING
+    mutable vector<function<void()>> _held;
+#else
+    mutable vector<pair<Ice::AMD_Locator_findAdapterByIdPtr, Ice::ObjectPrx> > _held;
+#endif
+};
+ICE_DEFINE_PTR(ControlledLocatorIPtr, ControlledLocatorI);
+
+IceMX::LocatorCacheMetricsPtr
+getLocatorCacheMetrics(const Ice::CommunicatorPtr& communicator, const string& adapterId)
+{
+    IceMX::MetricsAdminPtr metrics = ICE_DYNAMIC_CAST(IceMX::MetricsAdmin, communicator->findAdminFacet("Metrics"));
+    test(metrics);
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp, Ice::Current());
+    for(IceMX::MetricsMap::const_iterator p = view["LocatorCache"].begin(); p != view["LocatorCache"].end(); ++p)
+    {
+        if((*p)->id == adapterId)
+        {
+            return ICE_DYNAMIC_CAST(IceMX::LocatorCacheMetrics, *p);
+        }
+    }
+    test(false);
+    return ICE_NULLPTR;
+}
+
 void
 allTests(Test::TestHelper* helper, const string& ref)
 {
@@ -627,6 +779,119 @@ allTests(Test::TestHelper* helper, const string& ref)
     }
     cout << "ok" << endl;
 
+    cout << "testing locator cache refresh... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheRefreshThreshold", "1");
+        initData.properties->setProperty("Ice.Admin.Enabled", "1");
+        initData.properties->setProperty("Ice.Admin.InstanceName", "client");
+        initData.properties->setProperty("IceMX.Metrics.View.Map.LocatorCache.GroupBy", "adapterId");
+        Ice::CommunicatorPtr ic = Ice::initialize(initData);
+
+        ControlledLocatorIPtr controlled = ICE_MAKE_SHARED(ControlledLocatorI, locator);
+        Ice::ObjectAdapterPtr adapter = ic->createObjectAdapter("");
+        Ice::LocatorPrxPtr controlledPrx = ICE_UNCHECKED_CAST(Ice::LocatorPrx, adapter->addWithUUID(controlled));
+        adapter->activate();
+
+        //
+        // Each new proxy looks up the endpoints in the locator cache.
+        //
+        ic->stringToProxy("test@TestAdapter")->ice_locator(controlledPrx)->ice_locatorCacheTimeout(1)->ice_ping();
+        test(controlled->getRequestCount() == 1);
+
+        //
+        // Past 1% of the 1s locator cache timeout, the cached endpoints
+        // are still used but are refreshed in the background. The
+        // invocations don't wait for the held refresh and no other
+        // refresh is sent while it's pending.
+        //
+        controlled->hold();
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        while(controlled->getRequestCount() == 1)
+        {
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(10));
+            ic->stringToProxy("test@TestAdapter")->ice_locator(controlledPrx)->ice_locatorCacheTimeout(1)->ice_ping();
+        }
+        for(i = 0; i < 10; ++i)
+        {
+            ic->stringToProxy("test@TestAdapter")->ice_locator(controlledPrx)->ice_locatorCacheTimeout(1)->ice_ping();
+        }
+        test(controlled->getRequestCount() == 2);
+
+        IceMX::LocatorCacheMetricsPtr m = getLocatorCacheMetrics(ic, "TestAdapter");
+        test(m->current == 0 && m->total == m->hits + m->misses && m->hits >= 11);
+        test(m->misses == 1 && m->refreshes == 1 && m->negativeHits == 0);
+        controlled->release();
+
+        //
+        // The endpoints are not refreshed with a longer timeout.
+        //
+        ic->stringToProxy("test@TestAdapter")->ice_locator(controlledPrx)->ice_locatorCacheTimeout(100)->ice_ping();
+        test(controlled->getRequestCount() == 2);
+        ic->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing locator negative cache... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheNegativeTimeout", "60");
+        initData.properties->setProperty("Ice.Admin.Enabled", "1");
+        initData.properties->setProperty("Ice.Admin.InstanceName", "client");
+        initData.properties->setProperty("IceMX.Metrics.View.Map.LocatorCache.GroupBy", "adapterId");
+        Ice::CommunicatorPtr ic = Ice::initialize(initData);
+
+        count = locator->getRequestCount();
+        for(i = 0; i < 3; ++i)
+        {
+            try
+            {
+                ic->stringToProxy("test@TestAdapterUnknown")->ice_ping();
+                test(false);
+            }
+            catch(const Ice::NotRegisteredException& ex)
+            {
+                test(ex.kindOfObject == "object adapter");
+                test(ex.id == "TestAdapterUnknown");
+            }
+            try
+            {
+                ic->stringToProxy("unknown/unknown")->ice_ping();
+                test(false);
+            }
+            catch(const Ice::NotRegisteredException& ex)
+            {
+                test(ex.kindOfObject == "object");
+                test(ex.id == "unknown/unknown");
+            }
+        }
+        count += 2;
+        test(count == locator->getRequestCount());
+
+        //
+        // The lookups following the first miss are negative hits, an
+        // invocation might look up the endpoints again before failing.
+        //
+        IceMX::LocatorCacheMetricsPtr m = getLocatorCacheMetrics(ic, "TestAdapterUnknown");
+        test(m->misses == 1 && m->negativeHits >= 2 && m->total == m->misses + m->negativeHits && m->hits == 0);
+        m = getLocatorCacheMetrics(ic, ""); // Well-known objects.
+        test(m->misses == 1 && m->negativeHits >= 2 && m->total == m->misses + m->negativeHits && m->hits == 0);
+
+        try
+        {
+            ic->stringToProxy("test@TestAdapterUnknown")->ice_locatorCacheTimeout(0)->ice_ping(); // No locator cache.
+            test(false);
+        }
+        catch(const Ice::NotRegisteredException&)
+        {
+        }
+        test(locator->getRequestCount() > count);
+        ic->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "testing proxy from server after shutdown... " << flush;
     hello = obj->getReplicatedHello();
     obj->shutdown();
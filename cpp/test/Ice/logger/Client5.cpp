@@ -116,6 +116,69 @@ Client5::run(int, char**)
         runTest(ich.communicator());
     }
 
+    //
+    // Same as client5-2 with asynchronous logging, the messages are written and archived
+    // by the logger queue thread.
+    //
+    {
+        Ice::InitializationData id;
+        id.properties = Ice::createProperties();
+        id.properties->load("config.client");
+        id.properties->setProperty("Client.Iterations", "8");
+        id.properties->setProperty("Client.Message", message);
+        id.properties->setProperty("Ice.LogFile", "client5-5.log");
+        id.properties->setProperty("Ice.LogFile.SizeMax", "128");
+        id.properties->setProperty("Ice.LogAsync", "1");
+
+        Ice::CommunicatorHolder ich = Ice::initialize(id);
+        runTest(ich.communicator());
+    }
+
+    //
+    // Run Client application configured to generate 1024 bytes with asynchronous logging and
+    // a queue of one message. With the Block overflow policy no messages are dropped and the
+    // log file must have 1024 bytes size.
+    //
+    {
+        Ice::InitializationData id;
+        id.properties = Ice::createProperties();
+        id.properties->load("config.client");
+        id.properties->setProperty("Client.Iterations", "8");
+        id.properties->setProperty("Client.Message", message);
+        id.properties->setProperty("Ice.LogFile", "client5-6.log");
+        id.properties->setProperty("Ice.LogAsync", "1");
+        id.properties->setProperty("Ice.LogAsync.QueueSize", "1");
+        id.properties->setProperty("Ice.LogAsync.Overflow", "Block");
+
+        Ice::CommunicatorHolder ich = Ice::initialize(id);
+        runTest(ich.communicator());
+    }
+
+    //
+    // Fill a logger queue of one message with numbered messages. With the DropNewest overflow
+    // policy the first message is always written, with DropOldest the last message is always
+    // written. The warnings report the number of dropped messages.
+    //
+    const char* policies[] = { "DropNewest", "DropOldest" };
+    for(int i = 0; i < 2; ++i)
+    {
+        Ice::InitializationData id;
+        id.properties = Ice::createProperties();
+        id.properties->load("config.client");
+        id.properties->setProperty("Ice.LogFile", string("client5-") + policies[i] + ".log");
+        id.properties->setProperty("Ice.LogAsync", "1");
+        id.properties->setProperty("Ice.LogAsync.QueueSize", "1");
+        id.properties->setProperty("Ice.LogAsync.Overflow", policies[i]);
+
+        Ice::CommunicatorHolder ich = Ice::initialize(id);
+        for(int j = 0; j < 10000; ++j)
+        {
+            ostringstream os;
+            os << "message " << j;
+            ich->getLogger()->print(os.str());
+        }
+    }
+
     //
     // Run Client application configured to generate 1024 bytes, the application is configured
     // to archive log files greater than 512 bytes, but the log directory is set to read only
@@ -4,6 +4,7 @@
 #
 
 import glob
+import re
 
 def test(process, current, match, enc, mapping):
     cmd = process.getCommandLine(current)
@@ -100,6 +101,35 @@ class IceLoggerTestCase(ClientTestCase):
                 print("failed! file {0} size: {1} unexpected".format(f, os.stat(f).st_size))
                 raise RuntimeError("failed!")
 
+        if (not os.path.isfile("client5-5.log") or
+            not os.stat("client5-5.log").st_size == 128 or
+            len(glob.glob("client5-5-*.log")) != 7):
+            raise RuntimeError("failed!")
+
+        for f in glob.glob("client5-5-*.log"):
+            if not os.stat(f).st_size == 128:
+                print("failed! file {0} size: {1} unexpected".format(f, os.stat(f).st_size))
+                raise RuntimeError("failed!")
+
+        if (not os.path.isfile("client5-6.log") or
+            not os.stat("client5-6.log").st_size == 1024 or
+            len(glob.glob("client5-6-*.log")) != 0):
+            raise RuntimeError("failed!")
+
+        for policy in ["DropNewest", "DropOldest"]:
+            with open("client5-{0}.log".format(policy), 'r') as f:
+                lines = f.read().splitlines()
+            messages = [l for l in lines if l.startswith("message ")]
+            warnings = [m for m in [re.search(r"warning: (\d+) log message\(s\) dropped .* \((\d+) dropped", l)
+                                    for l in lines] if m]
+            dropped = sum([int(m.group(1)) for m in warnings])
+            if not warnings or int(warnings[-1].group(2)) != dropped or len(messages) + dropped != 10000:
+                raise RuntimeError("failed!")
+            if policy == "DropNewest" and messages[0] != "message 0":
+                raise RuntimeError("failed!")
+            if policy == "DropOldest" and messages[-1] != "message 9999":
+                raise RuntimeError("failed!")
+
         #
         # When running as root log rotation will not fail as
         # root always has write access.
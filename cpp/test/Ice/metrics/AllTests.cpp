@@ -7,12 +7,66 @@
 #include <InstrumentationI.h>
 #include <Test.h>
 
+#ifdef _WIN32
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <sys/socket.h>
+#   include <netdb.h>
+#   include <unistd.h>
+#endif
+
 using namespace std;
 using namespace Test;
 
 namespace
 {
 
+//
+// Sends the given HTTP request to the metrics HTTP server and returns
+// the response, the server closes the connection after the response.
+//
+string
+httpRequest(const string& host, int port, const string& request)
+{
+    ostringstream os;
+    os << port;
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* info = 0;
+    test(getaddrinfo(host.c_str(), os.str().c_str(), &hints, &info) == 0);
+
+#ifdef _WIN32
+    SOCKET fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    test(fd != INVALID_SOCKET);
+    test(connect(fd, info->ai_addr, static_cast<int>(info->ai_addrlen)) == 0);
+    test(send(fd, request.c_str(), static_cast<int>(request.size()), 0) == static_cast<int>(request.size()));
+#else
+    int fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    test(fd >= 0);
+    test(connect(fd, info->ai_addr, info->ai_addrlen) == 0);
+    test(send(fd, request.c_str(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+#endif
+    freeaddrinfo(info);
+
+    string response;
+    char buf[4096];
+    int ret;
+    while((ret = static_cast<int>(recv(fd, buf, sizeof(buf), 0))) > 0)
+    {
+        response.append(buf, static_cast<size_t>(ret));
+    }
+#ifdef _WIN32
+    closesocket(fd);
+#else
+    close(fd);
+#endif
+    return response;
+}
+
 class CallbackBase : public IceUtil::Shared, protected IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
@@ -200,6 +254,103 @@ public:
     }
 };
 
+//
+// Queues work items with a thread of the client thread pool and keeps
+// the thread busy until the work items are executed, the other threads
+// of the pool must steal them.
+//
+class WorkStealingCallback : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    WorkStealingCallback(const Ice::ObjectPrxPtr& proxy, int count) :
+        _proxy(proxy), _count(count), _executed(0), _completed(false), _stolen(false)
+    {
+    }
+
+    void
+    response()
+    {
+        //
+        // Called from a thread of the client thread pool, the callbacks
+        // of ice_getConnection are dispatched with the thread pool.
+        //
+        for(int i = 0; i < _count; ++i)
+        {
+#ifdef ICE_CPP11_MAPPING
+            IceUtil::Handle<WorkStealingCallback> self(this);
+            _proxy->ice_getConnectionAsync(
+                [self](shared_ptr<Ice::Connection>)
+                {
+                    self->executed();
+                },
+                [](exception_ptr)
+                {
+                    test(false);
+                });
+#else
+            _proxy->begin_ice_getConnection(
+                Ice::newCallback_Object_ice_getConnection(this, &WorkStealingCallback::connection,
+                                                          &WorkStealingCallback::exception));
+#endif
+        }
+
+        Lock sync(*this);
+        IceUtil::Time timeout = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(30);
+        while(_executed < _count)
+        {
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            if(now >= timeout || !timedWait(timeout - now))
+            {
+                break;
+            }
+        }
+        _stolen = _executed == _count;
+        _completed = true;
+        notifyAll();
+    }
+
+    void
+    connection(const Ice::ConnectionPtr&)
+    {
+        executed();
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        test(false);
+    }
+
+    void
+    executed()
+    {
+        Lock sync(*this);
+        ++_executed;
+        notifyAll();
+    }
+
+    bool
+    waitForCompleted()
+    {
+        Lock sync(*this);
+        while(!_completed)
+        {
+            wait();
+        }
+        return _stolen;
+    }
+
+private:
+
+    const Ice::ObjectPrxPtr _proxy;
+    const int _count;
+    int _executed;
+    bool _completed;
+    bool _stolen;
+};
+typedef IceUtil::Handle<WorkStealingCallback> WorkStealingCallbackPtr;
+
 string
 getPort(const Ice::PropertiesAdminPrxPtr& p)
 {
@@ -693,6 +844,82 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
 
     cout << "ok" << endl;
 
+    cout << "testing accept filter..." << flush;
+    {
+        //
+        // The filter match results are cached, more identities than the
+        // cache holds are used to check that evicted results are matched
+        // again. Updating the filter discards the cached results.
+        //
+        Ice::PropertyDict filterProps;
+        filterProps["IceMX.Metrics.View.Map.Invocation.GroupBy"] = "identity";
+        filterProps["IceMX.Metrics.View.Map.Invocation.RetainDetached"] = "300";
+        filterProps["IceMX.Metrics.View.Map.Invocation.Accept.identity"] = "^filter[0-9]*[02468]$";
+        filterProps["IceMX.Metrics.View.Map.Connection.Accept.endpointPort"] = getPort(clientProps);
+        updateProps(clientProps, serverProps, update.get(), filterProps, "Invocation");
+
+        for(int j = 0; j < 2; ++j)
+        {
+            for(int i = 0; i < 300; ++i)
+            {
+                ostringstream os;
+                os << "filter" << i;
+                try
+                {
+                    metrics->ice_identity(Ice::stringToIdentity(os.str()))->ice_ping();
+                    test(false);
+                }
+                catch(const Ice::ObjectNotExistException&)
+                {
+                }
+            }
+        }
+
+        view = clientMetrics->getMetricsView("View", timestamp);
+        test(view["Invocation"].size() == 150);
+        for(IceMX::MetricsMap::const_iterator p = view["Invocation"].begin(); p != view["Invocation"].end(); ++p)
+        {
+            test((*p)->total == 2);
+            test(((*p)->id[(*p)->id.size() - 1] - '0') % 2 == 0);
+        }
+
+        filterProps["IceMX.Metrics.View.Map.Invocation.Accept.identity"] = "^filter[0-9]*[13579]$";
+        updateProps(clientProps, serverProps, update.get(), filterProps, "Invocation");
+
+        for(int i = 0; i < 300; ++i)
+        {
+            ostringstream os;
+            os << "filter" << i;
+            try
+            {
+                metrics->ice_identity(Ice::stringToIdentity(os.str()))->ice_ping();
+                test(false);
+            }
+            catch(const Ice::ObjectNotExistException&)
+            {
+            }
+        }
+
+        view = clientMetrics->getMetricsView("View", timestamp);
+        test(view["Invocation"].size() == 150);
+        for(IceMX::MetricsMap::const_iterator p = view["Invocation"].begin(); p != view["Invocation"].end(); ++p)
+        {
+            test((*p)->total == 1);
+            test(((*p)->id[(*p)->id.size() - 1] - '0') % 2 == 1);
+        }
+
+        if(!collocated)
+        {
+            metrics->ice_identity(Ice::stringToIdentity("filter0"))->ice_getConnection()->close(
+                Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            waitForCurrent(clientMetrics, "View", "Connection", 0);
+            waitForCurrent(serverMetrics, "View", "Connection", 0);
+        }
+
+        clearView(clientProps, serverProps, update.get());
+    }
+    cout << "ok" << endl;
+
     map<string, IceMX::MetricsPtr> map;
 
     string type;
@@ -989,6 +1216,104 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
 #endif
     }
 
+    if(!collocated)
+    {
+        cout << "testing connection monitor metrics... " << flush;
+
+        //
+        // Use a communicator with a short client ACM timeout, the
+        // connection monitor sweeps its connections every 125ms.
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ACM.Client.Timeout", "1");
+        initData.properties->setProperty("Ice.Admin.InstanceName", "acm");
+        initData.properties->setProperty("IceMX.Http.Port", "");
+        initData.properties->setProperty("IceMX.Metrics.View.Map.ACM.GroupBy", "id");
+        Ice::CommunicatorPtr acmCommunicator = Ice::initialize(initData);
+        IceMX::MetricsAdminPrxPtr acmMetrics =
+            ICE_CHECKED_CAST(IceMX::MetricsAdminPrx, acmCommunicator->getAdmin(), "Metrics");
+
+        MetricsPrxPtr acmProxy = ICE_UNCHECKED_CAST(MetricsPrx, acmCommunicator->stringToProxy(
+                                                        "metrics:" + endpoint));
+        acmProxy->ice_ping();
+
+        IceMX::ACMMetricsPtr acm;
+        for(int i = 0; i < 100; ++i)
+        {
+            IceMX::MetricsView acmView = acmMetrics->getMetricsView("View", timestamp);
+            test(acmView["ACM"].size() <= 1);
+            if(!acmView["ACM"].empty())
+            {
+                acm = ICE_DYNAMIC_CAST(IceMX::ACMMetrics, acmView["ACM"][0]);
+                if(acm->total >= 2)
+                {
+                    break;
+                }
+            }
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(50));
+        }
+
+        //
+        // The connection is checked by each sweep until it's closed
+        // by the monitor and removed.
+        //
+        test(acm && acm->id == "Client" && acm->current == 0 && acm->total >= 2);
+        test(acm->monitored >= acm->total && acm->parked == 0);
+        test(acm->connections <= 1 && acm->buckets <= 1);
+
+        acmCommunicator->destroy();
+        cout << "ok" << endl;
+
+        cout << "testing thread pool work stealing metrics... " << flush;
+
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ThreadPool.Client.Size", "4");
+        initData.properties->setProperty("Ice.ThreadPool.Client.WorkStealing", "1");
+        initData.properties->setProperty("Ice.Admin.InstanceName", "workStealing");
+        initData.properties->setProperty("IceMX.Http.Port", "");
+        initData.properties->setProperty("IceMX.Metrics.View.Map.ThreadPool.GroupBy", "id");
+        Ice::CommunicatorPtr wsCommunicator = Ice::initialize(initData);
+        IceMX::MetricsAdminPrxPtr wsMetrics =
+            ICE_CHECKED_CAST(IceMX::MetricsAdminPrx, wsCommunicator->getAdmin(), "Metrics");
+
+        Ice::ObjectPrxPtr wsProxy = wsCommunicator->stringToProxy("metrics:" + endpoint);
+        wsProxy->ice_ping();
+
+        //
+        // The response callback of the ping is called from a thread of
+        // the client thread pool, it queues the work items with its
+        // thread and waits for the other threads to steal them.
+        //
+        const int count = 20;
+        WorkStealingCallbackPtr wsCallback = new WorkStealingCallback(wsProxy, count);
+#ifdef ICE_CPP11_MAPPING
+        wsProxy->ice_pingAsync(
+            [wsCallback]()
+            {
+                wsCallback->response();
+            },
+            [](exception_ptr)
+            {
+                test(false);
+            });
+#else
+        wsProxy->begin_ice_ping(Ice::newCallback_Object_ice_ping(wsCallback, &WorkStealingCallback::response,
+                                                                 &WorkStealingCallback::exception));
+#endif
+        test(wsCallback->waitForCompleted());
+
+        IceMX::MetricsView wsView = wsMetrics->getMetricsView("View", timestamp);
+        test(wsView["ThreadPool"].size() == 1);
+        IceMX::ThreadPoolMetricsPtr tp = ICE_DYNAMIC_CAST(IceMX::ThreadPoolMetrics, wsView["ThreadPool"][0]);
+        test(tp->id == "Ice.ThreadPool.Client" && tp->current == 1 && tp->total == 1);
+        test(tp->stolen >= count && tp->queued >= tp->stolen);
+        test(tp->maxQueueDepth >= 1 && tp->queueDepth >= 0);
+
+        wsCommunicator->destroy();
+        cout << "ok" << endl;
+    }
+
     cout << "testing dispatch metrics... " << flush;
 
     props["IceMX.Metrics.View.Map.Dispatch.GroupBy"] = "operation";
@@ -1110,6 +1435,29 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "context.entry2", "", op);
     testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "context.entry3", "", op);
 
+    props["IceMX.Metrics.View.Map.Dispatch.Histogram"] = "1";
+    updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+    for(int i = 0; i < 10; ++i)
+    {
+        metrics->op();
+    }
+    map = toMap(serverMetrics->getMetricsView("View", timestamp)["Dispatch"]);
+    dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["op"]);
+    test(dm1->lifetimeHistogram);
+    {
+        Ice::Long count = 0;
+        Ice::Long upperBound = -1;
+        for(IceMX::Histogram::const_iterator p = dm1->lifetimeHistogram->begin();
+            p != dm1->lifetimeHistogram->end(); ++p)
+        {
+            test(p->upperBound > upperBound && p->count > 0);
+            upperBound = p->upperBound;
+            count += p->count;
+        }
+        test(count == dm1->total - dm1->current);
+    }
+    props.erase("IceMX.Metrics.View.Map.Dispatch.Histogram");
+
     cout << "ok" << endl;
 
     cout << "testing invocation metrics... " << flush;
@@ -1669,6 +2017,39 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     }
     cout << "ok" << endl;
 
+    int httpPort = communicator->getProperties()->getPropertyAsInt("IceMX.Http.Port");
+    if(httpPort > 0)
+    {
+        cout << "testing OpenMetrics HTTP endpoint... " << flush;
+
+        string response = httpRequest(host, httpPort, "GET /metrics HTTP/1.1\r\nHost: " + host + "\r\n\r\n");
+        test(response.find("HTTP/1.1 200 OK\r\n") == 0);
+        test(response.find("Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n") !=
+             string::npos);
+        test(response.find("Transfer-Encoding: chunked\r\n") != string::npos);
+        test(response.find("\n# TYPE icemx_invocation counter\n") != string::npos);
+        test(response.find("\nicemx_invocation_total{view=\"View\",id=\"") != string::npos);
+        test(response.find("\n# TYPE icemx_invocation_current gauge\n") != string::npos);
+        test(response.find("\n# TYPE icemx_invocation_remote_size_bytes counter\n") != string::npos);
+        test(response.find(",parent=\"") != string::npos);
+        test(response.size() > 12 && response.substr(response.size() - 13) == "# EOF\n\r\n0\r\n\r\n");
+
+        response = httpRequest(host, httpPort, "GET /metrics HTTP/1.0\r\n\r\n");
+        test(response.find("HTTP/1.1 200 OK\r\n") == 0);
+        test(response.find("Transfer-Encoding") == string::npos);
+        test(response.size() > 6 && response.substr(response.size() - 6) == "# EOF\n");
+
+        response = httpRequest(host, httpPort, "GET / HTTP/1.1\r\n\r\n");
+        test(response.find("HTTP/1.1 404 Not Found\r\n") == 0);
+
+        response = httpRequest(host, httpPort, "POST /metrics HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+        test(response.find("HTTP/1.1 405 Method Not Allowed\r\n") == 0);
+
+        response = httpRequest(host, httpPort, "\x01\x02 /metrics\r\n\r\n");
+        test(response.find("HTTP/1.1 400 Bad Request\r\n") == 0);
+        cout << "ok" << endl;
+    }
+
     cout << "testing metrics view enable/disable..." << flush;
 
     Ice::StringSeq disabledViews;
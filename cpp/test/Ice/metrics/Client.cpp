@@ -26,6 +26,10 @@ Client::run(int argc, char** argv)
     initData.properties->setProperty("Ice.Admin.InstanceName", "client");
     initData.properties->setProperty("Ice.Admin.DelayCreation", "1");
     initData.properties->setProperty("Ice.Warn.Connections", "0");
+    initData.properties->setProperty("IceMX.Http.Host", getTestHost(initData.properties));
+    ostringstream os;
+    os << getTestPort(initData.properties, 5);
+    initData.properties->setProperty("IceMX.Http.Port", os.str());
     CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI);
     initData.observer = observer;
     Ice::CommunicatorHolder communicator = initialize(argc, argv, initData);
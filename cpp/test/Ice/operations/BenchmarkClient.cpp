@@ -0,0 +1,142 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Benchmark.h>
+
+using namespace std;
+
+//
+// Compares collocated invocations that marshal their parameters with
+// collocated invocations on operations with the cpp:collocated-direct
+// metadata, which call the servant directly.
+//
+
+namespace
+{
+
+#ifdef ICE_CPP11_MAPPING
+typedef vector<Ice::Byte> ByteSeqParam;
+typedef Benchmark::Payload PayloadParam;
+#else
+typedef const Benchmark::ByteSeq& ByteSeqParam;
+typedef const Benchmark::Payload& PayloadParam;
+#endif
+
+class MarshaledI : public Benchmark::Marshaled
+{
+public:
+
+    virtual Ice::Int
+    opInt(Ice::Int p1, Ice::Int& p2, const Ice::Current&)
+    {
+        p2 = p1;
+        return p1;
+    }
+
+    virtual Benchmark::ByteSeq
+    opByteSeq(ByteSeqParam p1, const Ice::Current&)
+    {
+        return p1;
+    }
+
+    virtual Benchmark::Payload
+    opPayload(PayloadParam p1, Benchmark::Payload& p2, const Ice::Current&)
+    {
+        p2 = p1;
+        return p1;
+    }
+};
+
+class DirectI : public Benchmark::Direct
+{
+public:
+
+    virtual Ice::Int
+    opInt(Ice::Int p1, Ice::Int& p2, const Ice::Current&)
+    {
+        p2 = p1;
+        return p1;
+    }
+
+    virtual Benchmark::ByteSeq
+    opByteSeq(ByteSeqParam p1, const Ice::Current&)
+    {
+        return p1;
+    }
+
+    virtual Benchmark::Payload
+    opPayload(PayloadParam p1, Benchmark::Payload& p2, const Ice::Current&)
+    {
+        p2 = p1;
+        return p1;
+    }
+};
+
+template<typename Prx> void
+run(const string& name, const Prx& prx, int count)
+{
+    cout << name << ":" << endl;
+
+    Ice::Int out;
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(int i = 0; i < count; ++i)
+    {
+        prx->opInt(i, out);
+    }
+    IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+    cout << "  opInt:     " << elapsed.toMicroSecondsDouble() / count << "us per call" << endl;
+
+    Benchmark::ByteSeq seq(64 * 1024);
+    start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(int i = 0; i < count / 10; ++i)
+    {
+        prx->opByteSeq(seq);
+    }
+    elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+    cout << "  opByteSeq: " << elapsed.toMicroSecondsDouble() / (count / 10) << "us per call" << endl;
+
+    Benchmark::Payload payload;
+    payload.name = "payload";
+    payload.values.resize(20, "a collocated invocation value");
+    payload.data.resize(1024);
+    Benchmark::Payload payloadOut;
+    start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(int i = 0; i < count; ++i)
+    {
+        prx->opPayload(payload, payloadOut);
+    }
+    elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+    cout << "  opPayload: " << elapsed.toMicroSecondsDouble() / count << "us per call" << endl;
+}
+
+}
+
+class BenchmarkRunner : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+BenchmarkRunner::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    communicator->getProperties()->setProperty("BenchmarkAdapter.Endpoints", "tcp -h 127.0.0.1");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("BenchmarkAdapter");
+
+    Benchmark::MarshaledPrxPtr marshaled = ICE_UNCHECKED_CAST(Benchmark::MarshaledPrx,
+        adapter->add(ICE_MAKE_SHARED(MarshaledI), Ice::stringToIdentity("marshaled")));
+    Benchmark::DirectPrxPtr direct = ICE_UNCHECKED_CAST(Benchmark::DirectPrx,
+        adapter->add(ICE_MAKE_SHARED(DirectI), Ice::stringToIdentity("direct")));
+    adapter->activate();
+
+    const int count = 100000;
+    ::run("marshaled collocated invocations", marshaled, count);
+    ::run("direct collocated invocations", direct, count);
+}
+
+DEFINE_TEST(BenchmarkRunner)
@@ -2,6 +2,8 @@
 # Copyright (c) ZeroC, Inc. All rights reserved.
 #
 
+$(test)_programs = client server serveramd collocated benchmark
+
 $(test)_client_sources  = Test.ice \
                           Client.cpp \
                           AllTests.cpp \
@@ -12,6 +14,9 @@ $(test)_client_sources  = Test.ice \
                           BatchOneways.cpp \
                           BatchOnewaysAMI.cpp
 
+$(test)_benchmark_sources = Benchmark.ice \
+                            BenchmarkClient.cpp
+
 ifeq ($(xlc_compiler),yes)
     $(test)_cppflags += -qsuppress="1540-0895"
 endif
@@ -325,6 +325,14 @@ twoways(const Ice::CommunicatorPtr& communicator, Test::TestHelper* helper, cons
         r = p->opString("hello", "world", s);
         test(s == "world hello");
         test(r == "hello world");
+
+        //
+        // In parameter bound to the same variable as the out parameter.
+        //
+        s = "hello";
+        r = p->opString(s, "world", s);
+        test(s == "world hello");
+        test(r == "hello world");
     }
 
     {
@@ -2859,6 +2859,11 @@ allTests(Test::TestHelper* helper, const string& /*testDir*/, bool p12)
         try
         {
             server->ice_ping();
+
+            //
+            // A new connection to the same server uses the cached trust decision.
+            //
+            server->ice_connectionId("cached")->ice_ping();
         }
         catch(const LocalException& ex)
         {
@@ -2888,6 +2893,14 @@ allTests(Test::TestHelper* helper, const string& /*testDir*/, bool p12)
         catch(const LocalException&)
         {
         }
+        try
+        {
+            server->ice_connectionId("cached")->ice_ping();
+            test(false);
+        }
+        catch(const LocalException&)
+        {
+        }
         fact->destroyServer(server);
         comm->destroy();
     }
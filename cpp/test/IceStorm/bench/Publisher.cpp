@@ -0,0 +1,202 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/Options.h>
+#include <IceStorm/IceStorm.h>
+#include <Event.h>
+#include <TestHelper.h>
+#include <iomanip>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+namespace
+{
+
+//
+// Publishes the events of a publisher to each of the topics, the
+// publishers start publishing at the same time.
+//
+class PublisherThread : public IceUtil::Thread, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    PublisherThread(const vector<TopicPrx>& topics, int events, int size, const string& mode) :
+        _events(events), _payload(static_cast<size_t>(size)), _mode(mode), _started(false)
+    {
+        for(vector<TopicPrx>::const_iterator p = topics.begin(); p != topics.end(); ++p)
+        {
+            EventPrx publisher = EventPrx::uncheckedCast((*p)->getPublisher()->ice_twoway());
+            if(_mode == "oneway")
+            {
+                publisher = publisher->ice_oneway();
+            }
+            else if(_mode == "batch")
+            {
+                publisher = publisher->ice_batchOneway();
+            }
+            _publishers.push_back(publisher);
+        }
+    }
+
+    void start()
+    {
+        Lock sync(*this);
+        _started = true;
+        notifyAll();
+    }
+
+    virtual void run()
+    {
+        {
+            Lock sync(*this);
+            while(!_started)
+            {
+                wait();
+            }
+        }
+
+        pair<const Byte*, const Byte*> payload(&_payload[0], &_payload[0] + _payload.size());
+        for(int i = 0; i < _events; ++i)
+        {
+            for(vector<EventPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
+            {
+                (*p)->pub(IceUtil::Time::now(IceUtil::Time::Monotonic).toMicroSeconds(), payload);
+                if(_mode == "batch" && (i + 1) % 100 == 0)
+                {
+                    (*p)->ice_flushBatchRequests();
+                }
+            }
+        }
+
+        //
+        // Flush the batch requests and ping the publishers to make sure
+        // that all the oneway events are delivered to IceStorm.
+        //
+        for(vector<EventPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
+        {
+            if(_mode == "batch")
+            {
+                (*p)->ice_flushBatchRequests();
+            }
+            if(_mode != "twoway")
+            {
+                (*p)->ice_twoway()->ice_ping();
+            }
+        }
+    }
+
+private:
+
+    const int _events;
+    const ByteSeq _payload;
+    const string _mode;
+    vector<EventPrx> _publishers;
+    bool _started;
+};
+typedef IceUtil::Handle<PublisherThread> PublisherThreadPtr;
+
+}
+
+class Publisher : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Publisher::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    IceUtilInternal::Options opts;
+    opts.addOpt("", "topics", IceUtilInternal::Options::NeedArg, "1");
+    opts.addOpt("", "publishers", IceUtilInternal::Options::NeedArg, "1");
+    opts.addOpt("", "events", IceUtilInternal::Options::NeedArg, "1000");
+    opts.addOpt("", "size", IceUtilInternal::Options::NeedArg, "100");
+    opts.addOpt("", "oneway");
+    opts.addOpt("", "batch");
+
+    try
+    {
+        opts.parse(argc, (const char**)argv);
+    }
+    catch(const IceUtilInternal::BadOptException& e)
+    {
+        ostringstream os;
+        os << argv[0] << ": error: " << e.reason;
+        throw invalid_argument(os.str());
+    }
+
+    int topics = atoi(opts.optArg("topics").c_str());
+    int publishers = atoi(opts.optArg("publishers").c_str());
+    int events = atoi(opts.optArg("events").c_str());
+    int size = atoi(opts.optArg("size").c_str());
+    if(topics <= 0 || publishers <= 0 || events <= 0 || size <= 0)
+    {
+        ostringstream os;
+        os << argv[0] << ": topics, publishers, events and size must be > 0.";
+        throw invalid_argument(os.str());
+    }
+    string mode = opts.isSet("batch") ? "batch" : (opts.isSet("oneway") ? "oneway" : "twoway");
+
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        ostringstream os;
+        os << argv[0] << ": property `" << managerProxyProperty << "' is not set";
+        throw invalid_argument(os.str());
+    }
+
+    IceStorm::TopicManagerPrx manager = IceStorm::TopicManagerPrx::checkedCast(
+        communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        ostringstream os;
+        os << argv[0] << ": `" << managerProxy << "' is not running";
+        throw invalid_argument(os.str());
+    }
+
+    vector<TopicPrx> topicPrxs;
+    for(int i = 0; i < topics; ++i)
+    {
+        ostringstream os;
+        os << "bench" << i;
+        topicPrxs.push_back(manager->retrieve(os.str()));
+    }
+
+    vector<PublisherThreadPtr> threads;
+    for(int i = 0; i < publishers; ++i)
+    {
+        threads.push_back(new PublisherThread(topicPrxs, events, size, mode));
+    }
+    vector<IceUtil::ThreadControl> controls;
+    for(vector<PublisherThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        controls.push_back((*p)->IceUtil::Thread::start());
+    }
+
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(vector<PublisherThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->start();
+    }
+    for(vector<IceUtil::ThreadControl>::iterator p = controls.begin(); p != controls.end(); ++p)
+    {
+        p->join();
+    }
+    IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    Ice::Long total = static_cast<Ice::Long>(events) * publishers * topics;
+    cout << "published " << total << " " << mode << " events of " << size << " bytes in " << fixed
+         << setprecision(3) << elapsed.toSecondsDouble() << "s: " << setprecision(0)
+         << total / elapsed.toSecondsDouble() << " events/s" << endl;
+}
+
+DEFINE_TEST(Publisher)
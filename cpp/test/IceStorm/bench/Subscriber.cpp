@@ -0,0 +1,313 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <IceUtil/Options.h>
+#include <IceUtil/Monitor.h>
+#include <Event.h>
+#include <TestHelper.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+namespace
+{
+
+//
+// The statistics of all the subscribers. The latency is the time
+// between the publishing of an event and its reception, the publisher
+// and the subscriber must run on the same host to share the monotonic
+// clock.
+//
+class Stats : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    Stats(int subscribers) : _subscribers(subscribers), _completed(0)
+    {
+    }
+
+    void completed(const vector<Ice::Long>& latencies, const IceUtil::Time& first, const IceUtil::Time& last)
+    {
+        Lock sync(*this);
+        _latencies.insert(_latencies.end(), latencies.begin(), latencies.end());
+        if(_completed == 0 || first < _first)
+        {
+            _first = first;
+        }
+        if(_completed == 0 || last > _last)
+        {
+            _last = last;
+        }
+        if(++_completed == _subscribers)
+        {
+            notifyAll();
+        }
+    }
+
+    bool waitForCompletion(const IceUtil::Time& timeout)
+    {
+        IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + timeout;
+        Lock sync(*this);
+        while(_completed < _subscribers)
+        {
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            if(now >= end || !timedWait(end - now))
+            {
+                return _completed == _subscribers;
+            }
+        }
+        return true;
+    }
+
+    string report()
+    {
+        Lock sync(*this);
+        sort(_latencies.begin(), _latencies.end());
+        double elapsed = max((_last - _first).toSecondsDouble(), 0.000001);
+
+        ostringstream os;
+        os << "received " << _latencies.size() << " events in " << fixed << setprecision(3) << elapsed << "s: "
+           << setprecision(0) << _latencies.size() / elapsed << " events/s, latency (us): min "
+           << percentile(0) << ", 50% " << percentile(0.5) << ", 90% " << percentile(0.9) << ", 99% "
+           << percentile(0.99) << ", 99.9% " << percentile(0.999) << ", max " << percentile(1);
+        return os.str();
+    }
+
+private:
+
+    Ice::Long percentile(double p) const
+    {
+        if(_latencies.empty())
+        {
+            return 0;
+        }
+        size_t rank = static_cast<size_t>(ceil(p * static_cast<double>(_latencies.size())));
+        return _latencies[rank > 0 ? min(rank, _latencies.size()) - 1 : 0];
+    }
+
+    const int _subscribers;
+    int _completed;
+    vector<Ice::Long> _latencies;
+    IceUtil::Time _first;
+    IceUtil::Time _last;
+};
+typedef IceUtil::Handle<Stats> StatsPtr;
+
+class EventI : public Event, private IceUtil::Mutex
+{
+public:
+
+    EventI(const StatsPtr& stats, int total) : _stats(stats), _total(total), _count(0)
+    {
+        _latencies.reserve(static_cast<size_t>(total));
+    }
+
+    virtual void
+    pub(Ice::Long time, const pair<const Byte*, const Byte*>&, const Ice::Current&)
+    {
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
+        Lock sync(*this);
+        if(_count >= _total)
+        {
+            return;
+        }
+        if(_count == 0)
+        {
+            _first = now;
+        }
+        _latencies.push_back(now.toMicroSeconds() - time);
+        if(++_count == _total)
+        {
+            _stats->completed(_latencies, _first, now);
+        }
+    }
+
+    int count() const
+    {
+        Lock sync(*this);
+        return _count;
+    }
+
+private:
+
+    const StatsPtr _stats;
+    const int _total;
+    int _count;
+    vector<Ice::Long> _latencies;
+    IceUtil::Time _first;
+};
+typedef IceUtil::Handle<EventI> EventIPtr;
+
+struct Subscription
+{
+    TopicPrx topic;
+    Ice::ObjectPrx obj;
+    EventIPtr servant;
+};
+
+}
+
+class Subscriber : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Subscriber::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    IceUtilInternal::Options opts;
+    opts.addOpt("", "topics", IceUtilInternal::Options::NeedArg, "1");
+    opts.addOpt("", "subscribers", IceUtilInternal::Options::NeedArg, "1");
+    opts.addOpt("", "events", IceUtilInternal::Options::NeedArg, "1000");
+    opts.addOpt("", "timeout", IceUtilInternal::Options::NeedArg, "120");
+    opts.addOpt("", "qos", IceUtilInternal::Options::NeedArg, "", IceUtilInternal::Options::Repeat);
+
+    try
+    {
+        opts.parse(argc, (const char**)argv);
+    }
+    catch(const IceUtilInternal::BadOptException& e)
+    {
+        ostringstream os;
+        os << argv[0] << ": error: " << e.reason;
+        throw invalid_argument(os.str());
+    }
+
+    int topics = atoi(opts.optArg("topics").c_str());
+    int subscribers = atoi(opts.optArg("subscribers").c_str());
+    int events = atoi(opts.optArg("events").c_str());
+    int timeout = atoi(opts.optArg("timeout").c_str());
+    if(topics <= 0 || subscribers <= 0 || events <= 0 || timeout <= 0)
+    {
+        ostringstream os;
+        os << argv[0] << ": topics, subscribers, events and timeout must be > 0.";
+        throw invalid_argument(os.str());
+    }
+
+    //
+    // The reliability QoS selects the subscriber proxy mode, the other
+    // QoS settings are passed to IceStorm.
+    //
+    IceStorm::QoS qos;
+    string reliability = "oneway";
+    vector<string> sqos = opts.argVec("qos");
+    for(vector<string>::const_iterator q = sqos.begin(); q != sqos.end(); ++q)
+    {
+        string::size_type off = q->find(",");
+        if(off == string::npos)
+        {
+            ostringstream os;
+            os << argv[0] << ": parse error: no , in QoS";
+            throw invalid_argument(os.str());
+        }
+        if(q->substr(0, off) == "reliability")
+        {
+            reliability = q->substr(off + 1);
+        }
+        else
+        {
+            qos[q->substr(0, off)] = q->substr(off + 1);
+        }
+    }
+    if(reliability == "ordered")
+    {
+        qos["reliability"] = "ordered";
+    }
+    else if(reliability != "oneway" && reliability != "twoway" && reliability != "batch")
+    {
+        ostringstream os;
+        os << argv[0] << ": invalid reliability: " << reliability;
+        throw invalid_argument(os.str());
+    }
+
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        ostringstream os;
+        os << argv[0] << ": property `" << managerProxyProperty << "' is not set";
+        throw invalid_argument(os.str());
+    }
+
+    IceStorm::TopicManagerPrx manager = IceStorm::TopicManagerPrx::checkedCast(
+        communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        ostringstream os;
+        os << argv[0] << ": `" << managerProxy << "' is not running";
+        throw invalid_argument(os.str());
+    }
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", "default");
+    StatsPtr stats = new Stats(topics * subscribers);
+    vector<Subscription> subs;
+    for(int i = 0; i < topics; ++i)
+    {
+        ostringstream os;
+        os << "bench" << i;
+        TopicPrx topic;
+        try
+        {
+            topic = manager->retrieve(os.str());
+        }
+        catch(const NoSuchTopic&)
+        {
+            topic = manager->create(os.str());
+        }
+
+        for(int j = 0; j < subscribers; ++j)
+        {
+            Subscription item;
+            item.topic = topic;
+            item.servant = new EventI(stats, events);
+            item.obj = adapter->addWithUUID(item.servant);
+            if(reliability == "oneway")
+            {
+                item.obj = item.obj->ice_oneway();
+            }
+            else if(reliability == "batch")
+            {
+                item.obj = item.obj->ice_batchOneway();
+            }
+            topic->subscribeAndGetPublisher(qos, item.obj);
+            subs.push_back(item);
+        }
+    }
+    adapter->activate();
+
+    bool completed = stats->waitForCompletion(IceUtil::Time::seconds(timeout));
+
+    for(vector<Subscription>::const_iterator p = subs.begin(); p != subs.end(); ++p)
+    {
+        p->topic->unsubscribe(p->obj);
+    }
+
+    if(!completed)
+    {
+        ostringstream os;
+        os << "timed out waiting for events, received:";
+        for(vector<Subscription>::const_iterator p = subs.begin(); p != subs.end(); ++p)
+        {
+            os << " " << p->servant->count();
+        }
+        os << " expected: " << events;
+        throw invalid_argument(os.str());
+    }
+
+    cout << stats->report() << endl;
+}
+
+DEFINE_TEST(Subscriber)
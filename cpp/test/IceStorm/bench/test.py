@@ -0,0 +1,80 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# Throughput and latency benchmark. Each run starts a subscriber process
+# with the given number of subscribers per topic and a publisher process
+# with the given number of publisher threads, the publisher reports the
+# publishing rate and the subscriber the receiving rate and the latency
+# percentiles.
+#
+# The runs below are kept small to run with the test suite. The events,
+# size and subscribers of each run can be overridden with the
+# BENCH_OPTIONS environment variable, for example:
+#
+#   BENCH_OPTIONS="--events 20000 --size 4096" python allTests.py --filter IceStorm/bench
+#
+import os, shlex
+
+class IceStormBenchTestCase(IceStormTestCase):
+
+    def runClientSide(self, current):
+
+        overrides = {}
+        args = shlex.split(os.environ.get("BENCH_OPTIONS", ""))
+        for (name, value) in zip(args[::2], args[1::2]):
+            overrides[name.lstrip("-")] = int(value)
+
+        def bench(desc, topics=1, publishers=1, subscribers=1, events=1000, size=100, qos=[], oneway=False,
+                  batch=False):
+            subscribers = overrides.get("subscribers", subscribers)
+            events = overrides.get("events", events)
+            size = overrides.get("size", size)
+
+            current.writeln("{0}: {1} topic(s), {2} publisher(s), {3} subscriber(s) per topic, {4} events of "
+                            "{5} bytes".format(desc, topics, publishers, subscribers, events, size))
+
+            subArgs = ["--topics", topics, "--subscribers", subscribers, "--events", events * publishers]
+            for q in qos:
+                subArgs += ["--qos", q]
+            subscriber = Subscriber(args=subArgs, quiet=True)
+            subscriber.start(current)
+
+            pubArgs = ["--topics", topics, "--publishers", publishers, "--events", events, "--size", size]
+            if oneway:
+                pubArgs.append("--oneway")
+            if batch:
+                pubArgs.append("--batch")
+            publisher = Publisher(args=pubArgs, quiet=True)
+            publisher.start(current)
+            publisher.expect(current, "(published [^\n]+)\n", timeout=300)
+            current.writeln("  " + publisher.getMatch(current).group(1))
+            publisher.stop(current, True)
+
+            subscriber.expect(current, "(received [^\n]+)\n", timeout=300)
+            current.writeln("  " + subscriber.getMatch(current).group(1))
+            subscriber.stop(current, True)
+
+        bench("oneway subscriber", oneway=True)
+        bench("twoway subscriber", qos=["reliability,twoway"])
+        bench("ordered subscriber", qos=["reliability,ordered"])
+        bench("batch subscriber", qos=["reliability,batch"], oneway=True)
+        bench("large events", size=64 * 1024, events=200, oneway=True)
+        bench("fan-out", subscribers=20, events=500, oneway=True)
+        bench("fan-in", publishers=4, events=500, oneway=True)
+        bench("topics", topics=10, events=200, oneway=True)
+        bench("twoway publisher", events=500)
+        bench("batch publisher", batch=True)
+
+TestSuite(__file__, [
+
+    IceStormBenchTestCase("persistent", icestorm=IceStorm(quiet=True)),
+
+    IceStormBenchTestCase("transient", icestorm=IceStorm(transient=True, quiet=True)),
+
+    IceStormBenchTestCase("replicated with replicated publisher", icestorm=
+                          [IceStorm(replica=i, nreplicas=3, quiet=True) for i in range(0,3)]),
+
+], multihost=False, runOnMainThread=True)
@@ -0,0 +1,198 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <IceUtil/Monitor.h>
+#include <Test.h>
+#include <TestHelper.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+namespace
+{
+
+class EventI : public Event, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual void
+    pub(int value, const Current& current)
+    {
+        Lock sync(*this);
+
+        //
+        // The events from the event log carry their offset, the offset
+        // of the events published on a new topic is their value.
+        //
+        Context::const_iterator p = current.ctx.find("IceStorm.Offset");
+        if(p != current.ctx.end())
+        {
+            ostringstream os;
+            os << value;
+            test(p->second == os.str());
+        }
+        _values.push_back(value);
+        notifyAll();
+    }
+
+    vector<int>
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_values.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(30)))
+            {
+                cerr << "received " << _values.size() << " events, expected " << count << endl;
+                test(false);
+            }
+        }
+        return _values;
+    }
+
+private:
+
+    vector<int> _values;
+};
+typedef IceUtil::Handle<EventI> EventIPtr;
+
+class PublisherThread : public IceUtil::Thread
+{
+public:
+
+    PublisherThread(const EventPrx& publisher, int first, int last) :
+        _publisher(publisher), _first(first), _last(last)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        for(int i = _first; i < _last; ++i)
+        {
+            _publisher->pub(i);
+        }
+    }
+
+private:
+
+    const EventPrx _publisher;
+    const int _first;
+    const int _last;
+};
+typedef IceUtil::Handle<PublisherThread> PublisherThreadPtr;
+
+void
+testRange(const vector<int>& values, int first, int last)
+{
+    test(values.size() == static_cast<size_t>(last - first));
+    for(int i = first; i < last; ++i)
+    {
+        test(values[static_cast<size_t>(i - first)] == i);
+    }
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    PropertiesPtr properties = communicator->getProperties();
+    string managerProxy = properties->getProperty("IceStormAdmin.TopicManager.Default");
+    if(managerProxy.empty())
+    {
+        ostringstream os;
+        os << argv[0] << ": property `IceStormAdmin.TopicManager.Default' is not set";
+        throw invalid_argument(os.str());
+    }
+
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        ostringstream os;
+        os << argv[0] << ": `" << managerProxy << "' is not running";
+        throw invalid_argument(os.str());
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", "default");
+    adapter->activate();
+
+    cout << "testing event log replay... " << flush;
+    {
+        TopicPrx topic = manager->create("replay");
+        EventPrx publisher = EventPrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+        for(int i = 0; i < 2500; ++i)
+        {
+            publisher->pub(i);
+        }
+
+        //
+        // The events published during the replay are received once,
+        // after the replayed events.
+        //
+        IceStorm::QoS qos;
+        qos["reliability"] = "ordered";
+        qos["replayFrom"] = "0";
+        EventIPtr replayAll = new EventI();
+        ObjectPrx replayAllPrx = adapter->addWithUUID(replayAll);
+        PublisherThreadPtr thread = new PublisherThread(publisher, 2500, 5000);
+        IceUtil::ThreadControl control = thread->start();
+        topic->subscribeAndGetPublisher(qos, replayAllPrx);
+        control.join();
+        testRange(replayAll->waitForEvents(5000), 0, 5000);
+
+        qos["replayFrom"] = "4000";
+        EventIPtr replayLast = new EventI();
+        ObjectPrx replayLastPrx = adapter->addWithUUID(replayLast);
+        topic->subscribeAndGetPublisher(qos, replayLastPrx);
+        testRange(replayLast->waitForEvents(1000), 4000, 5000);
+
+        //
+        // Once the replay completed, the subscribers receive the
+        // published events.
+        //
+        publisher->pub(5000);
+        testRange(replayAll->waitForEvents(5001), 0, 5001);
+        testRange(replayLast->waitForEvents(1001), 4000, 5001);
+
+        try
+        {
+            qos["replayFrom"] = "-1";
+            topic->subscribeAndGetPublisher(qos, adapter->addWithUUID(new EventI()));
+            test(false);
+        }
+        catch(const BadQoS&)
+        {
+        }
+
+        try
+        {
+            qos["replayFrom"] = "first";
+            topic->subscribeAndGetPublisher(qos, adapter->addWithUUID(new EventI()));
+            test(false);
+        }
+        catch(const BadQoS&)
+        {
+        }
+
+        topic->unsubscribe(replayAllPrx);
+        topic->unsubscribe(replayLastPrx);
+        topic->destroy();
+    }
+    cout << "ok" << endl;
+}
+
+DEFINE_TEST(Client)
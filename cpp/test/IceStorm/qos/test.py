@@ -0,0 +1,47 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+import os, shutil
+
+#
+# IceStorm with the topic event log enabled, the event log directory is
+# created and removed with the database directory.
+#
+class EventLogIceStorm(IceStorm):
+
+    def setup(self, current):
+        IceStorm.setup(self, current)
+        self.eventLogDir = os.path.join(current.testsuite.getPath(), "{0}.eventlog".format(self.instanceName))
+        if os.path.exists(self.eventLogDir):
+            shutil.rmtree(self.eventLogDir)
+        os.mkdir(self.eventLogDir)
+
+    def teardown(self, current, success):
+        IceStorm.teardown(self, current, success)
+        shutil.rmtree(self.eventLogDir, ignore_errors=True)
+
+    def getProps(self, current):
+        props = IceStorm.getProps(self, current)
+        props["IceStorm.EventLog.Path"] = "{testdir}/{process.instanceName}.eventlog"
+        return props
+
+class QoSClient(IceStormProcess, Client):
+
+    def __init__(self, instanceName=None, instance=None, *args, **kargs):
+        Client.__init__(self, *args, **kargs)
+        IceStormProcess.__init__(self, instanceName, instance)
+
+    getParentProps = Client.getProps # Used by IceStormProcess to get the client properties
+
+class IceStormQoSTestCase(IceStormTestCase):
+
+    def teardownClientSide(self, current, success):
+        self.shutdown(current)
+
+TestSuite(__file__, [
+    IceStormQoSTestCase("persistent", icestorm=EventLogIceStorm(), client=ClientTestCase(client=QoSClient())),
+    IceStormQoSTestCase("synced event log", icestorm=EventLogIceStorm(props={ "IceStorm.EventLog.Sync" : "Append" }),
+                        client=ClientTestCase(client=QoSClient())),
+], multihost=False)
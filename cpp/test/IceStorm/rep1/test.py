@@ -18,6 +18,14 @@ props = {
 
 icestorm = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
 
+#
+# Without the update log, the replicas are always initialized with the
+# full topic content.
+#
+noLogProps = dict(props)
+noLogProps["IceStorm.Replication.LogSize"] = 0
+icestormNoLog = [ IceStorm(replica=i, nreplicas=3, props = noLogProps) for i in range(0,3) ]
+
 class IceStormRep1TestCase(IceStormTestCase):
 
     def runClientSide(self, current):
@@ -282,4 +290,7 @@ class IceStormRep1TestCase(IceStormTestCase):
         self.stopIceStorm(current)
         current.writeln("ok")
 
-TestSuite(__file__, [ IceStormRep1TestCase("replicated", icestorm=icestorm) ], multihost=False)
+TestSuite(__file__, [
+    IceStormRep1TestCase("replicated", icestorm=icestorm),
+    IceStormRep1TestCase("replicated without update log", icestorm=icestormNoLog),
+], multihost=False)
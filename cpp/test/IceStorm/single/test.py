@@ -13,22 +13,51 @@
 props = { "Ice.UDP.SndSize" : 512 * 1024, "Ice.Warn.Dispatch" : 0 }
 persistent = IceStorm(props = props)
 transient = IceStorm(props = props, transient=True)
+fanout = IceStorm(props = dict(props, **{ "IceStorm.FanOut.Threads" : 2, "IceStorm.FanOut.PartitionSize" : 1 }))
 replicated = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
 
+#
+# Two IceStorm shards, the subscriber and publisher use the topic manager of
+# a different shard and the topic manager that doesn't own the topic forwards
+# its retrieval to the other shard.
+#
+class ShardedIceStorm(IceStorm):
+
+    def __init__(self, *args, **kargs):
+        IceStorm.__init__(self, *args, **kargs)
+        self.shards = []
+
+    def getProps(self, current):
+        props = IceStorm.getProps(self, current)
+        props["IceStorm.Shard.Name"] = self.instanceName
+        for shard in self.shards:
+            if shard != self:
+                props["IceStorm.Shards.{0}".format(shard.instanceName)] = shard.getTopicManager(current)
+        return props
+
+sharded = [ ShardedIceStorm(props = props), ShardedIceStorm("IceStorm2", portnum=20, props = props) ]
+for shard in sharded:
+    shard.shards = sharded
+
 sub = Subscriber(args=["{testcase.parent.name}"], props = { "Ice.UDP.RcvSize" : 1024 * 1024 }, readyCount=3)
 pub = Publisher(args=["{testcase.parent.name}"])
+shardedSub = Subscriber(instance=sharded[0], args=["{testcase.parent.name}"], props = { "Ice.UDP.RcvSize" : 1024 * 1024 },
+                        readyCount=3)
+shardedPub = Publisher(instance=sharded[1], args=["{testcase.parent.name}"])
 
 class IceStormSingleTestCase(IceStormTestCase):
 
     def setupClientSide(self, current):
-        self.runadmin(current, "create single")
+        self.runadmin(current, "create single", instanceName=self.icestorm[0].getInstanceName())
 
     def teardownClientSide(self, current, success):
-        self.runadmin(current, "destroy single")
+        self.runadmin(current, "destroy single", instanceName=self.icestorm[0].getInstanceName())
         self.shutdown(current)
 
 TestSuite(__file__, [
     IceStormSingleTestCase("persistent", icestorm=persistent, client=ClientServerTestCase(client=pub, server=sub)),
     IceStormSingleTestCase("transient", icestorm=transient, client=ClientServerTestCase(client=pub, server=sub)),
+    IceStormSingleTestCase("parallel fan-out", icestorm=fanout, client=ClientServerTestCase(client=pub, server=sub)),
     IceStormSingleTestCase("replicated", icestorm=replicated, client=ClientServerTestCase(client=pub, server=sub)),
+    IceStormSingleTestCase("sharded", icestorm=sharded, client=ClientServerTestCase(client=shardedPub, server=shardedSub)),
 ], multihost=False)
@@ -0,0 +1,166 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceUtil/Timer.h>
+#include <IceUtil/Random.h>
+#include <TestHelper.h>
+
+#include <vector>
+
+using namespace std;
+
+//
+// Compares the scheduling and cancellation costs of the ordered set timer
+// and of the timing wheel timer. This simulates invocation timeouts: the
+// tasks are scheduled with a delay of a few seconds and are canceled
+// before they run.
+//
+
+namespace
+{
+
+class NoopTask : public IceUtil::TimerTask
+{
+public:
+
+    virtual void
+    runTimerTask()
+    {
+    }
+};
+
+class ScheduleCancelThread : public IceUtil::Thread
+{
+public:
+
+    ScheduleCancelThread(const IceUtil::TimerPtr& timer, int count) : _timer(timer), _count(count)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        vector<IceUtil::TimerTaskPtr> tasks;
+        for(int i = 0; i < 100; ++i)
+        {
+            tasks.push_back(ICE_MAKE_SHARED(NoopTask));
+        }
+        for(int i = 0; i < _count; ++i)
+        {
+            const IceUtil::TimerTaskPtr& task = tasks[static_cast<size_t>(i) % tasks.size()];
+            if(i >= static_cast<int>(tasks.size()))
+            {
+                _timer->cancel(task);
+            }
+            _timer->schedule(task, IceUtil::Time::milliSeconds(1000 + IceUtilInternal::random(4000)));
+        }
+        for(vector<IceUtil::TimerTaskPtr>::const_iterator p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            _timer->cancel(*p);
+        }
+    }
+
+private:
+
+    const IceUtil::TimerPtr _timer;
+    const int _count;
+};
+typedef IceUtil::Handle<ScheduleCancelThread> ScheduleCancelThreadPtr;
+
+void
+benchmark(const string& name, const IceUtil::TimerPtr& timer, int count, int threadCount)
+{
+    cout << name << ":" << endl;
+
+    //
+    // Schedule and cancel a large number of pending tasks.
+    //
+    vector<IceUtil::TimerTaskPtr> tasks;
+    for(int i = 0; i < count; ++i)
+    {
+        tasks.push_back(ICE_MAKE_SHARED(NoopTask));
+    }
+
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(vector<IceUtil::TimerTaskPtr>::const_iterator p = tasks.begin(); p != tasks.end(); ++p)
+    {
+        timer->schedule(*p, IceUtil::Time::milliSeconds(1000 + IceUtilInternal::random(4000)));
+    }
+    IceUtil::Time scheduleTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(vector<IceUtil::TimerTaskPtr>::const_iterator p = tasks.begin(); p != tasks.end(); ++p)
+    {
+        timer->cancel(*p);
+    }
+    IceUtil::Time cancelTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    cout << "  schedule " << count << " tasks: " << scheduleTime.toMicroSecondsDouble() * 1000 / count
+         << "ns/task" << endl;
+    cout << "  cancel " << count << " tasks: " << cancelTime.toMicroSecondsDouble() * 1000 / count
+         << "ns/task" << endl;
+
+    //
+    // Schedule and cancel tasks concurrently from several threads while
+    // a large number of tasks are pending.
+    //
+    for(vector<IceUtil::TimerTaskPtr>::const_iterator p = tasks.begin(); p != tasks.end(); ++p)
+    {
+        timer->schedule(*p, IceUtil::Time::seconds(60));
+    }
+
+    vector<ScheduleCancelThreadPtr> threads;
+    start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(int i = 0; i < threadCount; ++i)
+    {
+        threads.push_back(new ScheduleCancelThread(timer, count));
+        threads.back()->start();
+    }
+    for(vector<ScheduleCancelThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    IceUtil::Time concurrentTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    cout << "  schedule/cancel with " << threadCount << " threads and " << count << " pending tasks: "
+         << concurrentTime.toMicroSecondsDouble() * 1000 / (static_cast<double>(count) * threadCount)
+         << "ns/operation" << endl;
+
+    timer->destroy();
+}
+
+}
+
+class Benchmark : public Test::TestHelper
+{
+public:
+
+    void run(int argc, char* argv[]);
+};
+
+void
+Benchmark::run(int argc, char* argv[])
+{
+    int count = 100000;
+    int threadCount = 4;
+    if(argc > 1)
+    {
+        count = atoi(argv[1]);
+    }
+    if(argc > 2)
+    {
+        threadCount = atoi(argv[2]);
+    }
+    if(count <= 0 || threadCount <= 0)
+    {
+        cerr << "usage: " << argv[0] << " [tasks] [threads]" << endl;
+        throw std::invalid_argument("invalid arguments");
+    }
+
+    benchmark("ordered set timer", new IceUtil::Timer(), count, threadCount);
+    benchmark("timing wheel timer (1ms resolution)", new IceUtil::Timer(IceUtil::Time::milliSeconds(1)), count,
+              threadCount);
+}
+
+DEFINE_TEST(Benchmark)
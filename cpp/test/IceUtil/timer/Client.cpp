@@ -147,6 +147,93 @@ private:
 };
 ICE_DEFINE_PTR(DestroyTaskPtr, DestroyTask);
 
+void
+testTimer(const IceUtil::TimerPtr& timer)
+{
+    {
+        TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
+        timer->schedule(task, IceUtil::Time());
+        task->waitForRun();
+        task->clear();
+
+        //
+        // Verify that the same task cannot be scheduled more than once.
+        //
+        timer->schedule(task, IceUtil::Time::milliSeconds(100));
+        try
+        {
+            timer->schedule(task, IceUtil::Time());
+        }
+        catch(const IceUtil::IllegalArgumentException&)
+        {
+            // Expected.
+        }
+        task->waitForRun();
+        task->clear();
+    }
+
+    {
+        TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
+        test(!timer->cancel(task));
+        timer->schedule(task, IceUtil::Time::seconds(1));
+        test(!task->hasRun() && timer->cancel(task) && !task->hasRun());
+        test(!timer->cancel(task));
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1100));
+        test(!task->hasRun());
+    }
+
+    {
+        vector<TestTaskPtr> tasks;
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(500);
+        for(int i = 0; i < 20; ++i)
+        {
+            tasks.push_back(ICE_MAKE_SHARED(TestTask, IceUtil::Time::milliSeconds(500 + i * 50)));
+        }
+
+        IceUtilInternal::shuffle(tasks.begin(), tasks.end());
+        vector<TestTaskPtr>::const_iterator p;
+        for(p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            timer->schedule(*p, (*p)->getScheduledTime());
+        }
+
+        for(p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            (*p)->waitForRun();
+        }
+
+        test(IceUtil::Time::now(IceUtil::Time::Monotonic) > start);
+
+#ifdef ICE_CPP11_MAPPING
+        sort(tasks.begin(), tasks.end(), TargetLess<shared_ptr<TestTask>>());
+#else
+        sort(tasks.begin(), tasks.end());
+#endif
+        for(p = tasks.begin(); p + 1 != tasks.end(); ++p)
+        {
+            if((*p)->getRunTime() > (*(p + 1))->getRunTime())
+            {
+                test(false);
+            }
+        }
+    }
+
+    {
+        TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
+        timer->scheduleRepeated(task, IceUtil::Time::milliSeconds(20));
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+        test(task->hasRun());
+        test(task->getCount() > 1);
+        test(task->getCount() < 26);
+        test(timer->cancel(task));
+        int count = task->getCount();
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        test(count == task->getCount() || count + 1 == task->getCount());
+    }
+
+    timer->destroy();
+}
+
 class Client : public Test::TestHelper
 {
 public:
@@ -159,91 +246,87 @@ void
 Client::run(int, char*[])
 {
     cout << "testing timer... " << flush;
+    testTimer(new IceUtil::Timer());
+    cout << "ok" << endl;
+
+    cout << "testing timing wheel timer... " << flush;
     {
-        IceUtil::TimerPtr timer = new IceUtil::Timer();
+        testTimer(new IceUtil::Timer(IceUtil::Time::milliSeconds(5)));
 
-        {
-            TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
-            timer->schedule(task, IceUtil::Time());
-            task->waitForRun();
-            task->clear();
+        IceUtil::TimerPtr timer = new IceUtil::Timer(IceUtil::Time::milliSeconds(1));
 
-            //
-            // Verify that the same task cannot be scheduled more than once.
-            //
-            timer->schedule(task, IceUtil::Time::milliSeconds(100));
-            try
-            {
-                timer->schedule(task, IceUtil::Time());
-            }
-            catch(const IceUtil::IllegalArgumentException&)
-            {
-                // Expected.
-            }
-            task->waitForRun();
-            task->clear();
+        //
+        // Tasks scheduled beyond the range of the lower levels of the wheel.
+        //
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        vector<TestTaskPtr> tasks;
+        for(int i = 0; i < 10; ++i)
+        {
+            tasks.push_back(ICE_MAKE_SHARED(TestTask, IceUtil::Time::milliSeconds(i * 100)));
+            timer->schedule(tasks.back(), tasks.back()->getScheduledTime());
         }
 
+        //
+        // Canceled tasks don't run.
+        //
+        vector<TestTaskPtr> canceled;
+        for(int i = 0; i < 1000; ++i)
         {
-            TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
-            test(!timer->cancel(task));
-            timer->schedule(task, IceUtil::Time::seconds(1));
-            test(!task->hasRun() && timer->cancel(task) && !task->hasRun());
-            test(!timer->cancel(task));
-            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1100));
-            test(!task->hasRun());
+            canceled.push_back(ICE_MAKE_SHARED(TestTask));
+            timer->schedule(canceled.back(), IceUtil::Time::milliSeconds(1000 + IceUtilInternal::random(1000)));
         }
-
+        for(vector<TestTaskPtr>::const_iterator p = canceled.begin(); p != canceled.end(); ++p)
         {
-            vector<TestTaskPtr> tasks;
-            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(500);
-            for(int i = 0; i < 20; ++i)
-            {
-                tasks.push_back(ICE_MAKE_SHARED(TestTask, IceUtil::Time::milliSeconds(500 + i * 50)));
-            }
-
-            IceUtilInternal::shuffle(tasks.begin(), tasks.end());
-            vector<TestTaskPtr>::const_iterator p;
-            for(p = tasks.begin(); p != tasks.end(); ++p)
-            {
-                timer->schedule(*p, (*p)->getScheduledTime());
-            }
-
-            for(p = tasks.begin(); p != tasks.end(); ++p)
-            {
-                (*p)->waitForRun();
-            }
-
-            test(IceUtil::Time::now(IceUtil::Time::Monotonic) > start);
-
-#ifdef ICE_CPP11_MAPPING
-            sort(tasks.begin(), tasks.end(), TargetLess<shared_ptr<TestTask>>());
-#else
-            sort(tasks.begin(), tasks.end());
-#endif
-            for(p = tasks.begin(); p + 1 != tasks.end(); ++p)
-            {
-                if((*p)->getRunTime() > (*(p + 1))->getRunTime())
-                {
-                    test(false);
-                }
-            }
+            test(timer->cancel(*p));
         }
 
+        for(vector<TestTaskPtr>::const_iterator p = tasks.begin(); p != tasks.end(); ++p)
         {
-            TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
-            timer->scheduleRepeated(task, IceUtil::Time::milliSeconds(20));
-            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
-            test(task->hasRun());
-            test(task->getCount() > 1);
-            test(task->getCount() < 26);
-            test(timer->cancel(task));
-            int count = task->getCount();
-            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
-            test(count == task->getCount() || count + 1 == task->getCount());
+            (*p)->waitForRun();
+            test((*p)->getRunTime() >= start + (*p)->getScheduledTime());
+        }
+        for(vector<TestTaskPtr>::const_iterator p = canceled.begin(); p != canceled.end(); ++p)
+        {
+            test(!(*p)->hasRun());
         }
 
+        //
+        // A task can be scheduled again once it ran or was canceled.
+        //
+        TestTaskPtr task = tasks.front();
+        task->clear();
+        timer->scheduleRepeated(task, IceUtil::Time::milliSeconds(10));
+        task->waitForRun();
+        test(timer->cancel(task));
+        test(!timer->cancel(task));
+        timer->schedule(task, IceUtil::Time());
         timer->destroy();
+
+        //
+        // A task can be scheduled with several timing wheel timers and each
+        // timer only cancels its own scheduling of the task. The task is no
+        // longer scheduled with the destroyed timer.
+        //
+        IceUtil::TimerPtr timer1 = new IceUtil::Timer(IceUtil::Time::milliSeconds(1));
+        IceUtil::TimerPtr timer2 = new IceUtil::Timer(IceUtil::Time::milliSeconds(1));
+        task->clear();
+        timer1->schedule(task, IceUtil::Time::seconds(10));
+        timer2->schedule(task, IceUtil::Time::milliSeconds(50));
+        try
+        {
+            timer2->schedule(task, IceUtil::Time::milliSeconds(50));
+            test(false);
+        }
+        catch(const IceUtil::IllegalArgumentException&)
+        {
+            // Expected, the task is already scheduled with this timer.
+        }
+        test(timer1->cancel(task));
+        test(!timer1->cancel(task));
+        task->waitForRun();
+        test(!timer2->cancel(task));
+        timer1->destroy();
+        timer2->destroy();
     }
     cout << "ok" << endl;
 
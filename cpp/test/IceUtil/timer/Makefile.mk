@@ -0,0 +1,10 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs = client benchmark
+
+$(test)_client_sources          = Client.cpp
+$(test)_benchmark_sources       = Benchmark.cpp
+
+tests += $(test)
@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Thu Jul  2 14:55:02 2020
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 11:49:04 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -62,7 +62,13 @@ public final class PropertyNames
         new Property("Ice\\.Admin\\.ThreadPool\\.Serialize", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("Ice\\.Admin\\.MessageSizeMax", false, null),
+        new Property("Ice\\.Admin\\.MaxDispatches", false, null),
+        new Property("Ice\\.Admin\\.Connection\\.MaxDispatches", false, null),
+        new Property("Ice\\.Admin\\.PriorityOperations", false, null),
         new Property("Ice\\.Admin\\.DelayCreation", false, null),
         new Property("Ice\\.Admin\\.Enabled", false, null),
         new Property("Ice\\.Admin\\.Facets", false, null),
@@ -80,6 +86,8 @@ public final class PropertyNames
         new Property("Ice\\.Compression\\.Level", false, null),
         new Property("Ice\\.CollectObjects", false, null),
         new Property("Ice\\.Config", false, null),
+        new Property("Ice\\.ConnectAttemptDelay", false, null),
+        new Property("Ice\\.ConnectionPoolSize", false, null),
         new Property("Ice\\.ConsoleListener", false, null),
         new Property("Ice\\.Default\\.CollocationOptimized", false, null),
         new Property("Ice\\.Default\\.EncodingVersion", false, null),
@@ -121,6 +129,11 @@ public final class PropertyNames
         new Property("Ice\\.InitPlugins", false, null),
         new Property("Ice\\.IPv4", false, null),
         new Property("Ice\\.IPv6", false, null),
+        new Property("Ice\\.LocatorCacheNegativeTimeout", false, null),
+        new Property("Ice\\.LocatorCacheRefreshThreshold", false, null),
+        new Property("Ice\\.LogAsync", false, null),
+        new Property("Ice\\.LogAsync\\.Overflow", false, null),
+        new Property("Ice\\.LogAsync\\.QueueSize", false, null),
         new Property("Ice\\.LogFile", false, null),
         new Property("Ice\\.LogFile\\.SizeMax", false, null),
         new Property("Ice\\.LogStdErr\\.Convert", false, null),
@@ -155,6 +168,9 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Client\\.Serialize", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadPriority", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.WorkStealing", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.ReservedThreads", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.NormalPriorityQueueSizeMax", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.Size", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeMax", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeWarn", false, null),
@@ -162,8 +178,13 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Server\\.Serialize", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadPriority", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.WorkStealing", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.ReservedThreads", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.NormalPriorityQueueSizeMax", false, null),
         new Property("Ice\\.ThreadPriority", false, null),
+        new Property("Ice\\.TimerWheelResolution", false, null),
         new Property("Ice\\.ToStringMode", false, null),
+        new Property("Ice\\.Trace\\.ACM", false, null),
         new Property("Ice\\.Trace\\.Admin\\.Properties", false, null),
         new Property("Ice\\.Trace\\.Admin\\.Logger", false, null),
         new Property("Ice\\.Trace\\.Locator", false, null),
@@ -196,11 +217,15 @@ public final class PropertyNames
 
     public static final Property IceMXProps[] =
     {
+        new Property("IceMX\\.Http\\.Host", false, null),
+        new Property("IceMX\\.Http\\.Port", false, null),
+        new Property("IceMX\\.Http\\.Timeout", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.GroupBy", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Map", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.RetainDetached", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Accept", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Reject", false, null),
+        new Property("IceMX\\.Metrics\\.[^\\s]+\\.Histogram", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+", false, null),
         null
     };
@@ -243,7 +268,13 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceDiscovery\\.Multicast\\.MessageSizeMax", false, null),
+        new Property("IceDiscovery\\.Multicast\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Multicast\\.PriorityOperations", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Timeout", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Heartbeat", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Close", false, null),
@@ -280,7 +311,13 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceDiscovery\\.Reply\\.MessageSizeMax", false, null),
+        new Property("IceDiscovery\\.Reply\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Reply\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Reply\\.PriorityOperations", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Heartbeat", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Close", false, null),
@@ -317,7 +354,13 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceDiscovery\\.Locator\\.MessageSizeMax", false, null),
+        new Property("IceDiscovery\\.Locator\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Locator\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceDiscovery\\.Locator\\.PriorityOperations", false, null),
         new Property("IceDiscovery\\.Lookup", false, null),
         new Property("IceDiscovery\\.Timeout", false, null),
         new Property("IceDiscovery\\.RetryCount", false, null),
@@ -367,7 +410,13 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.MessageSizeMax", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.MaxDispatches", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.PriorityOperations", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ACM\\.Heartbeat", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ACM\\.Close", false, null),
@@ -404,7 +453,13 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.MessageSizeMax", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.MaxDispatches", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.PriorityOperations", false, null),
         new Property("IceLocatorDiscovery\\.Lookup", false, null),
         new Property("IceLocatorDiscovery\\.Timeout", false, null),
         new Property("IceLocatorDiscovery\\.RetryCount", false, null),
@@ -492,7 +547,13 @@ public final class PropertyNames
         new Property("IceBridge\\.Source\\.ThreadPool\\.Serialize", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceBridge\\.Source\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceBridge\\.Source\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceBridge\\.Source\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceBridge\\.Source\\.MessageSizeMax", false, null),
+        new Property("IceBridge\\.Source\\.MaxDispatches", false, null),
+        new Property("IceBridge\\.Source\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceBridge\\.Source\\.PriorityOperations", false, null),
         new Property("IceBridge\\.Target\\.Endpoints", false, null),
         new Property("IceBridge\\.InstanceName", false, null),
         null
@@ -544,7 +605,13 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridAdmin\\.Server\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGridAdmin\\.Server\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGridAdmin\\.Server\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGridAdmin\\.Server\\.MessageSizeMax", false, null),
+        new Property("IceGridAdmin\\.Server\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Server\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Server\\.PriorityOperations", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Address", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Interface", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Lookup", false, null),
@@ -584,7 +651,13 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.MessageSizeMax", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.PriorityOperations", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ACM\\.Heartbeat", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ACM\\.Close", false, null),
@@ -621,7 +694,13 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.MessageSizeMax", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.PriorityOperations", false, null),
         new Property("IceGridAdmin\\.Trace\\.Observers", false, null),
         new Property("IceGridAdmin\\.Trace\\.SaveToRegistry", false, null),
         null
@@ -665,7 +744,13 @@ public final class PropertyNames
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.AdminRouter\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.AdminRouter\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.AdminRouter\\.PriorityOperations", false, null),
         new Property("IceGrid\\.InstanceName", false, null),
         new Property("IceGrid\\.Node\\.ACM\\.Timeout", false, null),
         new Property("IceGrid\\.Node\\.ACM\\.Heartbeat", false, null),
@@ -703,7 +788,13 @@ public final class PropertyNames
         new Property("IceGrid\\.Node\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.Node\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Node\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Node\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Node\\.PriorityOperations", false, null),
         new Property("IceGrid\\.Node\\.AllowRunningServersAsRoot", false, null),
         new Property("IceGrid\\.Node\\.AllowEndpointsOverride", false, null),
         new Property("IceGrid\\.Node\\.CollocateRegistry", false, null),
@@ -781,7 +872,13 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.PriorityOperations", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.EndpointSelection", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.ConnectionCached", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.PreferSecure", false, null),
@@ -828,7 +925,13 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.PriorityOperations", false, null),
         new Property("IceGrid\\.Registry\\.CryptPasswords", false, null),
         new Property("IceGrid\\.Registry\\.DefaultTemplates", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ACM\\.Timeout", false, null),
@@ -867,7 +970,13 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.PriorityOperations", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Enabled", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Address", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Port", false, null),
@@ -909,7 +1018,13 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.PriorityOperations", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.MapSize", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.Path", false, null),
         new Property("IceGrid\\.Registry\\.NodeSessionTimeout", false, null),
@@ -963,7 +1078,13 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.PriorityOperations", false, null),
         new Property("IceGrid\\.Registry\\.SessionFilters", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ACM\\.Timeout", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ACM\\.Heartbeat", false, null),
@@ -1001,7 +1122,13 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Connection\\.MaxDispatches", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.PriorityOperations", false, null),
         new Property("IceGrid\\.Registry\\.SessionTimeout", false, null),
         new Property("IceGrid\\.Registry\\.SSLPermissionsVerifier\\.EndpointSelection", false, null),
         new Property("IceGrid\\.Registry\\.SSLPermissionsVerifier\\.ConnectionCached", false, null),
@@ -1069,7 +1196,13 @@ public final class PropertyNames
         new Property("IcePatch2\\.ThreadPool\\.Serialize", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("IcePatch2\\.MessageSizeMax", false, null),
+        new Property("IcePatch2\\.MaxDispatches", false, null),
+        new Property("IcePatch2\\.Connection\\.MaxDispatches", false, null),
+        new Property("IcePatch2\\.PriorityOperations", false, null),
         new Property("IcePatch2\\.Directory", false, null),
         new Property("IcePatch2\\.InstanceName", false, null),
         null
@@ -1124,6 +1257,7 @@ public final class PropertyNames
         new Property("IceSSL\\.TrustOnly\\.Client", false, null),
         new Property("IceSSL\\.TrustOnly\\.Server", false, null),
         new Property("IceSSL\\.TrustOnly\\.Server\\.[^\\s]+", false, null),
+        new Property("IceSSL\\.TrustOnly\\.CacheSize", false, null),
         new Property("IceSSL\\.Truststore", false, null),
         new Property("IceSSL\\.TruststorePassword", false, null),
         new Property("IceSSL\\.TruststoreType", false, null),
@@ -1187,7 +1321,13 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.ThreadPool\\.Serialize", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("Glacier2\\.Client\\.MessageSizeMax", false, null),
+        new Property("Glacier2\\.Client\\.MaxDispatches", false, null),
+        new Property("Glacier2\\.Client\\.Connection\\.MaxDispatches", false, null),
+        new Property("Glacier2\\.Client\\.PriorityOperations", false, null),
         new Property("Glacier2\\.Client\\.AlwaysBatch", false, null),
         new Property("Glacier2\\.Client\\.Buffered", false, null),
         new Property("Glacier2\\.Client\\.ForwardContext", false, null),
@@ -1262,7 +1402,13 @@ public final class PropertyNames
         new Property("Glacier2\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.WorkStealing", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.ReservedThreads", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.NormalPriorityQueueSizeMax", false, null),
         new Property("Glacier2\\.Server\\.MessageSizeMax", false, null),
+        new Property("Glacier2\\.Server\\.MaxDispatches", false, null),
+        new Property("Glacier2\\.Server\\.Connection\\.MaxDispatches", false, null),
+        new Property("Glacier2\\.Server\\.PriorityOperations", false, null),
         new Property("Glacier2\\.Server\\.AlwaysBatch", false, null),
         new Property("Glacier2\\.Server\\.Buffered", false, null),
         new Property("Glacier2\\.Server\\.ForwardContext", false, null),
@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Thu Jul  2 14:55:02 2020
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 11:49:04 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -65,7 +65,13 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.ThreadPool\.Serialize/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadPriority/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.WorkStealing/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.ReservedThreads/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.NormalPriorityQueueSizeMax/", false, null),
     new Property("/^Ice\.Admin\.MessageSizeMax/", false, null),
+    new Property("/^Ice\.Admin\.MaxDispatches/", false, null),
+    new Property("/^Ice\.Admin\.Connection\.MaxDispatches/", false, null),
+    new Property("/^Ice\.Admin\.PriorityOperations/", false, null),
     new Property("/^Ice\.Admin\.DelayCreation/", false, null),
     new Property("/^Ice\.Admin\.Enabled/", false, null),
     new Property("/^Ice\.Admin\.Facets/", false, null),
@@ -83,6 +89,8 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Compression\.Level/", false, null),
     new Property("/^Ice\.CollectObjects/", false, null),
     new Property("/^Ice\.Config/", false, null),
+    new Property("/^Ice\.ConnectAttemptDelay/", false, null),
+    new Property("/^Ice\.ConnectionPoolSize/", false, null),
     new Property("/^Ice\.ConsoleListener/", false, null),
     new Property("/^Ice\.Default\.CollocationOptimized/", false, null),
     new Property("/^Ice\.Default\.EncodingVersion/", false, null),
@@ -124,6 +132,11 @@ PropertyNames.IceProps =
     new Property("/^Ice\.InitPlugins/", false, null),
     new Property("/^Ice\.IPv4/", false, null),
     new Property("/^Ice\.IPv6/", false, null),
+    new Property("/^Ice\.LocatorCacheNegativeTimeout/", false, null),
+    new Property("/^Ice\.LocatorCacheRefreshThreshold/", false, null),
+    new Property("/^Ice\.LogAsync/", false, null),
+    new Property("/^Ice\.LogAsync\.Overflow/", false, null),
+    new Property("/^Ice\.LogAsync\.QueueSize/", false, null),
     new Property("/^Ice\.LogFile/", false, null),
     new Property("/^Ice\.LogFile\.SizeMax/", false, null),
     new Property("/^Ice\.LogStdErr\.Convert/", false, null),
@@ -158,6 +171,9 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Client\.Serialize/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadPriority/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.WorkStealing/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.ReservedThreads/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.NormalPriorityQueueSizeMax/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Size/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeMax/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeWarn/", false, null),
@@ -165,8 +181,13 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Server\.Serialize/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadPriority/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.WorkStealing/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.ReservedThreads/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.NormalPriorityQueueSizeMax/", false, null),
     new Property("/^Ice\.ThreadPriority/", false, null),
+    new Property("/^Ice\.TimerWheelResolution/", false, null),
     new Property("/^Ice\.ToStringMode/", false, null),
+    new Property("/^Ice\.Trace\.ACM/", false, null),
     new Property("/^Ice\.Trace\.Admin\.Properties/", false, null),
     new Property("/^Ice\.Trace\.Admin\.Logger/", false, null),
     new Property("/^Ice\.Trace\.Locator/", false, null),
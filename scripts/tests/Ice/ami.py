@@ -11,6 +11,16 @@ traceProps = {
 }
 
 testcases = [ ClientServerTestCase(traceProps=traceProps) ]
+if isinstance(Mapping.getByPath(__name__), CppMapping):
+    # Multi-threaded thread pools with work stealing
+    workStealingProps = {
+        "Ice.ThreadPool.Client.Size" : 4,
+        "Ice.ThreadPool.Client.WorkStealing" : 1,
+        "Ice.ThreadPool.Server.Size" : 4,
+        "Ice.ThreadPool.Server.WorkStealing" : 1,
+    }
+    testcases += [ ClientServerTestCase("client/server with work stealing", props=workStealingProps,
+                                        traceProps=traceProps) ]
 if Mapping.getByPath(__name__).hasSource("Ice/ami", "collocated"):
     testcases += [ CollocatedTestCase() ]
 